@@ -7,12 +7,46 @@
 // C
 #include <stdio.h>
 #include <stdlib.h>
+//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+#include <string.h>
+#include <getopt.h>
+// END of change
 
 // KernelShark
 #include "libkshark.h"
 
 const char *default_file = "trace.dat";
 
+//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+static void usage(const char *prog)
+{
+	printf("Usage: %s [-f from] [-t to] [-e events] [trace file]\n", prog);
+	printf("  -f	load only the data after this time (in seconds)\n");
+	printf("  -t	load only the data before this time (in seconds)\n");
+	printf("  -e	load only these events or event systems, e.g. \"sched,irq/irq_handler_entry\"\n");
+}
+
+/* Split a comma-separated list of event names (modifies the list). */
+static int split_events(char *list, char ***names)
+{
+	char *name, *save = NULL, **tmp;
+	int n = 0;
+
+	*names = NULL;
+	for (name = strtok_r(list, ",", &save); name;
+	     name = strtok_r(NULL, ",", &save)) {
+		tmp = realloc(*names, (n + 1) * sizeof(**names));
+		if (!tmp)
+			return -1;
+
+		*names = tmp;
+		(*names)[n++] = name;
+	}
+
+	return n;
+}
+// END of change
+
 int main(int argc, char **argv)
 {
 	struct kshark_context *kshark_ctx;
@@ -20,6 +54,30 @@ int main(int argc, char **argv)
 	ssize_t r, n_rows, n_tasks;
 	char *entry_str;
 	int sd, *pids;
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	int64_t from = INT64_MIN, to = INT64_MAX;
+	char *events = NULL, **names;
+	int c, n_names;
+
+	while ((c = getopt(argc, argv, "hf:t:e:")) != -1) {
+		switch (c) {
+		case 'f':
+		case 't':
+			if (kshark_parse_seconds(optarg,
+						 (c == 'f') ? &from : &to) < 0) {
+				fprintf(stderr, "Invalid time: %s\n", optarg);
+				return 1;
+			}
+			break;
+		case 'e':
+			events = optarg;
+			break;
+		default:
+			usage(argv[0]);
+			return c == 'h' ? 0 : 1;
+		}
+	}
+	// END of change
 
 	/* Create a new kshark session. */
 	kshark_ctx = NULL;
@@ -27,8 +85,10 @@ int main(int argc, char **argv)
 		return 1;
 
 	/* Open a trace data file produced by trace-cmd. */
-	if (argc > 1)
-		sd = kshark_open(kshark_ctx, argv[1]);
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	if (optind < argc)
+		sd = kshark_open(kshark_ctx, argv[optind]);
+	// END of change
 	else
 		sd = kshark_open(kshark_ctx, default_file);
 
@@ -37,6 +97,22 @@ int main(int argc, char **argv)
 		return 1;
 	}
 
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	/* Load only the requested part of the data. */
+	if (kshark_set_load_time_range(kshark_ctx, sd, from, to) < 0)
+		fprintf(stderr, "Invalid time range.\n");
+
+	if (events) {
+		n_names = split_events(events, &names);
+		if (n_names > 0 &&
+		    kshark_set_load_event_names(kshark_ctx, sd,
+						names, n_names) < 0)
+			fprintf(stderr, "No matching events. Loading all.\n");
+
+		free(names);
+	}
+	// END of change
+
 	/* Load the content of the file into an array of entries. */
 	n_rows = kshark_load_entries(kshark_ctx, sd, &data);
 	if (n_rows < 1) {
@@ -57,7 +133,9 @@ int main(int argc, char **argv)
 	puts("\n\n");
 
 	/* Print to the screen the first 10 entries. */
-	for (r = 0; r < 10; ++r) {
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	for (r = 0; r < 10 && r < n_rows; ++r) {
+	// END of change
 		entry_str = kshark_dump_entry(data[r]);
 		puts(entry_str);
 		free(entry_str);
@@ -66,7 +144,9 @@ int main(int argc, char **argv)
 	puts("\n...\n");
 
 	/* Print the last 10 entries. */
-	for (r = n_rows - 10; r < n_rows; ++r)
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	for (r = (n_rows > 10) ? n_rows - 10 : 0; r < n_rows; ++r)
+	// END of change
 		kshark_print_entry(data[r]);
 
 	/* Free the memory. */
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: GPL-2.0
+
+//NOTE: Changed here. (WINDOWED LOAD) (2026-10-17)
+/* Copyright (C) 2026, David Jaromír Šebánek <djsebofficial@gmail.com> */
+
+/*
+ * Scroll through a trace data file in time windows, without loading the whole
+ * file into memory. The visualization model is filled with the entries of
+ * each window.
+ *
+ * Usage: dwindow [trace file] [number of windows] [memory budget in MiB]
+ */
+
+// C
+#include <stdio.h>
+#include <stdlib.h>
+
+// KernelShark
+#include "libkshark.h"
+#include "libkshark-tepdata.h"
+#include "libkshark-model.h"
+
+const char *default_file = "trace.dat";
+
+#define N_BINS 1024
+
+int main(int argc, char **argv)
+{
+	struct kshark_tep_window_stats stats;
+	struct kshark_trace_histo histo;
+	struct kshark_context *kshark_ctx;
+	struct kshark_tep_window *win;
+	struct kshark_entry **data;
+	int64_t first, last, step;
+	size_t max_bytes = 64;
+	int sd, i, bin, n_busy, n_windows = 100;
+	ssize_t n_rows;
+
+	if (argc > 2)
+		n_windows = atoi(argv[2]);
+
+	if (argc > 3)
+		max_bytes = strtoul(argv[3], NULL, 10);
+
+	if (n_windows < 1)
+		return 1;
+
+	/* Create a new kshark session. */
+	kshark_ctx = NULL;
+	if (!kshark_instance(&kshark_ctx))
+		return 1;
+
+	/* Open a trace data file produced by trace-cmd. */
+	sd = kshark_open(kshark_ctx, (argc > 1) ? argv[1] : default_file);
+	if (sd < 0) {
+		kshark_free(kshark_ctx);
+		return 1;
+	}
+
+	/* Index the file. No entries get loaded yet. */
+	win = kshark_tep_window_open(kshark_ctx, sd, max_bytes << 20);
+	if (!win || !kshark_tep_window_span(win, &first, &last)) {
+		kshark_tep_window_close(win);
+		kshark_free(kshark_ctx);
+		return 1;
+	}
+
+	ksmodel_init(&histo);
+
+	/* Scroll from the beginning to the end of the trace. */
+	step = (last - first) / n_windows + 1;
+	for (i = 0; i < n_windows; ++i) {
+		n_rows = kshark_tep_window_load(win, first + i * step,
+						first + (i + 1) * step, &data);
+		if (n_rows < 0)
+			break;
+
+		/*
+		 * The entries of the window stay valid until the next window
+		 * gets loaded.
+		 */
+		ksmodel_set_bining(&histo, N_BINS, first + i * step,
+				   first + (i + 1) * step);
+		ksmodel_fill(&histo, data, n_rows);
+
+		n_busy = 0;
+		for (bin = 0; bin < histo.n_bins; ++bin)
+			if (ksmodel_bin_count(&histo, bin))
+				++n_busy;
+
+		printf("window %i: %zi entries, %i non-empty bins\n",
+		       i, n_rows, n_busy);
+	}
+
+	ksmodel_clear(&histo);
+
+	kshark_tep_window_get_stats(win, &stats);
+	printf("\nblocks: %zu hits, %zu misses, %zu evicted\n",
+	       stats.n_hits, stats.n_misses, stats.n_evicted);
+	printf("memory: %zu bytes in %zu blocks\n",
+	       stats.n_bytes, stats.n_blocks);
+
+	kshark_tep_window_close(win);
+	kshark_free(kshark_ctx);
+
+	return 0;
+}
+// END of change
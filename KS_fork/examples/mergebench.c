@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: GPL-2.0
+
+//NOTE: Changed here. (HEAP MERGE) (2026-10-17)
+/* Copyright (C) 2026, David Jaromír Šebánek <djsebofficial@gmail.com> */
+
+/*
+ * Benchmark of the k-way merge of per-CPU (time-sorted) lists of entries,
+ * as done when loading trace data. The merge, based on kshark_merge_heap,
+ * is compared with a linear scan of all list heads per output entry.
+ *
+ * Usage: mergebench [total number of entries] [maximum number of CPUs]
+ */
+
+// C
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// KernelShark
+#include "libkshark.h"
+
+#define DEFAULT_N_ENTRIES	(1 << 23)
+#define DEFAULT_MAX_CPUS	256
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Distribute the entries between the CPUs and link them into lists. */
+static void make_lists(struct kshark_entry *entries, size_t n_entries,
+		       struct kshark_entry **lists, int n_cpus)
+{
+	struct kshark_entry **tail[n_cpus];
+	int64_t ts[n_cpus];
+	size_t i;
+	int cpu;
+
+	for (cpu = 0; cpu < n_cpus; ++cpu) {
+		lists[cpu] = NULL;
+		tail[cpu] = &lists[cpu];
+		ts[cpu] = 0;
+	}
+
+	for (i = 0; i < n_entries; ++i) {
+		cpu = rand() % n_cpus;
+		ts[cpu] += 1 + rand() % 1000;
+
+		entries[i].cpu = cpu;
+		entries[i].ts = ts[cpu];
+		entries[i].next = NULL;
+
+		*tail[cpu] = &entries[i];
+		tail[cpu] = &entries[i].next;
+	}
+}
+
+static int pick_linear(struct kshark_entry **lists, int n_cpus)
+{
+	int64_t ts = INT64_MAX;
+	int cpu, next = -1;
+
+	for (cpu = 0; cpu < n_cpus; ++cpu) {
+		if (lists[cpu] && lists[cpu]->ts < ts) {
+			ts = lists[cpu]->ts;
+			next = cpu;
+		}
+	}
+
+	return next;
+}
+
+static void merge_linear(struct kshark_entry **lists, int n_cpus,
+			 struct kshark_entry **out, size_t n_entries)
+{
+	size_t i;
+	int cpu;
+
+	for (i = 0; i < n_entries; ++i) {
+		cpu = pick_linear(lists, n_cpus);
+		out[i] = lists[cpu];
+		lists[cpu] = lists[cpu]->next;
+	}
+}
+
+static void merge_heap(struct kshark_entry **lists, int n_cpus,
+		       struct kshark_entry **out, size_t n_entries)
+{
+	struct kshark_merge_heap heap;
+	size_t i;
+	int cpu;
+
+	if (!kshark_merge_heap_init(&heap, n_cpus))
+		exit(1);
+
+	for (cpu = 0; cpu < n_cpus; ++cpu)
+		if (lists[cpu])
+			kshark_merge_heap_push(&heap, cpu, lists[cpu]->ts);
+
+	for (i = 0; i < n_entries; ++i) {
+		cpu = kshark_merge_heap_top(&heap);
+		out[i] = lists[cpu];
+		lists[cpu] = lists[cpu]->next;
+
+		if (lists[cpu])
+			kshark_merge_heap_replace_top(&heap, lists[cpu]->ts);
+		else
+			kshark_merge_heap_pop(&heap);
+	}
+
+	kshark_merge_heap_free(&heap);
+}
+
+static int check_sorted(struct kshark_entry **out, size_t n_entries)
+{
+	size_t i;
+
+	for (i = 1; i < n_entries; ++i)
+		if (out[i]->ts < out[i - 1]->ts)
+			return 0;
+
+	return 1;
+}
+
+int main(int argc, char **argv)
+{
+	size_t n_entries = DEFAULT_N_ENTRIES;
+	int max_cpus = DEFAULT_MAX_CPUS;
+	struct kshark_entry **lists, **out;
+	struct kshark_entry *entries;
+	double t0, t_linear, t_heap;
+	int n_cpus;
+
+	if (argc > 1)
+		n_entries = strtoul(argv[1], NULL, 10);
+
+	if (argc > 2)
+		max_cpus = atoi(argv[2]);
+
+	if (!n_entries || max_cpus < 1) {
+		fprintf(stderr,
+			"Usage: %s [number of entries] [maximum number of CPUs]\n",
+			argv[0]);
+		return 1;
+	}
+
+	entries = calloc(n_entries, sizeof(*entries));
+	out = calloc(n_entries, sizeof(*out));
+	lists = calloc(max_cpus, sizeof(*lists));
+	if (!entries || !out || !lists) {
+		fprintf(stderr, "Failed to allocate memory.\n");
+		return 1;
+	}
+
+	printf("%zu entries\n\n", n_entries);
+	printf("%6s %16s %16s %9s\n",
+	       "CPUs", "linear [M/s]", "heap [M/s]", "speedup");
+
+	for (n_cpus = 1; n_cpus <= max_cpus; n_cpus *= 2) {
+		srand(n_cpus);
+		make_lists(entries, n_entries, lists, n_cpus);
+		t0 = now();
+		merge_linear(lists, n_cpus, out, n_entries);
+		t_linear = now() - t0;
+
+		if (!check_sorted(out, n_entries))
+			fprintf(stderr, "linear merge: wrong order\n");
+
+		srand(n_cpus);
+		make_lists(entries, n_entries, lists, n_cpus);
+		t0 = now();
+		merge_heap(lists, n_cpus, out, n_entries);
+		t_heap = now() - t0;
+
+		if (!check_sorted(out, n_entries))
+			fprintf(stderr, "heap merge: wrong order\n");
+
+		printf("%6i %16.1f %16.1f %8.2fx\n", n_cpus,
+		       n_entries / t_linear * 1e-6,
+		       n_entries / t_heap * 1e-6,
+		       t_linear / t_heap);
+	}
+
+	free(entries);
+	free(lists);
+	free(out);
+
+	return 0;
+}
+// END of change
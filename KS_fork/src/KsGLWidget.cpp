@@ -16,6 +16,11 @@
 // OpenMP
 #include <omp.h>
 
+//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+// Qt
+#include <QOpenGLContext>
+// END of change
+
 // KernelShark
 #include "libkshark-plugin.h"
 #include "KsGLWidget.hpp"
@@ -51,10 +56,22 @@ KsGLWidget::KsGLWidget(QWidget *parent)
   _data(nullptr),
   _rubberBand(QRubberBand::Rectangle, this),
   _rubberBandOrigin(0, 0),
-  _dpr(1)
+  _dpr(1),
+  //NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+  _rendered(false),
+  _renderedModelVersion(0),
+  _renderedDataVersion(0),
+  // END of change
+  //NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+  _batchValid(false)
+  // END of change
 {
 	setMouseTracking(true);
 
+	//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+	ksplot_batch_init(&_batch);
+	// END of change
+
 	connect(&_model,	&QAbstractTableModel::modelReset,
 		this,		qOverload<>(&KsGLWidget::update));
 
@@ -72,6 +89,11 @@ void KsGLWidget::_freeGraphs()
 
 void KsGLWidget::freePluginShapes()
 {
+	//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+	/* The shapes have to be made again, before being drawn. */
+	_rendered = false;
+	// END of change
+
 	while (!_shapes.empty()) {
 		auto s = _shapes.front();
 		_shapes.pop_front();
@@ -83,6 +105,14 @@ KsGLWidget::~KsGLWidget()
 {
 	_freeGraphs();
 	freePluginShapes();
+
+	//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+	if (context())
+		disconnect(context(), &QOpenGLContext::aboutToBeDestroyed,
+			   this, &KsGLWidget::_freeBatch);
+
+	_freeBatch();
+	// END of change
 }
 
 /** Reimplemented function used to set up all required OpenGL resources. */
@@ -93,6 +123,20 @@ void KsGLWidget::initializeGL()
 
 	ksplot_init_font(&_font, 15, TT_FONT_FILE);
 
+	//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+	/*
+	 * This can be a new context (e.g. the widget has been reparented).
+	 * The vertex buffer and the font texture, used by the batch, belong
+	 * to the old context, so record the shapes again. The buffer is
+	 * deleted while the old context is still alive.
+	 */
+	ksplot_batch_free(&_batch);
+	_batchValid = false;
+
+	connect(context(), &QOpenGLContext::aboutToBeDestroyed,
+		this, &KsGLWidget::_freeBatch, Qt::UniqueConnection);
+	// END of change
+
 	_labelSize = _getMaxLabelSize() + FONT_WIDTH * 2;
 	updateGeom();
 }
@@ -137,25 +181,37 @@ void KsGLWidget::paintGL()
 	if (isEmpty())
 		return;
 
-	render();
+	//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+	/*
+	 * Make the graphs and the plugin shapes again only if the model, the
+	 * data (or its filtering) or the lists of plots have changed. Other
+	 * repaints (e.g. moving markers or exposing the window) just draw
+	 * them again.
+	 */
+	if (!_renderIsValid())
+		render();
+	// END of change
 
 	/* Draw the time axis. */
 	_drawAxisX(size);
 
-	for (auto it = _graphs.cbegin(), end = _graphs.cend(); it != end; ++it) {
-		for (auto const &g: it.value())
-			g->draw(size);
+	//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+	/*
+	 * Record the graphs and the plugin shapes only when they have been
+	 * made again. Otherwise draw the vertices, kept in the batch, with a
+	 * few OpenGL calls.
+	 */
+	if (!_batchValid) {
+		ksplot_batch_begin(&_batch);
+		_drawGraphsAndShapes(size);
+		_batchValid = ksplot_batch_end();
 	}
 
-	for (auto const &s: _shapes) {
-		if (!s)
-			continue;
-
-		if (s->_size < 0)
-			s->_size = size + abs(s->_size + 1);
-
-		s->draw();
-	}
+	if (_batchValid)
+		ksplot_batch_draw(&_batch);
+	else
+		_drawGraphsAndShapes(size);
+	// END of change
 
 	/*
 	 * Update and draw the markers. Make sure that the active marker
@@ -173,8 +229,100 @@ void KsGLWidget::render()
 	_makeGraphs();
 	/* Process and draw all plugin-specific shapes. */
 	_makePluginShapes();
+
+	//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+	_rendered = true;
+	_renderedModelVersion = _model.version();
+	_renderedDataVersion = _data ? _data->version() : 0;
+	_renderedPlots = _plotListKey();
+	// END of change
+
+	//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+	/* The graphs and the shapes have to be recorded again. */
+	_batchValid = false;
+	// END of change
 };
 
+//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+/* Draw (or record in the batch) all graphs and plugin shapes. */
+void KsGLWidget::_drawGraphsAndShapes(float size)
+{
+	for (auto it = _graphs.cbegin(), end = _graphs.cend(); it != end; ++it) {
+		for (auto const &g: it.value())
+			g->draw(size);
+	}
+
+	for (auto const &s: _shapes) {
+		if (!s)
+			continue;
+
+		if (s->_size < 0)
+			s->_size = size + abs(s->_size + 1);
+
+		s->draw();
+	}
+}
+
+/* Free the batch while the OpenGL context, owning its vertex buffer, exists. */
+void KsGLWidget::_freeBatch()
+{
+	makeCurrent();
+	ksplot_batch_free(&_batch);
+	doneCurrent();
+
+	_batchValid = false;
+}
+// END of change
+
+//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+/*
+ * Get a key, describing the lists of CPU, Task and Combo plots. The lists are
+ * public and are edited in many places, hence the graphs compare the key
+ * instead of counting the edits.
+ */
+QVector<int> KsGLWidget::_plotListKey() const
+{
+	QVector<int> key;
+
+	for (auto it = _streamPlots.cbegin(); it != _streamPlots.cend(); ++it) {
+		key << it.key() << it.value()._cpuList.count()
+		    << it.value()._cpuList
+		    << it.value()._taskList.count()
+		    << it.value()._taskList;
+	}
+
+	key << -1;
+	for (auto const &c: _comboPlots) {
+		key << c.count();
+		for (auto const &p: c)
+			key << p._streamId << p._type << p._id;
+	}
+
+	return key;
+}
+
+/**
+ * @brief Make the graphs and the plugin shapes again at the next repaint and
+ *	  request a repaint. Use this when something the plugins draw from,
+ *	  but not tracked by the model, the data or the lists of plots, has
+ *	  changed (e.g. the configuration of a plugin).
+ */
+void KsGLWidget::invalidateRender()
+{
+	_rendered = false;
+	update();
+}
+
+/* Check if the graphs and the plugin shapes are up to date. */
+bool KsGLWidget::_renderIsValid() const
+{
+	return _rendered &&
+	       _renderedModelVersion == _model.version() &&
+	       _renderedDataVersion == (_data ? _data->version() : 0) &&
+	       _renderedPlots == _plotListKey();
+}
+// END of change
+
 /** Reset (empty) the widget. */
 void KsGLWidget::reset()
 {
@@ -533,6 +681,11 @@ void KsGLWidget::loadData(KsDataStore *data, bool resetPlots)
  */
 void KsGLWidget::loadColors()
 {
+	//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+	/* The graphs have to be made again with the new colors. */
+	_rendered = false;
+	// END of change
+
 	_pidColors.clear();
 	_pidColors = KsPlot::taskColorTable();
 	_cpuColors.clear();
@@ -741,12 +894,35 @@ void KsGLWidget::_makeGraphs()
 		QVector<KsPlot::Graph *> cpuGraphs(nCpus);
 		QVector<KsPlot::Graph *> taskGraphs(nTasks);
 
+		//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+		/*
+		 * Find (or register) the Data collections of all graphs
+		 * before the parallel sections below, since registering a
+		 * collection is not thread-safe. Then compute the bins of all
+		 * CPU and Task graphs of the stream in a single sweep over the
+		 * data. If this fails, each graph computes its own bins.
+		 */
+		std::vector<ksmodel_graph_desc> descs =
+			_graphDescs(sd, it.value()._cpuList,
+				    it.value()._taskList);
+		std::vector<ksmodel_graph_bin> table;
+		size_t nBins = _model.histo()->n_bins;
+		bool haveTable = _fillGraphTable(sd, descs, &table);
+
+		auto lamBins = [&] (size_t graph) {
+			return haveTable ? table.data() + graph * nBins : nullptr;
+		};
+		// END of change
+
 		/* Create CPU graphs according to the cpuList. */
 		it.value()._cpuGraphs = {};
 		#pragma omp parallel for
 		for (size_t idx = 0; idx < nCpus; ++idx) {
 			int cpu = it.value()._cpuList[idx];
-			cpuGraphs[idx] = _newCPUGraph(sd, cpu);
+			//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+			cpuGraphs[idx] = _newCPUGraph(sd, cpu, descs[idx].col,
+						      lamBins(idx));
+			// END of change
 		}
 		QVectorIterator<KsPlot::Graph *> itCpuGraphs(cpuGraphs);
 		while (itCpuGraphs.hasNext()) {
@@ -759,7 +935,11 @@ void KsGLWidget::_makeGraphs()
 		#pragma omp parallel for
 		for (size_t idx = 0; idx < nTasks; ++idx) {
 			int pid = it.value()._taskList[idx];
-			taskGraphs[idx] = _newTaskGraph(sd, pid);
+			//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+			taskGraphs[idx] = _newTaskGraph(sd, pid,
+							descs[nCpus + idx].col,
+							lamBins(nCpus + idx));
+			// END of change
 		}
 		QVectorIterator<KsPlot::Graph *> itTaskGraphs(taskGraphs);
 		while (itTaskGraphs.hasNext()) {
@@ -770,13 +950,30 @@ void KsGLWidget::_makeGraphs()
 
 	for (auto &c: _comboPlots) {
 		int n = c.count();
+		//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+		/* Find (or register) the collections before going parallel. */
+		QVector<kshark_entry_collection *> cols(n, nullptr);
+		for (int i = 0; i < n; ++i) {
+			if (c[i]._type & KSHARK_TASK_DRAW)
+				cols[i] = _taskGraphCollection(c[i]._streamId,
+							       c[i]._id);
+			else if (c[i]._type & KSHARK_CPU_DRAW)
+				cols[i] = _cpuGraphCollection(c[i]._streamId,
+							      c[i]._id);
+		}
+		// END of change
+
 		#pragma omp parallel for
 		for (int i = 0; i < n; ++i) {
 			sd = c[i]._streamId;
+			//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
 			if (c[i]._type & KSHARK_TASK_DRAW) {
-				c[i]._graph = lamAddGraph(sd, _newTaskGraph(sd, c[i]._id));
+				c[i]._graph = lamAddGraph(sd, _newTaskGraph(sd, c[i]._id,
+									    cols[i]));
 			} else if (c[i]._type & KSHARK_CPU_DRAW) {
-				c[i]._graph = lamAddGraph(sd, _newCPUGraph(sd, c[i]._id));
+				c[i]._graph = lamAddGraph(sd, _newCPUGraph(sd, c[i]._id,
+									   cols[i]));
+			// END of change
 			} else {
 				c[i]._graph = nullptr;
 			}
@@ -856,12 +1053,15 @@ void KsGLWidget::_makePluginShapes()
 	}
 }
 
-KsPlot::Graph *KsGLWidget::_newCPUGraph(int sd, int cpu)
+//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+KsPlot::Graph *KsGLWidget::_newCPUGraph(int sd, int cpu,
+					kshark_entry_collection *col,
+					const ksmodel_graph_bin *bins)
+// END of change
 {
 	KsPlot::Graph *graph = nullptr;
 	kshark_context *kshark_ctx = nullptr;
 	kshark_data_stream *stream;
-	kshark_entry_collection *col;
 
 	if (!kshark_instance(&kshark_ctx))
 		return nullptr;
@@ -876,21 +1076,25 @@ KsPlot::Graph *KsGLWidget::_newCPUGraph(int sd, int cpu)
 	graph->setHeight(KS_GRAPH_HEIGHT);
 	graph->setLabelText(KsUtils::cpuPlotName(cpu).toStdString());
 
-	col = kshark_find_data_collection(kshark_ctx->collections,
-					  KsUtils::matchCPUVisible,
-					  sd, &cpu, 1);
-
+	//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
 	graph->setDataCollectionPtr(col);
-	graph->fillCPUGraph(sd, cpu);
+	if (bins)
+		graph->fillCPUGraph(sd, cpu, bins);
+	else
+		graph->fillCPUGraph(sd, cpu);
+	// END of change
 
 	return graph;
 }
 
-KsPlot::Graph *KsGLWidget::_newTaskGraph(int sd, int pid)
+//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+KsPlot::Graph *KsGLWidget::_newTaskGraph(int sd, int pid,
+					 kshark_entry_collection *col,
+					 const ksmodel_graph_bin *bins)
+// END of change
 {
 	KsPlot::Graph *graph = nullptr;
 	kshark_context *kshark_ctx = nullptr;
-	kshark_entry_collection *col;
 	kshark_data_stream *stream;
 
 	if (!kshark_instance(&kshark_ctx))
@@ -906,6 +1110,77 @@ KsPlot::Graph *KsGLWidget::_newTaskGraph(int sd, int pid)
 	graph->setHeight(KS_GRAPH_HEIGHT);
 	graph->setLabelText(KsUtils::taskPlotName(sd, pid).toStdString());
 
+	//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+	graph->setDataCollectionPtr(col);
+	if (bins)
+		graph->fillTaskGraph(sd, pid, bins);
+	else
+		graph->fillTaskGraph(sd, pid);
+	// END of change
+
+	return graph;
+}
+
+//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+/*
+ * Describe the CPU graphs and the Task graphs of a Data stream, finding (or
+ * registering) their Data collections. The CPU graphs come first, followed
+ * by the Task graphs.
+ */
+std::vector<ksmodel_graph_desc>
+KsGLWidget::_graphDescs(int sd, const QVector<int> &cpus,
+			const QVector<int> &pids)
+{
+	std::vector<ksmodel_graph_desc> graphs;
+
+	for (auto const &cpu: cpus)
+		graphs.push_back({cpu, false, _cpuGraphCollection(sd, cpu)});
+
+	for (auto const &pid: pids)
+		graphs.push_back({pid, true, _taskGraphCollection(sd, pid)});
+
+	return graphs;
+}
+
+/*
+ * Compute the bins of the CPU graphs and of the Task graphs of a Data stream
+ * in a single sweep over the data of the model. The table holds the bins of
+ * the graphs in the order of their descriptions.
+ */
+bool KsGLWidget::_fillGraphTable(int sd,
+				 const std::vector<ksmodel_graph_desc> &graphs,
+				 std::vector<ksmodel_graph_bin> *table)
+{
+	if (graphs.empty())
+		return false;
+
+	table->resize(graphs.size() * _model.histo()->n_bins);
+
+	return ksmodel_fill_graph_table(_model.histo(), sd,
+					graphs.data(), graphs.size(),
+					table->data());
+}
+
+kshark_entry_collection *KsGLWidget::_cpuGraphCollection(int sd, int cpu)
+{
+	kshark_context *kshark_ctx = nullptr;
+
+	if (!kshark_instance(&kshark_ctx))
+		return nullptr;
+
+	return kshark_find_data_collection(kshark_ctx->collections,
+					   KsUtils::matchCPUVisible,
+					   sd, &cpu, 1);
+}
+
+kshark_entry_collection *KsGLWidget::_taskGraphCollection(int sd, int pid)
+{
+	kshark_context *kshark_ctx = nullptr;
+	kshark_entry_collection *col;
+
+	if (!kshark_instance(&kshark_ctx))
+		return nullptr;
+
 	col = kshark_find_data_collection(kshark_ctx->collections,
 					  kshark_match_pid, sd, &pid, 1);
 
@@ -940,11 +1215,9 @@ KsPlot::Graph *KsGLWidget::_newTaskGraph(int sd, int pid)
 		kshark_reset_data_collection(col);
 	}
 
-	graph->setDataCollectionPtr(col);
-	graph->fillTaskGraph(sd, pid);
-
-	return graph;
+	return col;
 }
+// END of change
 
 /**
  * @brief Find the KernelShark entry under the the cursor.
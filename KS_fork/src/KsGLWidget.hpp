@@ -12,6 +12,11 @@
 #ifndef _KS_GLWIDGET_H
 #define _KS_GLWIDGET_H
 
+//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+// C++
+#include <vector>
+// END of change
+
 // Qt
 #include <QRubberBand>
 #include <QOpenGLWidget>
@@ -77,6 +82,10 @@ public:
 
 	void render();
 
+	//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+	void invalidateRender();
+	// END of change
+
 	void reset();
 
 	/** Reprocess all graphs. */
@@ -347,6 +356,36 @@ private:
 
 	ksplot_font	_font;
 
+	//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+	/** True if the graphs and the plugin shapes have been made. */
+	bool		_rendered;
+
+	/** Version of the model, used to make the graphs. */
+	uint64_t	_renderedModelVersion;
+
+	/** Version of the data, used to make the graphs. */
+	uint64_t	_renderedDataVersion;
+
+	/** Key of the lists of plots, used to make the graphs. */
+	QVector<int>	_renderedPlots;
+
+	QVector<int> _plotListKey() const;
+
+	bool _renderIsValid() const;
+	// END of change
+
+	//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+	/** Vertices of the graphs and the plugin shapes, drawn in batch. */
+	ksplot_batch	_batch;
+
+	/** True if the batch holds the current graphs and plugin shapes. */
+	bool		_batchValid;
+
+	void _drawGraphsAndShapes(float size);
+
+	void _freeBatch();
+	// END of change
+
 	void _freeGraphs();
 
 	void _drawAxisX(float size);
@@ -355,9 +394,27 @@ private:
 
 	void _makeGraphs();
 
-	KsPlot::Graph *_newCPUGraph(int sd, int cpu);
+	//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+	std::vector<ksmodel_graph_desc> _graphDescs(int sd,
+						    const QVector<int> &cpus,
+						    const QVector<int> &pids);
 
-	KsPlot::Graph *_newTaskGraph(int sd, int pid);
+	bool _fillGraphTable(int sd,
+			     const std::vector<ksmodel_graph_desc> &graphs,
+			     std::vector<ksmodel_graph_bin> *table);
+
+	kshark_entry_collection *_cpuGraphCollection(int sd, int cpu);
+
+	kshark_entry_collection *_taskGraphCollection(int sd, int pid);
+
+	KsPlot::Graph *_newCPUGraph(int sd, int cpu,
+				    kshark_entry_collection *col,
+				    const ksmodel_graph_bin *bins = nullptr);
+
+	KsPlot::Graph *_newTaskGraph(int sd, int pid,
+				     kshark_entry_collection *col,
+				     const ksmodel_graph_bin *bins = nullptr);
+	// END of change
 
 	void _makePluginShapes();
 
@@ -16,6 +16,10 @@
 
 // C++11
 #include <thread>
+//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+#include <map>
+#include <mutex>
+// END of change
 //NOTE: Changed here. (NUMA TV) (2025-06-17)
 #include <iostream>
 // END of change
@@ -1028,8 +1032,11 @@ void KsMainWindow::_advancedFiltering()
 	KsAdvFilteringDialog *dialog;
 
 	dialog = new KsAdvFilteringDialog(this);
+	//NOTE: Changed here. (ADV FILTER REFRESH) (2026-10-17)
+	/* Refilter the loaded entries, instead of reloading them. */
 	connect(dialog,		&KsAdvFilteringDialog::dataReload,
-		&_data,		&KsDataStore::reload);
+		&_data,		&KsDataStore::update);
+	// END of change
 
 	dialog->show();
 }
@@ -1180,6 +1187,12 @@ void KsMainWindow::_pluginUpdate(int sd, QVector<int> pluginStates)
 		return;
 
 	_plugins.updatePlugins(sd, pluginStates);
+
+	//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+	/* The shapes of the plugins, enabled or disabled, have to change. */
+	_graph.glPtr()->invalidateRender();
+	// END of change
+
 	streamIds = KsUtils::getStreamIdList(kshark_ctx);
 	if (streamIds.size() && streamIds.last() == sd) {
 		/* This is the last stream. Reload the data. */
@@ -1226,6 +1239,10 @@ void KsMainWindow::_pluginAdd()
 		if (_data.size())
 			_data.reload();
 
+		//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+		_graph.glPtr()->invalidateRender();
+		// END of change
+
 		_graph.endOfWork(KsDataWork::UpdatePlugins);
 	}
 }
@@ -1264,6 +1281,16 @@ void KsMainWindow::_offset()
 	};
 
 	connect(dialog, &KsTimeOffsetDialog::apply, lamApplyOffset);
+
+	//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+	auto lamPreviewOffset = [&] (int sd, double ms) {
+		_data.setClockOffset(sd, ms * 1000, true);
+		_graph.update(&_data);
+	};
+
+	connect(dialog, &KsTimeOffsetDialog::preview, lamPreviewOffset);
+	connect(dialog, &KsTimeOffsetDialog::restore, lamApplyOffset);
+	// END of change
 }
 
 void KsMainWindow::_setColorPhase(int f)
@@ -1314,6 +1341,102 @@ void KsMainWindow::_bugReport()
 	QDesktopServices::openUrl(bugs);
 }
 
+//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+/**
+ * The progress of the loading of all Data streams, reported by libkshark.
+ * The progress gets reported as long as the object exists.
+ */
+struct KsLoadProgress {
+	KsLoadProgress();
+
+	~KsLoadProgress();
+
+	void wait(KsProgressBar *pb, const bool &loadDone,
+		  int pbFirst, int pbLast);
+
+	/** Protects the progress of the streams. */
+	std::mutex				mutex;
+
+	/** The latest progress of each Data stream. */
+	std::map<int, kshark_load_progress>	streams;
+};
+
+static void loadProgressFunc(kshark_data_stream *stream,
+			     const kshark_load_progress *progress,
+			     void *data)
+{
+	KsLoadProgress *lp = static_cast<KsLoadProgress *>(data);
+	std::lock_guard<std::mutex> lock(lp->mutex);
+
+	lp->streams[stream->stream_id] = *progress;
+}
+
+KsLoadProgress::KsLoadProgress()
+{
+	kshark_context *kshark_ctx(nullptr);
+
+	if (kshark_instance(&kshark_ctx))
+		kshark_set_load_progress_func(kshark_ctx, loadProgressFunc,
+					      this);
+}
+
+KsLoadProgress::~KsLoadProgress()
+{
+	kshark_context *kshark_ctx(nullptr);
+
+	if (kshark_instance(&kshark_ctx))
+		kshark_set_load_progress_func(kshark_ctx, nullptr, nullptr);
+}
+
+/**
+ * Show the progress of the loading, done by another thread, until the
+ * loading is done. The value of the progress bar goes from "pbFirst" to
+ * "pbLast", according to the number of bytes processed. The time range of
+ * the data already loaded is shown as well.
+ */
+void KsLoadProgress::wait(KsProgressBar *pb, const bool &loadDone,
+			  int pbFirst, int pbLast)
+{
+	uint64_t bytesDone, bytesTotal;
+	QString status;
+
+	while (!__atomic_load_n(&loadDone, __ATOMIC_ACQUIRE)) {
+		usleep(100000);
+
+		bytesDone = bytesTotal = 0;
+		status.clear();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			for (auto const &[sd, p]: streams) {
+				bytesDone += p.bytes_done;
+				bytesTotal += p.bytes_total;
+
+				if (p.ts_loaded < p.ts_first)
+					continue;
+
+				if (!status.isEmpty())
+					status += "  ";
+
+				if (streams.size() > 1)
+					status += QString("#%1: ").arg(sd);
+
+				status += QString("%1 - %2 sec.").arg(
+					KsUtils::Ts2String(p.ts_first, 3),
+					KsUtils::Ts2String(p.ts_loaded, 3));
+			}
+		}
+
+		if (!status.isEmpty())
+			pb->setStatus("Loaded " + status);
+
+		if (bytesTotal)
+			pb->setValue(pbFirst + (pbLast - pbFirst) *
+					       bytesDone / bytesTotal);
+	}
+}
+// END of change
+
 void KsMainWindow::_load(const QString& fileName, bool append)
 {
 	QString pbLabel("Loading    ");
@@ -1358,14 +1481,21 @@ void KsMainWindow::_load(const QString& fileName, bool append)
 		}
 
 		sd = _data.loadDataFile(fileName, v);
-		loadDone = true;
+		//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+		__atomic_store_n(&loadDone, true, __ATOMIC_RELEASE);
+		// END of change
 	};
 
 	auto lamAppendJob = [&, this] () {
 		sd = _data.appendDataFile(fileName, shift);
-		loadDone = true;
+		//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+		__atomic_store_n(&loadDone, true, __ATOMIC_RELEASE);
+		// END of change
 	};
 
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	/* The progress gets reported while "progress" is in scope. */
+	KsLoadProgress progress;
 	std::thread job;
 	if (append) {
 		job = std::thread(lamAppendJob);
@@ -1373,19 +1503,10 @@ void KsMainWindow::_load(const QString& fileName, bool append)
 		job = std::thread(lamLoadJob);
 	}
 
-	for (int i = 0; i < 160; ++i) {
-		/*
-		 * TODO: The way this progress bar gets updated here is a pure
-		 * cheat. See if this can be implemented better.
-		*/
-		if (loadDone)
-			break;
-
-		pb.setValue(i);
-		usleep(150000);
-	}
+	progress.wait(&pb, loadDone, 0, 160);
 
 	job.join();
+	// END of change
 
 	if (sd < 0 || !_data.size()) {
 		QString text("File ");
@@ -1500,24 +1621,19 @@ void KsMainWindow::loadSession(const QString &fileName)
 
 	auto lamLoadJob = [&] () {
 		_session.loadDataStreams(kshark_ctx, &_data);
-		loadDone = true;
+		//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+		__atomic_store_n(&loadDone, true, __ATOMIC_RELEASE);
+		// END of change
 	};
 
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	KsLoadProgress progress;
 	std::thread job = std::thread(lamLoadJob);
 
-	for (int i = 0; i < 150; ++i) {
-		/*
-		 * TODO: The way this progress bar gets updated here is a pure
-		 * cheat. See if this can be implemented better.
-		*/
-		if (loadDone)
-			break;
-
-		pb.setValue(i);
-		usleep(300000);
-	}
+	progress.wait(&pb, loadDone, 20, 150);
 
 	job.join();
+	// END of change
 
 	_view.loadData(&_data);
 	pb.setValue(155);
@@ -57,6 +57,9 @@ public:
 	void registerPlugins(const QString &plugins)
 	{
 		_plugins.registerPlugins(plugins);
+		//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+		_graph.glPtr()->invalidateRender();
+		// END of change
 	}
 
 	/**
@@ -68,6 +71,9 @@ public:
 	void unregisterPlugins(const QString &pluginNames)
 	{
 		_plugins.unregisterPlugins(pluginNames);
+		//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+		_graph.glPtr()->invalidateRender();
+		// END of change
 	}
 
 	/**
@@ -79,6 +85,9 @@ public:
 	void registerPluginToStream(const QString &pluginName, QVector<int> streamIds)
 	{
 		_plugins.registerPluginToStream(pluginName, streamIds);
+		//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+		_graph.glPtr()->invalidateRender();
+		// END of change
 	}
 
 	/**
@@ -90,8 +99,36 @@ public:
 	void unregisterPluginFromStream(const QString &pluginName, QVector<int> streamIds)
 	{
 		_plugins.unregisterPluginFromStream(pluginName, streamIds);
+		//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+		_graph.glPtr()->invalidateRender();
+		// END of change
 	}
 
+	//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+	/**
+	 * @brief Store the loaded entries of the trace data files in sidecar
+	 *	  cache files, used when the files are opened again.
+	 *
+	 * @param on: Enable or disable the cache.
+	 */
+	void setEntryCache(bool on) {_data.setEntryCache(on);}
+	// END of change
+
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	/**
+	 * @brief Load only a part of the data of the trace data files.
+	 *
+	 * @param tMin: Lower edge of the loaded time range (in nanoseconds).
+	 * @param tMax: Upper edge of the loaded time range (in nanoseconds).
+	 * @param events: Names of the loaded events or event systems.
+	 */
+	void setLoadOptions(int64_t tMin, int64_t tMax,
+			    const QStringList &events)
+	{
+		_data.setLoadOptions(tMin, tMax, events);
+	}
+	// END of change
+
 	void setCPUPlots(int sd, QVector<int> cpus);
 
 	void setTaskPlots(int sd, QVector<int> pids);
@@ -498,9 +498,17 @@ Qt::ItemFlags KsViewModel::flags(const QModelIndex &index) const {
 
 /** Create a default (empty) KsFilterProxyModel object. */
 KsGraphModel::KsGraphModel(QObject *parent)
-: QAbstractTableModel(parent)
+: QAbstractTableModel(parent),
+  //NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+  _version(0)
+  // END of change
 {
 	ksmodel_init(&_histo);
+
+	//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+	connect(this,	&QAbstractTableModel::modelReset,
+		this,	[this] () {++_version;});
+	// END of change
 }
 
 /** Destroy KsFilterProxyModel object. */
@@ -529,7 +537,12 @@ void KsGraphModel::fill(KsDataStore *data)
 				   entries[0]->ts,
 				   entries[n - 1]->ts);
 
-	ksmodel_fill(&_histo, entries, n);
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	if (data->columns()->size == n)
+		ksmodel_fill_columns(&_histo, entries, data->columns());
+	else
+		ksmodel_fill(&_histo, entries, n);
+	// END of change
 
 	endResetModel();
 }
@@ -611,7 +624,10 @@ void KsGraphModel::quickZoomOut()
 			   _histo.data[0]->ts,
 			   _histo.data[_histo.data_size - 1]->ts);
 
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	/* Same data, hence the columns of the model (if any) are kept. */
 	ksmodel_fill(&_histo, _histo.data, _histo.data_size);
+	// END of change
 
 	endResetModel();
 }
@@ -644,7 +660,11 @@ void KsGraphModel::reset()
 void KsGraphModel::update(KsDataStore *data)
 {
 	beginResetModel();
-	if (data)
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	if (data && data->columns()->size == (size_t) data->size())
+		ksmodel_fill_columns(&_histo, data->rows(), data->columns());
+	else if (data)
 		ksmodel_fill(&_histo, data->rows(), data->size());
+	// END of change
 	endResetModel();
 }
@@ -308,8 +308,20 @@ public:
 
 	void update(KsDataStore *data = nullptr);
 
+	//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+	/**
+	 * Get the version of the model. It changes every time the model is
+	 * reset (recalculated).
+	 */
+	uint64_t version() const {return _version;}
+	// END of change
+
 private:
 	kshark_trace_histo	_histo;
+
+	//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+	uint64_t		_version;
+	// END of change
 };
 
 /** Defines a default number of bins to be used by the visualization model. */
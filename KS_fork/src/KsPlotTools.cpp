@@ -1068,58 +1068,40 @@ void Graph::setBin(int bin, int pidF, int pidB, const Color &col, uint8_t m)
  */
 void Graph::fillCPUGraph(int sd, int cpu)
 {
-	struct kshark_entry *eFront;
+	//NOTE: Changed here. (BIN BATCH) (2026-10-17)
+	/* Process all bins of the graph in a single sweep over the data. */
+	std::vector<ksmodel_graph_bin> bins(_histoPtr->n_bins);
+	ksmodel_fill_cpu_graph_bins(_histoPtr, sd, cpu, _collectionPtr,
+				    bins.data());
+	// END of change
+
+	//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+	fillCPUGraph(sd, cpu, bins.data());
+	// END of change
+}
+
+//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+/**
+ * @brief Process a CPU Graph, using the content of its bins, computed
+ *	  already by the visualization model.
+ *
+ * @param sd: Data stream identifier.
+ * @param cpu: The CPU core.
+ * @param bins: Input location for the content of all bins of the Graph
+ *		(see ksmodel_fill_graph_table()).
+ */
+void Graph::fillCPUGraph(int sd, int cpu, const ksmodel_graph_bin *bins)
+{
 	int pidFront(0), pidBack(0);
 	int pidBackNoFilter;
 	uint8_t visMask;
-	ssize_t index;
 	int bin;
 
 	auto lamGetPid = [&] (int bin)
 	{
-		eFront = nullptr;
-
-		pidFront = ksmodel_get_pid_front(_histoPtr, bin,
-							    sd,
-							    cpu,
-							    true,
-							    _collectionPtr,
-							    &index);
-
-		if (index >= 0)
-			eFront = _histoPtr->data[index];
-
-		pidBack = ksmodel_get_pid_back(_histoPtr, bin,
-							  sd,
-							  cpu,
-							  true,
-							  _collectionPtr,
-							  nullptr);
-
-		pidBackNoFilter =
-			ksmodel_get_pid_back(_histoPtr, bin,
-							sd,
-							cpu,
-							false,
-							_collectionPtr,
-							nullptr);
-
-		if (pidBack != pidBackNoFilter)
-			pidBack = KS_FILTERED_BIN;
-
-		visMask = 0x0;
-		if (eFront) {
-			if (!(eFront->visible & KS_EVENT_VIEW_FILTER_MASK) &&
-			    ksmodel_cpu_visible_event_exist(_histoPtr, bin,
-								       sd,
-								       cpu,
-								       _collectionPtr,
-								       &index)) {
-				visMask = _histoPtr->data[index]->visible;
-			} else {
-				visMask = eFront->visible;
-			}
-		}
+		pidFront = bins[bin].id_front;
+		pidBack = bins[bin].id_back;
+		visMask = bins[bin].vis_mask;
 	};
 
 	auto lamSetBin = [&] (int bin)
@@ -1194,6 +1176,7 @@ void Graph::fillCPUGraph(int sd, int cpu)
 		lamSetBin(bin);
 	}
 }
+// END of change
 
 /**
  * @brief Process a Task Graph.
@@ -1202,11 +1185,33 @@ void Graph::fillCPUGraph(int sd, int cpu)
  * @param pid: The Process Id of the Task.
  */
 void Graph::fillTaskGraph(int sd, int pid)
+{
+	//NOTE: Changed here. (BIN BATCH) (2026-10-17)
+	/* Process all bins of the graph in a single sweep over the data. */
+	std::vector<ksmodel_graph_bin> bins(_histoPtr->n_bins);
+	ksmodel_fill_task_graph_bins(_histoPtr, sd, pid, _collectionPtr,
+				     bins.data());
+	// END of change
+
+	//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+	fillTaskGraph(sd, pid, bins.data());
+	// END of change
+}
+
+//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+/**
+ * @brief Process a Task Graph, using the content of its bins, computed
+ *	  already by the visualization model.
+ *
+ * @param sd: Data stream identifier.
+ * @param pid: The Process Id of the Task.
+ * @param bins: Input location for the content of all bins of the Graph
+ *		(see ksmodel_fill_graph_table()).
+ */
+void Graph::fillTaskGraph(int sd, int pid, const ksmodel_graph_bin *bins)
 {
 	int cpuFront, cpuBack(0), pidFront(0), pidBack(0), lastCpu(-1), bin(0);
-	struct kshark_entry *eFront;
 	uint8_t visMask;
-	ssize_t index;
 
 	auto lamSetBin = [&] (int bin)
 	{
@@ -1279,62 +1284,11 @@ void Graph::fillTaskGraph(int sd, int pid)
 
 	auto lamGetPidCPU = [&] (int bin)
 	{
-		eFront = nullptr;
-		/* Get the CPU used by this task. */
-		cpuFront = ksmodel_get_cpu_front(_histoPtr, bin,
-						 sd,
-						 pid,
-						 false,
-						 _collectionPtr,
-						 &index);
-		if (cpuFront >= 0 && index >= 0)
-			eFront = _histoPtr->data[index];
-
-		cpuBack = ksmodel_get_cpu_back(_histoPtr, bin,
-					       sd,
-					       pid,
-					       false,
-					       _collectionPtr,
-					       nullptr);
-
-		if (cpuFront < 0) {
-			pidFront = pidBack = cpuFront;
-		} else {
-			/*
-			 * Get the process Id at the begining and at the end
-			 * of the bin.
-			 */
-			pidFront = ksmodel_get_pid_front(_histoPtr,
-							 bin,
-							 sd,
-							 cpuFront,
-							 false,
-							 _collectionPtr,
-							 nullptr);
-
-			pidBack = ksmodel_get_pid_back(_histoPtr,
-						       bin,
-						       sd,
-						       cpuBack,
-						       false,
-						       _collectionPtr,
-						       nullptr);
-
-			visMask = 0x0;
-			if (eFront) {
-				if (!(eFront->visible & KS_EVENT_VIEW_FILTER_MASK) &&
-				    ksmodel_task_visible_event_exist(_histoPtr,
-								     bin,
-								     sd,
-								     pid,
-								     _collectionPtr,
-								     &index)) {
-					visMask = _histoPtr->data[index]->visible;
-				} else {
-					visMask = eFront->visible;
-				}
-			}
-		}
+		cpuFront = bins[bin].id_front;
+		cpuBack = bins[bin].id_back;
+		pidFront = bins[bin].pid_front;
+		pidBack = bins[bin].pid_back;
+		visMask = bins[bin].vis_mask;
 	};
 
 	/*
@@ -1404,6 +1358,7 @@ void Graph::fillTaskGraph(int sd, int pid)
 		lamSetBin(bin);
 	}
 }
+// END of change
 
 /**
  * @brief Draw the Graph
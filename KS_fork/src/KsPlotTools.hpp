@@ -556,6 +556,12 @@ public:
 
 	void fillTaskGraph(int sd, int pid);
 
+	//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+	void fillCPUGraph(int sd, int cpu, const ksmodel_graph_bin *bins);
+
+	void fillTaskGraph(int sd, int pid, const ksmodel_graph_bin *bins);
+	// END of change
+
 	void draw(float s = 1);
 
 	void setBase(int b);
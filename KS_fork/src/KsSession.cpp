@@ -138,6 +138,9 @@ void KsSession::loadDataStreams(kshark_context *kshark_ctx,
 	}
 
 	data->setSize(dataSize);
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	data->updateColumns();
+	// END of change
 	data->registerCPUCollections();
 }
 
@@ -694,12 +694,40 @@ QColor& operator <<(QColor &thisColor, const KsPlot::Color &c)
 KsDataStore::KsDataStore(QWidget *parent)
 : QObject(parent),
   _rows(nullptr),
-  _dataSize(0)
-{}
+  _dataSize(0),
+  //NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+  _columns(),
+  // END of change
+  //NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+  _postings(),
+  // END of change
+  //NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+  _entryCache(false),
+  // END of change
+  //NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+  _loadTimeMin(INT64_MIN),
+  _loadTimeMax(INT64_MAX),
+  // END of change
+  //NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+  _version(0)
+  // END of change
+{
+	//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+	connect(this,	&KsDataStore::updateWidgets,
+		this,	[this] () {++_version;});
+	// END of change
+}
 
 /** Destroy the KsDataStore object. */
 KsDataStore::~KsDataStore()
-{}
+{
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	kshark_entry_columns_free(&_columns);
+	// END of change
+	//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+	kshark_postings_free(&_postings);
+	// END of change
+}
 
 int KsDataStore::_openDataFile(kshark_context *kshark_ctx,
 				const QString &file)
@@ -715,9 +743,75 @@ int KsDataStore::_openDataFile(kshark_context *kshark_ctx,
 		kshark_tep_handle_plugins(kshark_ctx, sd);
 	}
 
+	//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+	/* Decode the CPU buffers of the streams in parallel. */
+	int *streamIds = kshark_all_streams(kshark_ctx);
+	for (int i = 0; i < kshark_ctx->n_streams; ++i) {
+		kshark_set_load_threads(kshark_ctx, streamIds[i],
+					KS_LOAD_THREADS_AUTO);
+
+		//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+		/* Not supported by all data formats. Ignore failures. */
+		kshark_set_entry_arena(kshark_ctx, streamIds[i], true);
+		// END of change
+
+		//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+		if (_entryCache)
+			kshark_set_entry_cache(kshark_ctx, streamIds[i], true);
+		// END of change
+
+		//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+		_applyLoadOptions(kshark_ctx, streamIds[i]);
+		// END of change
+	}
+	free(streamIds);
+	// END of change
+
 	return sd;
 }
 
+//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+/**
+ * @brief Load only a part of the data of the trace data files opened from
+ *	  now on.
+ *
+ * @param tMin: Lower edge of the loaded time range (in nanoseconds).
+ * @param tMax: Upper edge of the loaded time range (in nanoseconds).
+ * @param events: Names of the loaded events ("system/event") or event
+ *		  systems ("system"). If empty, all events are loaded.
+ */
+void KsDataStore::setLoadOptions(int64_t tMin, int64_t tMax,
+				 const QStringList &events)
+{
+	_loadTimeMin = tMin;
+	_loadTimeMax = tMax;
+	_loadEvents = events;
+}
+
+void KsDataStore::_applyLoadOptions(kshark_context *kshark_ctx, int sd)
+{
+	std::vector<std::string> names;
+	std::vector<char *> cNames;
+	int ret;
+
+	if (!kshark_is_tep(kshark_ctx->stream[sd]))
+		return;
+
+	kshark_set_load_time_range(kshark_ctx, sd, _loadTimeMin, _loadTimeMax);
+
+	for (auto const &e: _loadEvents)
+		names.push_back(e.toStdString());
+
+	for (auto &n: names)
+		cNames.push_back(n.data());
+
+	ret = kshark_set_load_event_names(kshark_ctx, sd, cNames.data(),
+					  cNames.size());
+	if (ret == -ENOENT)
+		qWarning() << "No events matching" << _loadEvents.join(",");
+}
+// END of change
+
 void KsDataStore::_addPluginsToStream(kshark_context *kshark_ctx, int sd,
 				      QVector<kshark_dpi *> plugins)
 {
@@ -765,6 +859,9 @@ int KsDataStore::loadDataFile(const QString &file,
 		return _dataSize;
 	}
 
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	updateColumns();
+	// END of change
 	registerCPUCollections();
 
 	return sd;
@@ -818,6 +915,9 @@ int KsDataStore::appendDataFile(const QString &file, int64_t offset)
 
 	_rows = mergedRows;
 
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	updateColumns();
+	// END of change
 	registerCPUCollections();
 	emit updateWidgets(this);
 
@@ -826,16 +926,58 @@ int KsDataStore::appendDataFile(const QString &file, int64_t offset)
 
 void KsDataStore::_freeData()
 {
-	if (_dataSize > 0) {
-		for (ssize_t r = 0; r < _dataSize; ++r)
-			free(_rows[r]);
+	//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+	kshark_context *kshark_ctx(nullptr);
 
-		free(_rows);
+	if (_dataSize > 0 && kshark_instance(&kshark_ctx)) {
+		/* The entries owned by a stream arena are not freed here. */
+		kshark_free_entries(kshark_ctx, _rows, _dataSize);
 	}
+	// END of change
 
 	_rows = nullptr;
 	_dataSize = 0;
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	kshark_entry_columns_free(&_columns);
+	// END of change
+	//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+	kshark_postings_free(&_postings);
+	// END of change
+}
+
+//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+/**
+ * @brief Update the columnar copy and the posting lists of the trace data
+ *	  array. Call this function every time the entries are reloaded,
+ *	  merged or reordered. Filtering does not require an update.
+ */
+void KsDataStore::updateColumns()
+{
+	if (_dataSize <= 0 ||
+	    !kshark_entry_columns_fill(&_columns, _rows, _dataSize))
+		kshark_entry_columns_free(&_columns);
+
+	//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+	_buildPostings();
+	// END of change
+}
+// END of change
+
+//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+/*
+ * Build the posting lists of the trace data array. The entries must be
+ * filtered by the current filters.
+ */
+void KsDataStore::_buildPostings()
+{
+	kshark_context *kshark_ctx(nullptr);
+
+	if (_dataSize <= 0 || !kshark_instance(&kshark_ctx) ||
+	    kshark_postings_build(kshark_ctx, &_postings,
+				  _rows, _dataSize) < 0)
+		kshark_postings_free(&_postings);
 }
+// END of change
 
 /** Reload the trace data. */
 void KsDataStore::reload()
@@ -854,6 +996,9 @@ void KsDataStore::reload()
 
 	_dataSize = kshark_load_all_entries(kshark_ctx, &_rows);
 
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	updateColumns();
+	// END of change
 	registerCPUCollections();
 
 	emit updateWidgets(this);
@@ -882,7 +1027,13 @@ void KsDataStore::update()
 
 	unregisterCPUCollections();
 
-	kshark_filter_all_entries(kshark_ctx, _rows, _dataSize);
+	//NOTE: Changed here. (PARALLEL FILTER) (2026-10-17)
+	kshark_filter_column_entries(kshark_ctx, -1, _rows, &_columns,
+				     _dataSize);
+	// END of change
+	//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+	kshark_postings_sync(kshark_ctx, -1, &_postings);
+	// END of change
 
 	registerCPUCollections();
 
@@ -902,14 +1053,17 @@ void KsDataStore::registerCPUCollections()
 	for (int i = 0; i < kshark_ctx->n_streams; ++i) {
 		sd = streamIds[i];
 
+		//NOTE: Changed here. (CPU COLLECTIONS) (2026-10-17)
+		/* All CPUs of the stream are processed in a single sweep. */
 		nCPUs = kshark_ctx->stream[sd]->n_cpus;
-		for (int cpu = 0; cpu < nCPUs; ++cpu) {
-			kshark_register_data_collection(kshark_ctx,
-							_rows, _dataSize,
-							KsUtils::matchCPUVisible,
-							sd, &cpu, 1,
-							0);
-		}
+		QVector<int> cpus(nCPUs);
+		for (int cpu = 0; cpu < nCPUs; ++cpu)
+			cpus[cpu] = cpu;
+
+		kshark_register_cpu_collections(kshark_ctx, _rows, _dataSize,
+						KsUtils::matchCPUVisible,
+						sd, cpus.constData(), nCPUs);
+		// END of change
 	}
 
 	free(streamIds);
@@ -977,22 +1131,87 @@ void KsDataStore::_applyIdFilter(int filterId, QVector<int> vec, int sd)
 	if (!kshark_ctx->n_streams)
 		return;
 
+	//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+	/*
+	 * If possible, refilter only the entries with the Ids added to or
+	 * removed from the filters, and rebuild only the collections of the
+	 * CPUs, where these entries changed their visibility.
+	 */
+	kshark_hash_id *cpus = kshark_hash_id_alloc(KS_FILTER_HASH_NBITS);
+
+	if (cpus && kshark_postings_filter(kshark_ctx, sd, &_postings,
+					   cpus) == 0) {
+		_updateCPUCollections(sd, cpus);
+		kshark_hash_id_free(cpus);
+		emit updateWidgets(this);
+		return;
+	}
+
+	kshark_hash_id_free(cpus);
+	// END of change
+
 	unregisterCPUCollections();
 
+	//NOTE: Changed here. (ADV FILTER REFRESH) (2026-10-17)
 	/*
-	 * If the advanced event filter is set the data has to be reloaded,
-	 * because the advanced filter uses tep_records.
+	 * The advanced event filter (if set) is applied as well, by reading
+	 * only the records it needs. No reload of the data is needed.
 	 */
-	if (kshark_is_tep(stream) && kshark_tep_filter_is_set(stream))
-		reload();
+	kshark_filter_column_entries(kshark_ctx, sd, _rows, &_columns,
+				     _dataSize);
+	// END of change
+	//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+	/* The posting lists, freed by a preview of a clock offset, are rebuilt. */
+	if (_postings.data)
+		kshark_postings_sync(kshark_ctx, sd, &_postings);
 	else
-		kshark_filter_stream_entries(kshark_ctx, sd, _rows, _dataSize);
+		_buildPostings();
+	// END of change
 
 	registerCPUCollections();
 
 	emit updateWidgets(this);
 }
 
+//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+/** Rebuild the collections of a given set of CPUs of a Data stream. */
+void KsDataStore::_updateCPUCollections(int sd, kshark_hash_id *cpus)
+{
+	kshark_context *kshark_ctx(nullptr);
+	int *cpuIds;
+
+	if (!kshark_instance(&kshark_ctx) || !cpus->count)
+		return;
+
+	cpuIds = kshark_hash_ids(cpus);
+	if (!cpuIds)
+		return;
+
+	/*
+	 * Only the entries of the CPU, found in its posting list, are visited
+	 * when the collection gets rebuilt.
+	 */
+	for (size_t i = 0; i < cpus->count; ++i) {
+		const uint32_t *cpuRows;
+		size_t n;
+
+		kshark_unregister_data_collection(&kshark_ctx->collections,
+						  KsUtils::matchCPUVisible,
+						  sd, &cpuIds[i], 1);
+
+		cpuRows = kshark_posting_list(&_postings, KS_POSTING_CPU,
+					      sd, cpuIds[i], &n);
+		kshark_register_indexed_collection(kshark_ctx,
+						   _rows, _dataSize,
+						   cpuRows, n,
+						   KsUtils::matchCPUVisible,
+						   sd, &cpuIds[i], 1);
+	}
+
+	free(cpuIds);
+}
+// END of change
+
 /** Apply Show Task filter. */
 void KsDataStore::applyPosTaskFilter(int sd, QVector<int> vec)
 {
@@ -1058,6 +1277,9 @@ void KsDataStore::clearAllFilters()
 	free(streamIds);
 
 	kshark_clear_all_filters(kshark_ctx, _rows, _dataSize);
+	//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+	kshark_postings_sync(kshark_ctx, -1, &_postings);
+	// END of change
 	registerCPUCollections();
 
 	emit updateWidgets(this);
@@ -1069,8 +1291,11 @@ void KsDataStore::clearAllFilters()
  *
  * @param sd: Data stream identifier.
  * @param offset: The constant offset to be added (in nanosecond).
+ * @param preview: If true, the offset is only being previewed. The CPU
+ *		   collections and the posting lists are rebuilt once the final
+ *		   offset is set (preview = false).
  */
-void KsDataStore::setClockOffset(int sd, int64_t offset)
+void KsDataStore::setClockOffset(int sd, int64_t offset, bool preview)
 {
 	kshark_context *kshark_ctx(nullptr);
 
@@ -1082,7 +1307,26 @@ void KsDataStore::setClockOffset(int sd, int64_t offset)
 
 	unregisterCPUCollections();
 	kshark_set_clock_offset(kshark_ctx, _rows, _dataSize, sd, offset);
-	registerCPUCollections();
+	//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+	/*
+	 * The posting lists are not rebuilt for each previewed offset. They
+	 * are freed, and rebuilt once the final offset is set or by the next
+	 * filtering.
+	 */
+	if (preview) {
+		if (_dataSize <= 0 ||
+		    !kshark_entry_columns_fill(&_columns, _rows, _dataSize))
+			kshark_entry_columns_free(&_columns);
+
+		kshark_postings_free(&_postings);
+	} else {
+		updateColumns();
+	}
+	// END of change
+	//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+	if (!preview)
+		registerCPUCollections();
+	// END of change
 }
 
 /**
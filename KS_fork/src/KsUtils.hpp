@@ -21,6 +21,9 @@
 // KernelShark
 #include "libkshark.h"
 #include "libkshark-model.h"
+//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+#include "libkshark-postings.h"
+// END of change
 #include "KsCmakeDef.hpp"
 #include "KsPlotTools.hpp"
 
@@ -219,6 +222,13 @@ public:
 	/** Set the size of the data (number of entries). */
 	void setSize(ssize_t s) {_dataSize = s;}
 
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	/** Get the columnar copy of the trace data array. */
+	const kshark_entry_columns *columns() const {return &_columns;}
+
+	void updateColumns();
+	// END of change
+
 	void reload();
 
 	void update();
@@ -241,7 +251,27 @@ public:
 
 	void clearAllFilters();
 
-	void setClockOffset(int sd, int64_t offset);
+	//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+	/** Enable or disable the sidecar entry cache of the opened files. */
+	void setEntryCache(bool on) {_entryCache = on;}
+	// END of change
+
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	void setLoadOptions(int64_t tMin, int64_t tMax,
+			    const QStringList &events);
+	// END of change
+
+	//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+	void setClockOffset(int sd, int64_t offset, bool preview = false);
+	// END of change
+
+	//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+	/**
+	 * Get the version of the data. It changes every time the View
+	 * widgets are asked to update (data or filters have changed).
+	 */
+	uint64_t version() const {return _version;}
+	// END of change
 
 signals:
 	/**
@@ -257,12 +287,53 @@ private:
 	/** The size of the data array. */
 	ssize_t			_dataSize;
 
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	/** Columnar copy of the trace data array. */
+	kshark_entry_columns	_columns;
+	// END of change
+
+	//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+	/** Posting lists of the trace data array, used to refilter it. */
+	kshark_entry_postings	_postings;
+	// END of change
+
+	//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+	/** Use sidecar cache files for the entries of the opened files. */
+	bool			_entryCache;
+	// END of change
+
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	/** Lower edge of the time range loaded from the opened files. */
+	int64_t			_loadTimeMin;
+
+	/** Upper edge of the time range loaded from the opened files. */
+	int64_t			_loadTimeMax;
+
+	/** Events (or event systems) loaded from the opened files. */
+	QStringList		_loadEvents;
+	// END of change
+
+	//NOTE: Changed here. (RENDER CACHE) (2026-10-17)
+	/** Version of the data, incremented by each "updateWidgets" signal. */
+	uint64_t		_version;
+	// END of change
+
 	int _openDataFile(kshark_context *kshark_ctx, const QString &file);
 
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	void _applyLoadOptions(kshark_context *kshark_ctx, int sd);
+	// END of change
+
 	void _freeData();
 
 	void _applyIdFilter(int filterId, QVector<int> vec, int sd);
 
+	//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+	void _buildPostings();
+
+	void _updateCPUCollections(int sd, kshark_hash_id *cpus);
+	// END of change
+
 	void _addPluginsToStream(kshark_context *kshark_ctx, int sd,
 				 QVector<kshark_dpi *> plugins);
 };
@@ -87,6 +87,17 @@ void KsProgressBar::setValue(int i) {
 	QApplication::processEvents();
 }
 
+//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+/** @brief Show a status message next to the progressbar.
+ *
+ * @param status: The message.
+ */
+void KsProgressBar::setStatus(const QString &status) {
+	_sb.showMessage(status);
+	QApplication::processEvents();
+}
+// END of change
+
 /** Show continuous work. */
 void KsProgressBar::workInProgress()
 {
@@ -229,7 +240,13 @@ bool fileExistsDialog(QString fileName)
 }
 
 /** Create KsTimeOffsetDialog. */
-KsTimeOffsetDialog::KsTimeOffsetDialog(QWidget *parent) : QDialog(parent)
+KsTimeOffsetDialog::KsTimeOffsetDialog(QWidget *parent)
+: QDialog(parent),
+//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+  _sd(0),
+  _initOffset(0.),
+  _previewed(false)
+// END of change
 {
 	kshark_context *kshark_ctx(nullptr);
 	QVector<int> streamIds;
@@ -238,10 +255,20 @@ KsTimeOffsetDialog::KsTimeOffsetDialog(QWidget *parent) : QDialog(parent)
 
 	auto lamApply = [&] (double val) {
 		int sd = _streamCombo.currentData().toInt();
+		//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+		_previewed = false;
+		// END of change
 		emit apply(sd, val);
 		close();
 	};
 
+	//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+	auto lamPreview = [&] (double val) {
+		_previewed = true;
+		emit preview(_sd, val);
+	};
+	// END of change
+
 	if (!kshark_instance(&kshark_ctx))
 		return;
 
@@ -252,7 +279,9 @@ KsTimeOffsetDialog::KsTimeOffsetDialog(QWidget *parent) : QDialog(parent)
 		for (auto const &sd: streamIds)
 			if (sd != 0) {
 				streamName = KsUtils::streamDescription(kshark_ctx->stream[sd]);
-				_streamCombo.addItem(streamName);
+				//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+				_streamCombo.addItem(streamName, sd);
+				// END of change
 			}
 
 		layout()->addWidget(&_streamCombo);
@@ -270,15 +299,37 @@ KsTimeOffsetDialog::KsTimeOffsetDialog(QWidget *parent) : QDialog(parent)
 	connect(&_input,	&QInputDialog::doubleValueSelected,
 		lamApply);
 
+	//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+	connect(&_input,	&QInputDialog::doubleValueChanged,
+		lamPreview);
+	// END of change
+
 	connect(&_input,	&QDialog::rejected,
 		this,		&QWidget::close);
 
+	//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+	/* Closing the dialog without applying discards the preview. */
+	connect(this,		&QDialog::rejected,
+		this,		&KsTimeOffsetDialog::_restore);
+	// END of change
+
 	connect(&_streamCombo,	&QComboBox::currentIndexChanged,
 		this,		&KsTimeOffsetDialog::_setDefault);
 
 	show();
 }
 
+//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+void KsTimeOffsetDialog::_restore()
+{
+	if (!_previewed)
+		return;
+
+	_previewed = false;
+	emit restore(_sd, _initOffset);
+}
+// END of change
+
 void KsTimeOffsetDialog::_setDefault(int) {
 	int sd = _streamCombo.currentData().toInt();
 	kshark_context *kshark_ctx(nullptr);
@@ -288,6 +339,11 @@ void KsTimeOffsetDialog::_setDefault(int) {
 	if (!kshark_instance(&kshark_ctx))
 		return;
 
+	//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+	/* Discard the preview of the previously selected Data stream. */
+	_restore();
+	// END of change
+
 	stream = kshark_get_data_stream(kshark_ctx, sd);
 	if (!stream)
 		return;
@@ -300,6 +356,13 @@ void KsTimeOffsetDialog::_setDefault(int) {
 	}
 
 	offset = stream->calib_array[0] * 1e-3;
+	//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+	_sd = sd;
+	_initOffset = offset;
+
+	/* Setting the initial value is not a preview. */
+	QSignalBlocker blocker(&_input);
+	// END of change
 	_input.setDoubleValue(offset);
 }
 
@@ -44,6 +44,10 @@ public:
 
 	void setValue(int i);
 
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	void setStatus(const QString &status);
+	// END of change
+
 	void workInProgress();
 
 private:
@@ -204,11 +208,32 @@ signals:
 	/** Signal emitted when the "Apply" button is pressed. */
 	void apply(int sd, double val);
 
+	//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+	/** Signal emitted when the value is being edited (live preview). */
+	void preview(int sd, double val);
+
+	/**
+	 * Signal emitted when a previewed value gets discarded. "val" is the
+	 * offset the Data stream had before the preview.
+	 */
+	void restore(int sd, double val);
+	// END of change
+
 private:
 	QInputDialog	_input;
 
 	QComboBox	_streamCombo;
 
+	//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+	int		_sd;
+
+	double		_initOffset;
+
+	bool		_previewed;
+
+	void _restore();
+	// END of change
+
 private slots:
 	void _setDefault(int index);
 };
@@ -34,6 +34,14 @@ void usage(const char *prog)
 	puts(" --cpu	show plots for CPU cores, default is \"show all\"");
 	puts(" --pid	show plots for tasks (by PID), default is \"do not show\"");
 	puts(" --task	show plots for tasks (by name), default is \"do not show\"");
+	//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+	puts(" --cache	keep the loaded data in a cache file next to the trace file (<file>.ksidx)");
+	// END of change
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	puts(" --from	load only the data after this time (in seconds)");
+	puts(" --to	load only the data before this time (in seconds)");
+	puts(" --events	load only these events or event systems, e.g. \"sched,irq/irq_handler_entry\"");
+	// END of change
 	puts("\n example:");
 	puts("  kernelshark -i mytrace.dat --cpu 1,4-7 --pid 11 -p path/to/my/plugin/myplugin.so\n");
 }
@@ -44,6 +52,14 @@ static option longOptions[] = {
 	{"pid", required_argument, nullptr, KS_LONG_OPTS},
 	{"cpu", required_argument, nullptr, KS_LONG_OPTS},
 	{"task", required_argument, nullptr, KS_LONG_OPTS},
+	//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+	{"cache", no_argument, nullptr, KS_LONG_OPTS},
+	// END of change
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	{"from", required_argument, nullptr, KS_LONG_OPTS},
+	{"to", required_argument, nullptr, KS_LONG_OPTS},
+	{"events", required_argument, nullptr, KS_LONG_OPTS},
+	// END of change
 	{nullptr, 0, nullptr, 0}
 };
 
@@ -54,6 +70,12 @@ int main(int argc, char **argv)
 	int optionIndex = 0;
 	QString taskList;
 	int c;
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	int64_t loadFrom = INT64_MIN, loadTo = INT64_MAX;
+	QStringList loadEvents;
+	QString sessionFile;
+	bool badTime = false;
+	// END of change
 
 	QApplication::setDesktopFileName(KS_APP_NAME);
 	QApplication a(argc, argv);
@@ -72,6 +94,23 @@ int main(int argc, char **argv)
 				taskPlots.append(KsUtils::parseIdList(QString(optarg)));
 			else if (strcmp(longOptions[optionIndex].name, "task") == 0)
 				taskList = QString(optarg);
+			//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+			else if (strcmp(longOptions[optionIndex].name, "cache") == 0)
+				ks.setEntryCache(true);
+			// END of change
+			//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+			else if (strcmp(longOptions[optionIndex].name, "from") == 0)
+				badTime = kshark_parse_seconds(optarg, &loadFrom) < 0;
+			else if (strcmp(longOptions[optionIndex].name, "to") == 0)
+				badTime = kshark_parse_seconds(optarg, &loadTo) < 0;
+			else if (strcmp(longOptions[optionIndex].name, "events") == 0)
+				loadEvents = QString(optarg).split(",", KS_SPLIT_SkipEmptyParts);
+
+			if (badTime) {
+				fprintf(stderr, "Invalid time: %s\n", optarg);
+				return 1;
+			}
+			// END of change
 			break;
 
 		case 'h':
@@ -98,21 +137,30 @@ int main(int argc, char **argv)
 			ks.unregisterPlugins(QString(optarg));
 			break;
 
+		//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+		/* Imported once all load options are known. */
 		case 's':
-			ks.loadSession(QString(optarg));
+			sessionFile = QString(optarg);
 			fromSession = true;
 			break;
 
 		case 'l':
-			ks.loadSession(ks.lastSessionFile());
+			sessionFile = ks.lastSessionFile();
 			fromSession = true;
 			break;
+		// END of change
 
 		default:
 			break;
 		}
 	}
 
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	ks.setLoadOptions(loadFrom, loadTo, loadEvents);
+	if (fromSession)
+		ks.loadSession(sessionFile);
+	// END of change
+
 	if (!fromSession) {
 		if ((argc - optind) >= 1) {
 			if (prior_input_file)
@@ -0,0 +1,181 @@
+//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+/* Copyright (C) 2026, David Jaromír Šebánek <djsebofficial@gmail.com> */
+
+/**
+ *  @file    libkshark-arena.c
+ *  @brief   Memory arena used to allocate large numbers of small objects
+ *	     (e.g. trace entries) with only a handful of allocations.
+ */
+
+// C
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// KernelShark
+#include "libkshark.h"
+
+/** A contiguous block of memory, owned by a memory arena. */
+struct kshark_arena_chunk {
+	/** Pointer to the next chunk of the arena. */
+	struct kshark_arena_chunk	*next;
+
+	/** The number of bytes available in this chunk. */
+	size_t				size;
+
+	/** The number of bytes already handed out from this chunk. */
+	size_t				used;
+
+	/** The memory of the chunk. */
+	max_align_t			data[];
+};
+
+/** All objects are aligned as if they were allocated with malloc(). */
+#define KS_ARENA_ALIGN		(sizeof(max_align_t))
+
+static inline size_t arena_align(size_t size)
+{
+	return (size + KS_ARENA_ALIGN - 1) & ~(KS_ARENA_ALIGN - 1);
+}
+
+/**
+ * @brief Create a memory arena.
+ *
+ * @param chunk_size: The size (in bytes) of the memory chunks, allocated
+ *		      by the arena. Use zero for the default size.
+ *
+ * @returns Pointer to the new arena on success, or NULL on failure.
+ *	    The user is responsible for freeing it via kshark_arena_free().
+ */
+struct kshark_mem_arena *kshark_arena_alloc(size_t chunk_size)
+{
+	struct kshark_mem_arena *arena;
+
+	arena = calloc(1, sizeof(*arena));
+	if (!arena) {
+		fprintf(stderr, "Failed to allocate memory arena.\n");
+		return NULL;
+	}
+
+	arena->chunk_size = chunk_size ? chunk_size : KS_ARENA_CHUNK_SIZE;
+
+	return arena;
+}
+
+/**
+ * @brief Allocate zero-initialized memory from the arena. The memory
+ *	  cannot be released individually. It is released all at once
+ *	  by kshark_arena_clear() or kshark_arena_free().
+ *
+ * @param arena: Input location for the arena.
+ * @param size: The number of bytes to allocate.
+ *
+ * @returns Pointer to the allocated memory on success, or NULL on failure.
+ */
+void *kshark_arena_malloc(struct kshark_mem_arena *arena, size_t size)
+{
+	struct kshark_arena_chunk *chunk = arena->chunks;
+	size_t chunk_size;
+	void *mem;
+
+	size = arena_align(size);
+	if (!chunk || chunk->size - chunk->used < size) {
+		chunk_size = arena->chunk_size;
+		if (chunk_size < size)
+			chunk_size = size;
+
+		/*
+		 * The memory of the new chunk is not zeroed here. Only the
+		 * part that is actually used gets initialized below.
+		 */
+		chunk = malloc(sizeof(*chunk) + chunk_size);
+		if (!chunk) {
+			fprintf(stderr,
+				"Failed to allocate memory arena chunk.\n");
+			return NULL;
+		}
+
+		chunk->size = chunk_size;
+		chunk->used = 0;
+		chunk->next = arena->chunks;
+		arena->chunks = chunk;
+		arena->n_bytes += chunk_size;
+	}
+
+	mem = (char *) chunk->data + chunk->used;
+	chunk->used += size;
+	memset(mem, 0, size);
+
+	return mem;
+}
+
+/**
+ * @brief Move all memory owned by one arena into another arena. After the
+ *	  call the source arena is empty, while all objects allocated from
+ *	  it stay valid and are owned by the destination arena.
+ *
+ * @param dst: Input location for the destination arena.
+ * @param src: Input location for the source arena.
+ */
+void kshark_arena_merge(struct kshark_mem_arena *dst,
+			struct kshark_mem_arena *src)
+{
+	struct kshark_arena_chunk *last;
+
+	if (!src->chunks)
+		return;
+
+	for (last = src->chunks; last->next; last = last->next)
+		;
+
+	/*
+	 * Insert the chunks of the source just after the current chunk of
+	 * the destination, so that the destination keeps filling it.
+	 */
+	if (dst->chunks) {
+		last->next = dst->chunks->next;
+		dst->chunks->next = src->chunks;
+	} else {
+		dst->chunks = src->chunks;
+	}
+
+	dst->n_bytes += src->n_bytes;
+
+	src->chunks = NULL;
+	src->n_bytes = 0;
+}
+
+/**
+ * @brief Release all memory allocated from the arena. The arena itself
+ *	  stays valid and can be used again.
+ *
+ * @param arena: Input location for the arena.
+ */
+void kshark_arena_clear(struct kshark_mem_arena *arena)
+{
+	struct kshark_arena_chunk *chunk;
+
+	if (!arena)
+		return;
+
+	while (arena->chunks) {
+		chunk = arena->chunks;
+		arena->chunks = chunk->next;
+		free(chunk);
+	}
+
+	arena->n_bytes = 0;
+}
+
+/**
+ * @brief Release all memory allocated from the arena and free the arena.
+ *
+ * @param arena: Input location for the arena.
+ */
+void kshark_arena_free(struct kshark_mem_arena *arena)
+{
+	kshark_arena_clear(arena);
+	free(arena);
+}
+// END of change
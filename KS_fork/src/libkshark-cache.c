@@ -0,0 +1,910 @@
+//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+/* Copyright (C) 2026, David Jaromír Šebánek <djsebofficial@gmail.com> */
+
+/**
+ *  @file    libkshark-cache.c
+ *  @brief   Sidecar cache file, storing the loaded entries of an FTRACE data
+ *	     stream, so that the trace data file can be reopened without
+ *	     decoding all its records again.
+ */
+
+#ifndef _GNU_SOURCE
+/** Use GNU C Library. */
+#define _GNU_SOURCE
+#endif // _GNU_SOURCE
+
+// C
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// trace-cmd
+#include <trace-cmd.h>
+
+// KernelShark
+#include "libkshark.h"
+#include "libkshark-plugin.h"
+#include "libkshark-tepdata.h"
+#include "libkshark-couplebreak.h"
+
+/** Identifies a cache file. */
+#define KS_CACHE_MAGIC		"KSIDX\0\0"
+
+/** Version of the format of the cache file. */
+#define KS_CACHE_VERSION	2
+
+/**
+ * The number of bytes at the beginning and at the end of the trace data
+ * file, used to detect changes of its content.
+ */
+#define KS_CACHE_PROBE_SIZE	(1 << 20)
+
+/** The number of column values written at once. */
+#define KS_CACHE_WRITE_CHUNK	4096
+
+/**
+ * The header of the cache file. It is followed by the columns of the entries
+ * (ts, offset, next, pid, event_id, cpu, visible), the Ids of the idle CPUs,
+ * the PIDs of the tasks and the task names. Each section starts at a multiple
+ * of 8 bytes.
+ */
+struct ks_cache_header {
+	/** Must be KS_CACHE_MAGIC. */
+	char		magic[8];
+
+	/** Must be KS_CACHE_VERSION. */
+	uint32_t	version;
+
+	/** The size of this header. */
+	uint32_t	header_size;
+
+	/** The size of the trace data file. */
+	uint64_t	file_size;
+
+	/** The modification time of the trace data file (seconds). */
+	int64_t		mtime_sec;
+
+	/** The modification time of the trace data file (nanoseconds). */
+	int64_t		mtime_nsec;
+
+	/** Hash of parts of the content of the trace data file. */
+	uint64_t	content_hash;
+
+	/**
+	 * Hash of the configuration of the data stream, affecting the content
+	 * of the entries (plugins, couplebreak, time calibration).
+	 */
+	uint64_t	config_hash;
+
+	/** The number of entries. */
+	int64_t		n_entries;
+
+	/** The number of CPUs of the data stream. */
+	int32_t		n_cpus;
+
+	/** The number of idle CPUs. */
+	int32_t		n_idle_cpus;
+
+	/** The number of tasks. */
+	int32_t		n_tasks;
+
+	/** The number of couplebreak event types of the data stream. */
+	int32_t		n_couplebreak_evts;
+
+	/** Bitmask of the couplebreak event types of the data stream. */
+	int32_t		couplebreak_evts_flags;
+
+	/** Unused. */
+	int32_t		pad;
+
+	/** The size of the task names (NUL-terminated strings). */
+	uint64_t	comm_size;
+};
+
+/** File offsets of the sections of a cache file. */
+struct ks_cache_layout {
+	size_t	ts;
+	size_t	offset;
+	size_t	next;
+	size_t	pid;
+	size_t	event_id;
+	size_t	cpu;
+	size_t	visible;
+	size_t	idle_cpus;
+	size_t	tasks;
+	size_t	comms;
+	size_t	size;
+};
+
+static inline size_t cache_align(size_t size)
+{
+	return (size + 7) & ~(size_t) 7;
+}
+
+static void cache_layout(const struct ks_cache_header *header,
+			 struct ks_cache_layout *layout)
+{
+	size_t n = header->n_entries;
+
+	layout->ts = cache_align(sizeof(*header));
+	layout->offset = layout->ts + cache_align(n * sizeof(int64_t));
+	layout->next = layout->offset + cache_align(n * sizeof(int64_t));
+	layout->pid = layout->next + cache_align(n * sizeof(int64_t));
+	layout->event_id = layout->pid + cache_align(n * sizeof(int32_t));
+	layout->cpu = layout->event_id + cache_align(n * sizeof(int16_t));
+	layout->visible = layout->cpu + cache_align(n * sizeof(int16_t));
+	layout->idle_cpus = layout->visible + cache_align(n * sizeof(uint8_t));
+	layout->tasks = layout->idle_cpus +
+			cache_align(header->n_idle_cpus * sizeof(int32_t));
+	layout->comms = layout->tasks +
+			cache_align(header->n_tasks * sizeof(int32_t));
+	layout->size = layout->comms + cache_align(header->comm_size);
+}
+
+/** FNV-1a hash. */
+static uint64_t cache_hash(uint64_t hash, const void *data, size_t size)
+{
+	const uint8_t *bytes = data;
+	size_t i;
+
+	for (i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+/** The initial value of the FNV-1a hash. */
+#define KS_CACHE_HASH_INIT	14695981039346656037ULL
+
+static int cache_hash_file_part(int fd, off_t offset, size_t size,
+				uint64_t *hash)
+{
+	char *buf = malloc(size);
+	ssize_t ret;
+
+	if (!buf)
+		return -ENOMEM;
+
+	ret = pread(fd, buf, size, offset);
+	if (ret == (ssize_t) size)
+		*hash = cache_hash(*hash, buf, size);
+
+	free(buf);
+
+	return ret == (ssize_t) size ? 0 : -EIO;
+}
+
+/*
+ * Hashing the whole trace data file would take as long as loading it. Only
+ * its beginning and its end are hashed, together with the Id of the trace.
+ */
+static int cache_content_hash(struct kshark_data_stream *stream,
+			      const struct stat *st, uint64_t *hash)
+{
+	struct tracecmd_input *input = kshark_get_tep_input(stream);
+	size_t size = KS_CACHE_PROBE_SIZE;
+	unsigned long long trace_id;
+	int fd, ret;
+
+	if (!input)
+		return -EFAULT;
+
+	fd = open(stream->file, O_RDONLY);
+	if (fd < 0)
+		return -errno;
+
+	if ((off_t) size > st->st_size)
+		size = st->st_size;
+
+	*hash = KS_CACHE_HASH_INIT;
+	trace_id = tracecmd_get_traceid(input);
+	*hash = cache_hash(*hash, &trace_id, sizeof(trace_id));
+
+	ret = cache_hash_file_part(fd, 0, size, hash);
+	if (!ret)
+		ret = cache_hash_file_part(fd, st->st_size - size, size, hash);
+
+	close(fd);
+
+	return ret;
+}
+
+static uint64_t cache_config_hash(struct kshark_data_stream *stream)
+{
+	uint64_t hash = KS_CACHE_HASH_INIT;
+	struct kshark_dpi_list *plugin;
+	bool calib;
+
+	if (stream->name)
+		hash = cache_hash(hash, stream->name, strlen(stream->name) + 1);
+
+	hash = cache_hash(hash, &stream->n_cpus, sizeof(stream->n_cpus));
+	hash = cache_hash(hash, &stream->couplebreak_on,
+			  sizeof(stream->couplebreak_on));
+
+	for (plugin = stream->plugins; plugin; plugin = plugin->next) {
+		if (!(plugin->status & KSHARK_PLUGIN_LOADED))
+			continue;
+
+		hash = cache_hash(hash, plugin->interface->name,
+				  strlen(plugin->interface->name) + 1);
+	}
+
+	calib = stream->calib && stream->calib_array;
+	hash = cache_hash(hash, &calib, sizeof(calib));
+	if (calib)
+		hash = cache_hash(hash, stream->calib_array,
+				  stream->calib_array_size *
+				  sizeof(*stream->calib_array));
+
+	return hash;
+}
+
+static int cache_init_header(struct kshark_data_stream *stream,
+			     struct ks_cache_header *header)
+{
+	struct stat st;
+	int ret;
+
+	if (stat(stream->file, &st) != 0)
+		return -errno;
+
+	memset(header, 0, sizeof(*header));
+	memcpy(header->magic, KS_CACHE_MAGIC, sizeof(header->magic));
+	header->version = KS_CACHE_VERSION;
+	header->header_size = sizeof(*header);
+	header->file_size = st.st_size;
+	header->mtime_sec = st.st_mtim.tv_sec;
+	header->mtime_nsec = st.st_mtim.tv_nsec;
+	header->config_hash = cache_config_hash(stream);
+	header->n_cpus = stream->n_cpus;
+
+	ret = cache_content_hash(stream, &st, &header->content_hash);
+
+	return ret;
+}
+
+static char *cache_file_name(struct kshark_data_stream *stream)
+{
+	char *path;
+	int ret;
+
+	if (kshark_tep_is_top_stream(stream))
+		ret = asprintf(&path, "%s%s", stream->file,
+			       KS_ENTRY_CACHE_SUFFIX);
+	else
+		ret = asprintf(&path, "%s.%s%s", stream->file, stream->name,
+			       KS_ENTRY_CACHE_SUFFIX);
+
+	return ret < 0 ? NULL : path;
+}
+
+/** The columns of the cache file. */
+enum ks_cache_column {
+	KS_CACHE_TS,
+	KS_CACHE_OFFSET,
+	KS_CACHE_NEXT,
+	KS_CACHE_PID,
+	KS_CACHE_EVENT_ID,
+	KS_CACHE_CPU,
+	KS_CACHE_VISIBLE,
+};
+
+/** The values of the entries, as stored in the cache file. */
+struct ks_cache_values {
+	/** The "offset" of couplebreak entries is the index of the origin. */
+	int64_t	*offset;
+
+	/** The index of the next entry on the same CPU, or -1. */
+	int64_t	*next;
+
+	/** PIDs of the entries, before any plugin action. */
+	int32_t	*pid;
+
+	/** Event Ids of the entries, before any plugin action. */
+	int16_t	*event_id;
+
+	/** Visibility flags of the entries, before any plugin action. */
+	uint8_t	*visible;
+};
+
+static bool write_padding(FILE *fp, size_t size)
+{
+	static const char zeros[8];
+	size_t pad = cache_align(size) - size;
+
+	return fwrite(zeros, 1, pad, fp) == pad;
+}
+
+static bool write_column(FILE *fp, struct kshark_entry **rows,
+			 ssize_t n_rows, const struct ks_cache_values *values,
+			 enum ks_cache_column column)
+{
+	union {
+		int64_t	i64[KS_CACHE_WRITE_CHUNK];
+		int32_t	i32[KS_CACHE_WRITE_CHUNK];
+		int16_t	i16[KS_CACHE_WRITE_CHUNK];
+		uint8_t	u8[KS_CACHE_WRITE_CHUNK];
+	} buf;
+	size_t elem_size = 0;
+	ssize_t i, j, n;
+
+	for (i = 0; i < n_rows; i += n) {
+		n = n_rows - i;
+		if (n > KS_CACHE_WRITE_CHUNK)
+			n = KS_CACHE_WRITE_CHUNK;
+
+		for (j = 0; j < n; ++j) {
+			switch (column) {
+			case KS_CACHE_TS:
+				buf.i64[j] = rows[i + j]->ts;
+				break;
+			case KS_CACHE_OFFSET:
+				buf.i64[j] = values->offset[i + j];
+				break;
+			case KS_CACHE_NEXT:
+				buf.i64[j] = values->next[i + j];
+				break;
+			case KS_CACHE_PID:
+				buf.i32[j] = values->pid[i + j];
+				break;
+			case KS_CACHE_EVENT_ID:
+				buf.i16[j] = values->event_id[i + j];
+				break;
+			case KS_CACHE_CPU:
+				buf.i16[j] = rows[i + j]->cpu;
+				break;
+			case KS_CACHE_VISIBLE:
+				buf.u8[j] = values->visible[i + j];
+				break;
+			}
+		}
+
+		switch (column) {
+		case KS_CACHE_TS:
+		case KS_CACHE_OFFSET:
+		case KS_CACHE_NEXT:
+			elem_size = sizeof(int64_t);
+			break;
+		case KS_CACHE_PID:
+			elem_size = sizeof(int32_t);
+			break;
+		case KS_CACHE_EVENT_ID:
+		case KS_CACHE_CPU:
+			elem_size = sizeof(int16_t);
+			break;
+		case KS_CACHE_VISIBLE:
+			elem_size = sizeof(uint8_t);
+			break;
+		}
+
+		if (fwrite(&buf, elem_size, n, fp) != (size_t) n)
+			return false;
+	}
+
+	return write_padding(fp, n_rows * elem_size);
+}
+
+static bool has_event_handlers(struct kshark_data_stream *stream,
+			       int event_id)
+{
+	int n_handlers;
+
+	if (stream->event_dispatch) {
+		kshark_dispatch_event(stream->event_dispatch, event_id,
+				      &n_handlers);
+		return n_handlers > 0;
+	}
+
+	return kshark_find_event_handler(stream->event_handlers,
+					 event_id) != NULL;
+}
+
+/*
+ * Get the index of the next entry in the list of the same CPU, or -1. The
+ * entries are sorted in time, so the next entry is among the entries having
+ * its timestamp. Note that this is not always the next entry on the CPU of
+ * the entry, since a couplebreak wakeup stays in the list of the waker.
+ */
+static int64_t cache_next_index(struct kshark_entry **rows, ssize_t n_rows,
+				ssize_t i)
+{
+	const struct kshark_entry *next = rows[i]->next;
+	ssize_t l = 0, h = n_rows, mid;
+
+	if (!next)
+		return -1;
+
+	while (l < h) {
+		mid = l + (h - l) / 2;
+		if (rows[mid]->ts < next->ts)
+			l = mid + 1;
+		else
+			h = mid;
+	}
+
+	for (; l < n_rows && rows[l]->ts == next->ts; ++l)
+		if (rows[l] == next)
+			return l;
+
+	return -EINVAL;
+}
+
+/*
+ * The plugin actions are executed again when the entries are restored from
+ * the cache, hence the values of the entries modified by plugins are stored
+ * as they were before the plugin actions. The values of the entries of
+ * FTRACE events are recovered from their records.
+ */
+static int get_cache_values(struct kshark_data_stream *stream,
+			    struct kshark_entry **rows, ssize_t n_rows,
+			    struct ks_cache_values *values)
+{
+	struct tracecmd_input *input = kshark_get_tep_input(stream);
+	struct tep_handle *tep = kshark_get_tep(stream);
+	struct tep_record *rec;
+	ssize_t i;
+
+	values->offset = malloc(n_rows * sizeof(*values->offset));
+	values->next = malloc(n_rows * sizeof(*values->next));
+	values->pid = malloc(n_rows * sizeof(*values->pid));
+	values->event_id = malloc(n_rows * sizeof(*values->event_id));
+	values->visible = malloc(n_rows * sizeof(*values->visible));
+	if (!values->offset || !values->next || !values->pid ||
+	    !values->event_id || !values->visible)
+		return -ENOMEM;
+
+	for (i = 0; i < n_rows; ++i) {
+		values->offset[i] = rows[i]->offset;
+		values->pid[i] = rows[i]->pid;
+		values->event_id[i] = rows[i]->event_id;
+		values->visible[i] = rows[i]->visible;
+
+		values->next[i] = cache_next_index(rows, n_rows, i);
+		if (values->next[i] < -1)
+			return -EINVAL;
+
+		if (is_couplebreak_event(rows[i]->event_id)) {
+			values->offset[i] =
+				couplebreak_origin_index(rows, n_rows, i);
+			if (values->offset[i] < 0)
+				return -EINVAL;
+		}
+
+		if (rows[i]->event_id < 0 ||
+		    !has_event_handlers(stream, rows[i]->event_id))
+			continue;
+
+		rec = tracecmd_read_at(input, rows[i]->offset, NULL);
+		if (!rec)
+			return -EIO;
+
+		values->pid[i] = tep_data_pid(tep, rec);
+		values->event_id[i] = tep_data_type(tep, rec);
+		values->visible[i] = 0xFF;
+		tracecmd_free_record(rec);
+	}
+
+	return 0;
+}
+
+static void free_cache_values(struct ks_cache_values *values)
+{
+	free(values->offset);
+	free(values->next);
+	free(values->pid);
+	free(values->event_id);
+	free(values->visible);
+}
+
+static bool write_task_names(FILE *fp, struct kshark_data_stream *stream,
+			     const int *tasks, int n_tasks, uint64_t *size)
+{
+	struct tep_handle *tep = kshark_get_tep(stream);
+	const char *comm;
+	int i;
+
+	*size = 0;
+	for (i = 0; i < n_tasks; ++i) {
+		comm = "";
+		if (tep_is_pid_registered(tep, tasks[i]))
+			comm = tep_data_comm_from_pid(tep, tasks[i]);
+
+		if (fwrite(comm, 1, strlen(comm) + 1, fp) != strlen(comm) + 1)
+			return false;
+
+		*size += strlen(comm) + 1;
+	}
+
+	return write_padding(fp, *size);
+}
+
+/**
+ * @brief Store the loaded entries of an FTRACE data stream in its sidecar
+ *	  cache file. The entries can only be stored if no filters are set
+ *	  for the stream, since the filters are applied again when the
+ *	  entries are restored.
+ *
+ * @param kshark_ctx: Input location for context pointer.
+ * @param stream: Input location for the FTRACE data stream pointer.
+ * @param rows: The entries of the stream, sorted in time.
+ * @param n_rows: The number of entries.
+ *
+ * @returns Zero on success, or a negative error code on failure.
+ */
+int kshark_tep_cache_save(struct kshark_context *kshark_ctx,
+			  struct kshark_data_stream *stream,
+			  struct kshark_entry **rows, ssize_t n_rows)
+{
+	enum ks_cache_column column;
+	struct ks_cache_values values = {};
+	struct ks_cache_header header;
+	int *idle_cpus = NULL, *tasks = NULL;
+	char *path, *tmp_path = NULL;
+	FILE *fp = NULL;
+	int ret;
+
+	if (kshark_filter_is_set(kshark_ctx, stream->stream_id) ||
+	    kshark_tep_filter_is_set(stream))
+		return -EAGAIN;
+
+	path = cache_file_name(stream);
+	if (!path)
+		return -ENOMEM;
+
+	ret = cache_init_header(stream, &header);
+	if (ret < 0)
+		goto end;
+
+	ret = get_cache_values(stream, rows, n_rows, &values);
+	if (ret < 0)
+		goto end;
+
+	ret = -ENOMEM;
+	if (stream->idle_cpus->count &&
+	    !(idle_cpus = kshark_hash_ids(stream->idle_cpus)))
+		goto end;
+
+	if (stream->tasks->count && !(tasks = kshark_hash_ids(stream->tasks)))
+		goto end;
+
+	header.n_entries = n_rows;
+	header.n_idle_cpus = stream->idle_cpus->count;
+	header.n_tasks = stream->tasks->count;
+	header.n_couplebreak_evts = stream->n_couplebreak_evts;
+	header.couplebreak_evts_flags = stream->couplebreak_evts_flags;
+
+	/*
+	 * Write a temporary file and rename it, so that a concurrent reader
+	 * never sees an incomplete cache file.
+	 */
+	if (asprintf(&tmp_path, "%s.%i", path, getpid()) < 0) {
+		tmp_path = NULL;
+		goto end;
+	}
+
+	ret = -EIO;
+	fp = fopen(tmp_path, "w");
+	if (!fp)
+		goto end;
+
+	/* The size of the task names is known once they are written. */
+	if (fwrite(&header, sizeof(header), 1, fp) != 1 ||
+	    !write_padding(fp, sizeof(header)))
+		goto end;
+
+	for (column = KS_CACHE_TS; column <= KS_CACHE_VISIBLE; ++column)
+		if (!write_column(fp, rows, n_rows, &values, column))
+			goto end;
+
+	if (fwrite(idle_cpus, sizeof(int32_t), header.n_idle_cpus, fp) !=
+	    (size_t) header.n_idle_cpus ||
+	    !write_padding(fp, header.n_idle_cpus * sizeof(int32_t)))
+		goto end;
+
+	if (fwrite(tasks, sizeof(int32_t), header.n_tasks, fp) !=
+	    (size_t) header.n_tasks ||
+	    !write_padding(fp, header.n_tasks * sizeof(int32_t)))
+		goto end;
+
+	if (!write_task_names(fp, stream, tasks, header.n_tasks,
+			      &header.comm_size))
+		goto end;
+
+	if (fseek(fp, 0, SEEK_SET) != 0 ||
+	    fwrite(&header, sizeof(header), 1, fp) != 1)
+		goto end;
+
+	ret = fclose(fp) == 0 ? 0 : -EIO;
+	fp = NULL;
+	if (!ret && rename(tmp_path, path) != 0)
+		ret = -errno;
+
+ end:
+	if (fp)
+		fclose(fp);
+
+	if (ret < 0 && tmp_path)
+		unlink(tmp_path);
+
+	free_cache_values(&values);
+	free(idle_cpus);
+	free(tasks);
+	free(tmp_path);
+	free(path);
+
+	return ret;
+}
+
+static bool cache_is_valid(struct kshark_data_stream *stream,
+			   const struct ks_cache_header *cached,
+			   size_t cache_size)
+{
+	struct ks_cache_layout layout;
+	struct ks_cache_header header;
+
+	if (cache_size < sizeof(header) ||
+	    memcmp(cached->magic, KS_CACHE_MAGIC, sizeof(cached->magic)) != 0 ||
+	    cached->version != KS_CACHE_VERSION ||
+	    cached->header_size != sizeof(header) ||
+	    cached->n_entries < 0 || cached->n_idle_cpus < 0 ||
+	    cached->n_tasks < 0)
+		return false;
+
+	cache_layout(cached, &layout);
+	if (layout.size != cache_size)
+		return false;
+
+	if (cache_init_header(stream, &header) < 0)
+		return false;
+
+	return header.file_size == cached->file_size &&
+	       header.mtime_sec == cached->mtime_sec &&
+	       header.mtime_nsec == cached->mtime_nsec &&
+	       header.content_hash == cached->content_hash &&
+	       header.config_hash == cached->config_hash &&
+	       header.n_cpus == cached->n_cpus;
+}
+
+static struct kshark_entry **
+cache_alloc_entries(struct kshark_data_stream *stream, ssize_t n_rows)
+{
+	struct kshark_entry **rows, *entries;
+	ssize_t i;
+
+	rows = malloc(n_rows * sizeof(*rows));
+	if (!rows)
+		return NULL;
+
+	if (stream->entry_arena) {
+		entries = kshark_arena_malloc(stream->entry_arena,
+					      n_rows * sizeof(*entries));
+		if (!entries) {
+			free(rows);
+			return NULL;
+		}
+
+		for (i = 0; i < n_rows; ++i)
+			rows[i] = &entries[i];
+
+		return rows;
+	}
+
+	for (i = 0; i < n_rows; ++i) {
+		rows[i] = malloc(sizeof(*rows[i]));
+		if (!rows[i]) {
+			while (i--)
+				free(rows[i]);
+
+			free(rows);
+			return NULL;
+		}
+	}
+
+	return rows;
+}
+
+static void cache_restore_tasks(struct kshark_data_stream *stream,
+				const char *map,
+				const struct ks_cache_header *header,
+				const struct ks_cache_layout *layout)
+{
+	const int32_t *idle_cpus = (const int32_t *) (map + layout->idle_cpus);
+	const int32_t *tasks = (const int32_t *) (map + layout->tasks);
+	const char *comm = map + layout->comms;
+	const char *comm_end = comm + header->comm_size;
+	struct tep_handle *tep = kshark_get_tep(stream);
+	int i;
+
+	for (i = 0; i < header->n_idle_cpus; ++i)
+		kshark_hash_id_add(stream->idle_cpus, idle_cpus[i]);
+
+	for (i = 0; i < header->n_tasks && comm < comm_end; ++i) {
+		kshark_hash_id_add(stream->tasks, tasks[i]);
+
+		if (*comm && !tep_is_pid_registered(tep, tasks[i]))
+			tep_register_comm(tep, comm, tasks[i]);
+
+		comm += strnlen(comm, comm_end - comm) + 1;
+	}
+
+	stream->n_couplebreak_evts = header->n_couplebreak_evts;
+	stream->couplebreak_evts_flags = header->couplebreak_evts_flags;
+}
+
+/* Execute the plugin actions, using the records of the entries. */
+static int cache_replay_plugins(struct kshark_data_stream *stream,
+				struct kshark_entry **rows, ssize_t n_rows)
+{
+	struct tracecmd_input *input = kshark_get_tep_input(stream);
+	struct kshark_entry *record_entry;
+	struct tep_record *rec;
+	ssize_t i;
+
+	if (!stream->event_handlers)
+		return 0;
+
+	for (i = 0; i < n_rows; ++i) {
+		if (!has_event_handlers(stream, rows[i]->event_id))
+			continue;
+
+		/* Couplebreak entries use the record of their origin. */
+		record_entry = rows[i];
+		if (is_couplebreak_event(rows[i]->event_id))
+			record_entry = (struct kshark_entry *) rows[i]->offset;
+		else if (rows[i]->event_id < 0)
+			continue;
+
+		rec = tracecmd_read_at(input, record_entry->offset, NULL);
+		if (!rec)
+			return -EIO;
+
+		kshark_plugin_actions(stream, rec, rows[i]);
+		tracecmd_free_record(rec);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Load the entries of an FTRACE data stream from its sidecar cache
+ *	  file. The cache file is used only if it is consistent with the
+ *	  trace data file and with the configuration of the stream. The
+ *	  plugin actions and the filters are applied to the restored entries.
+ *
+ * @param kshark_ctx: Input location for context pointer.
+ * @param stream: Input location for the FTRACE data stream pointer.
+ * @param data_rows: Output location for the trace data.
+ *
+ * @returns The number of entries on success, or a negative error code if
+ *	    the entries cannot be loaded from the cache file.
+ */
+ssize_t kshark_tep_cache_load(struct kshark_context *kshark_ctx,
+			      struct kshark_data_stream *stream,
+			      struct kshark_entry ***data_rows)
+{
+	const struct ks_cache_header *header;
+	struct ks_cache_layout layout;
+	const int64_t *ts, *offset, *next;
+	const int16_t *event_id, *cpu;
+	struct kshark_entry **rows;
+	struct kshark_entry *e;
+	const uint8_t *visible;
+	const int32_t *pid;
+	bool filter, valid;
+	ssize_t i, n_rows;
+	struct stat st;
+	char *path;
+	void *map;
+	int fd;
+
+	path = cache_file_name(stream);
+	if (!path)
+		return -ENOMEM;
+
+	fd = open(path, O_RDONLY);
+	free(path);
+	if (fd < 0)
+		return -ENOENT;
+
+	if (fstat(fd, &st) != 0 || !st.st_size) {
+		close(fd);
+		return -EINVAL;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return -ENOMEM;
+
+	header = map;
+	valid = cache_is_valid(stream, header, st.st_size);
+	if (!valid) {
+		n_rows = -ESTALE;
+		goto unmap;
+	}
+
+	n_rows = header->n_entries;
+	rows = cache_alloc_entries(stream, n_rows);
+	if (!rows) {
+		n_rows = -ENOMEM;
+		goto unmap;
+	}
+
+	cache_layout(header, &layout);
+	ts = (const int64_t *) ((char *) map + layout.ts);
+	offset = (const int64_t *) ((char *) map + layout.offset);
+	next = (const int64_t *) ((char *) map + layout.next);
+	pid = (const int32_t *) ((char *) map + layout.pid);
+	event_id = (const int16_t *) ((char *) map + layout.event_id);
+	cpu = (const int16_t *) ((char *) map + layout.cpu);
+	visible = (const uint8_t *) ((char *) map + layout.visible);
+
+	for (i = 0; i < n_rows; ++i) {
+		e = rows[i];
+		if (next[i] < -1 || next[i] >= n_rows)
+			goto fail;
+
+		/* Restore the lists of the CPUs. */
+		e->next = (next[i] < 0) ? NULL : rows[next[i]];
+		e->visible = visible[i];
+		e->stream_id = stream->stream_id;
+		e->event_id = event_id[i];
+		e->cpu = cpu[i];
+		e->pid = pid[i];
+		e->offset = offset[i];
+		e->ts = ts[i];
+
+		if (is_couplebreak_event(e->event_id)) {
+			if (offset[i] < 0 || offset[i] >= n_rows)
+				goto fail;
+
+			e->offset = (int64_t) rows[offset[i]];
+		}
+	}
+
+	cache_restore_tasks(stream, map, header, &layout);
+
+	if (cache_replay_plugins(stream, rows, n_rows) < 0)
+		goto fail;
+
+	filter = kshark_filter_is_set(kshark_ctx, stream->stream_id);
+	//NOTE: Changed here. (ID SETS) (2026-10-17)
+	if (filter)
+		kshark_update_filter_sets(kshark_ctx, stream->stream_id);
+	// END of change
+	for (i = 0; filter && i < n_rows; ++i)
+		kshark_apply_filters(kshark_ctx, stream, rows[i]);
+
+	//NOTE: Changed here. (ADV FILTER REFRESH) (2026-10-17)
+	/* The advanced filter reads only the records it needs. */
+	if (kshark_tep_apply_adv_filter(kshark_ctx, stream, rows, n_rows) < 0)
+		goto fail;
+
+	stream->filter_is_applied = filter || kshark_tep_filter_is_set(stream);
+	// END of change
+
+	*data_rows = rows;
+	goto unmap;
+
+ fail:
+	if (!stream->entry_arena)
+		for (i = 0; i < n_rows; ++i)
+			free(rows[i]);
+
+	free(rows);
+	n_rows = -EINVAL;
+
+ unmap:
+	munmap(map, st.st_size);
+
+	return n_rows;
+}
+// END of change
@@ -16,6 +16,10 @@
 #include <assert.h>
 #include <errno.h>
 #include <stdio.h>
+//NOTE: Changed here. (CPU COLLECTIONS) (2026-10-17)
+#include <pthread.h>
+#include <unistd.h>
+// END of change
 
 // KernelShark
 #include "libkshark.h"
@@ -877,6 +881,650 @@ kshark_add_collection_to_list(struct kshark_context *kshark_ctx,
 	return col;
 }
 
+//NOTE: Changed here. (CPU COLLECTIONS) (2026-10-17)
+/* Quiet warnings over documenting simple structures */
+//! @cond Doxygen_Suppress
+
+/* Flags of the marks of the entries, computed before the sweep. */
+#define CPU_COL_MATCH		(1 << 0)
+#define CPU_COL_NEXT_FAILS	(1 << 1)
+#define CPU_COL_SLOT_SHIFT	2
+
+struct cpu_col_job {
+	struct kshark_context	*kshark_ctx;
+	struct kshark_entry	**data;
+	matching_condition_func	*cond;
+	int			sd;
+	const int		*slot_of;
+	int			max_cpu;
+	uint32_t		*marks;
+	size_t			first;
+	size_t			last;
+	pthread_t		thread;
+	bool			started;
+};
+
+struct cpu_col_points {
+	size_t			*resume_points;
+	size_t			*break_points;
+	size_t			n_resume;
+	size_t			n_break;
+	size_t			capacity;
+	struct kshark_entry	*pending;
+	bool			good_data;
+};
+
+//! @endcond
+
+/*
+ * Mark each entry of the range with the number (plus one) of the collection
+ * it may belong to, and with the result of the Matching condition for the
+ * entry and for the next entry on the same CPU. Zero marks an entry, which
+ * is irrelevant for all collections.
+ */
+static void *cpu_col_mark(void *arg)
+{
+	struct cpu_col_job *job = arg;
+	struct kshark_entry *e;
+	uint32_t mark;
+	size_t i;
+	int cpu;
+
+	for (i = job->first; i < job->last; ++i) {
+		e = job->data[i];
+		cpu = e->cpu;
+		if (e->stream_id != job->sd || cpu < 0 || cpu > job->max_cpu ||
+		    job->slot_of[cpu] < 0) {
+			job->marks[i] = 0;
+			continue;
+		}
+
+		mark = (job->slot_of[cpu] + 1) << CPU_COL_SLOT_SHIFT;
+		if (job->cond(job->kshark_ctx, e, job->sd, &cpu)) {
+			mark |= CPU_COL_MATCH;
+			if (e->next &&
+			    !job->cond(job->kshark_ctx, e->next, job->sd, &cpu))
+				mark |= CPU_COL_NEXT_FAILS;
+		}
+
+		job->marks[i] = mark;
+	}
+
+	return NULL;
+}
+
+/*
+ * Append an index to one of the arrays of points. Both arrays grow together,
+ * as there are never fewer Resume points than Break points.
+ */
+static bool cpu_col_push(struct cpu_col_points *points, size_t **array,
+			 size_t *count, size_t index)
+{
+	size_t capacity;
+	size_t *tmp;
+
+	if (*count == points->capacity) {
+		capacity = points->capacity ? 2 * points->capacity : 16;
+
+		tmp = realloc(points->resume_points,
+			      capacity * sizeof(*tmp));
+		if (!tmp)
+			return false;
+
+		points->resume_points = tmp;
+
+		tmp = realloc(points->break_points,
+			      capacity * sizeof(*tmp));
+		if (!tmp)
+			return false;
+
+		points->break_points = tmp;
+		points->capacity = capacity;
+	}
+
+	(*array)[(*count)++] = index;
+
+	return true;
+}
+
+#define CPU_COL_RESUME(p, i) \
+	cpu_col_push(p, &(p)->resume_points, &(p)->n_resume, i)
+
+#define CPU_COL_BREAK(p, i) \
+	cpu_col_push(p, &(p)->break_points, &(p)->n_break, i)
+
+/*
+ * The "next" entries, at which the intervals of the collections break. There
+ * is at most one per collection, so the table never gets full.
+ */
+struct cpu_col_pending {
+	struct kshark_entry	**entries;
+	size_t			*slots;
+	size_t			mask;
+	size_t			count;
+};
+
+static bool cpu_col_pending_alloc(struct cpu_col_pending *pending,
+				  size_t n_cpus)
+{
+	size_t size = 8;
+
+	while (size < 2 * n_cpus)
+		size <<= 1;
+
+	pending->entries = calloc(size, sizeof(*pending->entries));
+	pending->slots = calloc(size, sizeof(*pending->slots));
+	pending->mask = size - 1;
+	pending->count = 0;
+
+	return pending->entries && pending->slots;
+}
+
+static void cpu_col_pending_free(struct cpu_col_pending *pending)
+{
+	free(pending->entries);
+	free(pending->slots);
+}
+
+static inline size_t cpu_col_pending_hash(const struct cpu_col_pending *pending,
+					  const struct kshark_entry *e)
+{
+	return ((uint64_t) (uintptr_t) e * 0x9E3779B97F4A7C15ULL) >> 40 &
+	       pending->mask;
+}
+
+static void cpu_col_pending_add(struct cpu_col_pending *pending,
+				struct kshark_entry *e, size_t slot)
+{
+	size_t h = cpu_col_pending_hash(pending, e);
+
+	while (pending->entries[h])
+		h = (h + 1) & pending->mask;
+
+	pending->entries[h] = e;
+	pending->slots[h] = slot;
+	++pending->count;
+}
+
+/* Find an entry in the table and remove it. */
+static bool cpu_col_pending_take(struct cpu_col_pending *pending,
+				 const struct kshark_entry *e, size_t *slot)
+{
+	size_t h = cpu_col_pending_hash(pending, e), j, home;
+
+	while (pending->entries[h] != e) {
+		if (!pending->entries[h])
+			return false;
+
+		h = (h + 1) & pending->mask;
+	}
+
+	*slot = pending->slots[h];
+	--pending->count;
+
+	/* Shift back the following entries of the probe sequence. */
+	for (j = (h + 1) & pending->mask; pending->entries[j];
+	     j = (j + 1) & pending->mask) {
+		home = cpu_col_pending_hash(pending, pending->entries[j]);
+		if (((j - home) & pending->mask) < ((j - h) & pending->mask))
+			continue;
+
+		pending->entries[h] = pending->entries[j];
+		pending->slots[h] = pending->slots[j];
+		h = j;
+	}
+
+	pending->entries[h] = NULL;
+
+	return true;
+}
+
+/*
+ * Sweep over the entries once and define the data intervals of all
+ * collections. The intervals are identical to those defined by
+ * kshark_data_collection_alloc() (with no margin data). The next entry, at
+ * which an interval breaks, is not necessarily on the CPU of the collection
+ * (Couplebreak entries have the CPU of the wakee, but are linked with the
+ * entries of the CPU of the waker), hence all entries are compared with the
+ * pending next entries of all collections.
+ */
+static bool cpu_col_sweep(struct kshark_entry **data, size_t n_rows,
+			  const uint32_t *marks,
+			  struct cpu_col_points *points, size_t n_cpus)
+{
+	struct cpu_col_pending pending;
+	struct cpu_col_points *p;
+	bool ret = false, skip;
+	size_t i, slot;
+
+	if (!cpu_col_pending_alloc(&pending, n_cpus))
+		goto out;
+
+	for (i = 0; i < n_rows; ++i) {
+		skip = false;
+		while (pending.count &&
+		       cpu_col_pending_take(&pending, data[i], &slot)) {
+			if (!CPU_COL_BREAK(&points[slot], i))
+				goto out;
+
+			points[slot].pending = NULL;
+
+			/* The collection ignores the entry it breaks at. */
+			if (marks[i] &&
+			    (marks[i] >> CPU_COL_SLOT_SHIFT) - 1 == slot)
+				skip = true;
+		}
+
+		if (!marks[i] || skip)
+			continue;
+
+		p = &points[(marks[i] >> CPU_COL_SLOT_SHIFT) - 1];
+
+		/* Ignore the entries of the CPU until the next one is reached. */
+		if (p->pending || !(marks[i] & CPU_COL_MATCH))
+			continue;
+
+		if (!p->good_data) {
+			p->good_data = true;
+			if (!CPU_COL_RESUME(p, i))
+				goto out;
+		} else if (marks[i] & CPU_COL_NEXT_FAILS) {
+			p->good_data = false;
+			p->pending = data[i]->next;
+			cpu_col_pending_add(&pending, p->pending, p - points);
+		}
+	}
+
+	for (i = 0; i < n_cpus; ++i) {
+		p = &points[i];
+		if (p->pending) {
+			if (!CPU_COL_BREAK(p, n_rows))
+				goto out;
+		} else if (p->good_data) {
+			if (!CPU_COL_BREAK(p, n_rows - 1))
+				goto out;
+		}
+
+		assert(p->n_resume == p->n_break);
+	}
+
+	ret = true;
+
+out:
+	cpu_col_pending_free(&pending);
+
+	return ret;
+}
+
+static long cpu_col_n_threads(struct kshark_context *kshark_ctx,
+			      size_t n_rows)
+{
+	long n_threads = kshark_ctx->n_filter_threads;
+	size_t n_chunks = n_rows / KS_FILTER_CHUNK_SIZE;
+
+	if (n_threads == KS_LOAD_THREADS_AUTO)
+		n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if ((size_t) n_threads > n_chunks)
+		n_threads = n_chunks;
+
+	return (n_threads < 1) ? 1 : n_threads;
+}
+
+/* Mark the entries by many threads, each taking a chunk of the array. */
+static void cpu_col_mark_all(struct cpu_col_job *tmpl, size_t n_rows)
+{
+	struct cpu_col_job single, *jobs;
+	long i, n_threads;
+
+	n_threads = cpu_col_n_threads(tmpl->kshark_ctx, n_rows);
+	jobs = (n_threads > 1) ? calloc(n_threads, sizeof(*jobs)) : NULL;
+	if (!jobs) {
+		n_threads = 1;
+		jobs = &single;
+	}
+
+	for (i = 0; i < n_threads; ++i) {
+		jobs[i] = *tmpl;
+		jobs[i].first = n_rows * i / n_threads;
+		jobs[i].last = n_rows * (i + 1) / n_threads;
+		jobs[i].started = false;
+	}
+
+	/* If a thread fails to start, its chunk is marked by this thread. */
+	for (i = 1; i < n_threads; ++i)
+		jobs[i].started = pthread_create(&jobs[i].thread, NULL,
+						 cpu_col_mark, &jobs[i]) == 0;
+
+	for (i = 0; i < n_threads; ++i)
+		if (!jobs[i].started)
+			cpu_col_mark(&jobs[i]);
+
+	for (i = 1; i < n_threads; ++i)
+		if (jobs[i].started)
+			pthread_join(jobs[i].thread, NULL);
+
+	if (jobs != &single)
+		free(jobs);
+}
+
+/**
+ * @brief Process the per-CPU data collections of a Data stream, defined with
+ *	  a given Matching condition function and the CPU as a value, in a
+ *	  single sweep over the data. Add these collections to a given list of
+ *	  collections. The resulting collections are the same as those, added
+ *	  one by one by kshark_add_collection_to_list() with no margin data.
+ *
+ * @param kshark_ctx: Input location for the session context pointer.
+ * @param col_list: Input location for the list of collections.
+ * @param data: Input location for the trace data.
+ * @param n_rows: The size of the inputted data.
+ * @param cond: Matching condition function for the collections to be
+ *	        registered. It must be satisfied only by entries of the Data
+ *	        stream, recorded on the CPU given as a value, and it gets
+ *	        called from many threads at once.
+ * @param sd: Data stream identifier.
+ * @param cpus: Array of CPUs, one collection is processed for each of them.
+ * @param n_cpus: The size of the array of CPUs.
+ *
+ * @returns Zero on success, or a negative error code on failure. On failure,
+ *	    no collection is added.
+ */
+int kshark_add_cpu_collections_to_list(struct kshark_context *kshark_ctx,
+				       struct kshark_entry_collection **col_list,
+				       struct kshark_entry **data,
+				       size_t n_rows,
+				       matching_condition_func cond,
+				       int sd, const int *cpus, size_t n_cpus)
+{
+	struct kshark_entry_collection **cols = NULL;
+	struct cpu_col_points *points = NULL;
+	struct cpu_col_job job = {};
+	int *slot_of = NULL;
+	int ret = -ENOMEM;
+	size_t i;
+
+	if (!data || n_rows == 0 || n_cpus == 0)
+		return 0;
+
+	job.max_cpu = -1;
+	for (i = 0; i < n_cpus; ++i) {
+		if (cpus[i] < 0)
+			return -EINVAL;
+
+		if (cpus[i] > job.max_cpu)
+			job.max_cpu = cpus[i];
+	}
+
+	slot_of = malloc((job.max_cpu + 1) * sizeof(*slot_of));
+	points = calloc(n_cpus, sizeof(*points));
+	cols = calloc(n_cpus, sizeof(*cols));
+	job.marks = malloc(n_rows * sizeof(*job.marks));
+	if (!slot_of || !points || !cols || !job.marks)
+		goto fail;
+
+	for (i = 0; i <= (size_t) job.max_cpu; ++i)
+		slot_of[i] = -1;
+
+	for (i = 0; i < n_cpus; ++i)
+		slot_of[cpus[i]] = i;
+
+	job.kshark_ctx = kshark_ctx;
+	job.data = data;
+	job.cond = cond;
+	job.sd = sd;
+	job.slot_of = slot_of;
+	cpu_col_mark_all(&job, n_rows);
+
+	if (!cpu_col_sweep(data, n_rows, job.marks, points, n_cpus))
+		goto fail;
+
+	for (i = 0; i < n_cpus; ++i) {
+		cols[i] = calloc(1, sizeof(*cols[i]));
+		if (!cols[i])
+			goto fail;
+
+		cols[i]->values = malloc(sizeof(*cols[i]->values));
+		if (!cols[i]->values)
+			goto fail;
+
+		cols[i]->cond = cond;
+		cols[i]->stream_id = sd;
+		cols[i]->values[0] = cpus[i];
+		cols[i]->n_val = 1;
+	}
+
+	/* Nothing can fail from here on. */
+	for (i = 0; i < n_cpus; ++i) {
+		cols[i]->resume_points = points[i].resume_points;
+		cols[i]->break_points = points[i].break_points;
+		cols[i]->size = points[i].n_resume;
+		points[i].resume_points = points[i].break_points = NULL;
+
+		cols[i]->next = *col_list;
+		*col_list = cols[i];
+		cols[i] = NULL;
+	}
+
+	ret = 0;
+
+fail:
+	if (ret < 0)
+		fprintf(stderr,
+			"Failed to allocate memory for Data collection.\n");
+
+	for (i = 0; points && cols && i < n_cpus; ++i) {
+		free(points[i].resume_points);
+		free(points[i].break_points);
+		if (cols[i])
+			kshark_free_data_collection(cols[i]);
+	}
+
+	free(job.marks);
+	free(cols);
+	free(points);
+	free(slot_of);
+
+	return ret;
+}
+
+/**
+ * @brief Process the per-CPU data collections of a Data stream, defined with
+ *	  a given Matching condition function and the CPU as a value, in a
+ *	  single sweep over the data. Add these collections to the list of
+ *	  collections used by the session.
+ *
+ * @param kshark_ctx: Input location for the session context pointer.
+ * @param data: Input location for the trace data.
+ * @param n_rows: The size of the inputted data.
+ * @param cond: Matching condition function for the collections to be
+ *	        registered. It must be satisfied only by entries of the Data
+ *	        stream, recorded on the CPU given as a value, and it gets
+ *	        called from many threads at once.
+ * @param sd: Data stream identifier.
+ * @param cpus: Array of CPUs, one collection is processed for each of them.
+ * @param n_cpus: The size of the array of CPUs.
+ *
+ * @returns Zero on success, or a negative error code on failure.
+ */
+int kshark_register_cpu_collections(struct kshark_context *kshark_ctx,
+				    struct kshark_entry **data, size_t n_rows,
+				    matching_condition_func cond,
+				    int sd, const int *cpus, size_t n_cpus)
+{
+	return kshark_add_cpu_collections_to_list(kshark_ctx,
+						  &kshark_ctx->collections,
+						  data, n_rows, cond, sd,
+						  cpus, n_cpus);
+}
+// END of change
+
+//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+/*
+ * Find the row of an entry, searching from a given row on. The rows are
+ * sorted in time, hence the timestamp of the entry is searched first. Like
+ * kshark_data_collection_alloc(), return the number of rows if the entry is
+ * not found.
+ */
+static size_t indexed_col_find(struct kshark_entry **data, size_t n_rows,
+			       size_t first, const struct kshark_entry *e)
+{
+	size_t lo = first, hi = n_rows, mid, i;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (data[mid]->ts < e->ts)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	for (i = lo; i < n_rows && data[i]->ts == e->ts; ++i)
+		if (data[i] == e)
+			return i;
+
+	/* The entry is missing, or the data is not sorted. */
+	for (i = first; i < n_rows; ++i)
+		if (data[i] == e)
+			return i;
+
+	return n_rows;
+}
+
+/**
+ * @brief Process a data collection, visiting only a given set of rows of the
+ *	  data, and add it to a given list of collections. The resulting
+ *	  collection is the same as the one, added by
+ *	  kshark_add_collection_to_list() with no margin data, but the time
+ *	  it takes depends only on the number of visited rows. Use it with
+ *	  the posting lists of the data (see kshark_posting_list()).
+ *
+ * @param kshark_ctx: Input location for the session context pointer.
+ * @param col_list: Input location for the list of collections.
+ * @param data: Input location for the trace data.
+ * @param n_rows: The size of the inputted data.
+ * @param rows: The sorted indexes of the rows to visit. All entries, which
+ *		may satisfy the Matching condition, must be among them.
+ * @param n_indexed: The size of the array of indexes.
+ * @param cond: Matching condition function for the collection to be
+ *	        registered.
+ * @param sd: Data stream identifier.
+ * @param values: Array of matching condition values for the collection to be
+ *		  registered.
+ * @param n_val: The number of matching condition values.
+ *
+ * @returns Pointer to the newly allocated collection, or NULL on failure.
+ */
+struct kshark_entry_collection *
+kshark_add_indexed_collection_to_list(struct kshark_context *kshark_ctx,
+				      struct kshark_entry_collection **col_list,
+				      struct kshark_entry **data,
+				      size_t n_rows,
+				      const uint32_t *rows, size_t n_indexed,
+				      matching_condition_func cond,
+				      int sd, int *values, size_t n_val)
+{
+	struct kshark_entry_collection *col;
+	struct cpu_col_points points = {};
+	size_t i, k;
+
+	if (!data || n_rows == 0)
+		return NULL;
+
+	col = calloc(1, sizeof(*col));
+	if (!col)
+		goto fail;
+
+	col->values = malloc(n_val * sizeof(*col->values));
+	if (n_val && !col->values)
+		goto fail;
+
+	for (k = 0; k < n_indexed; ++k) {
+		i = rows[k];
+		if (!cond(kshark_ctx, data[i], sd, values))
+			continue;
+
+		if (!points.good_data) {
+			points.good_data = true;
+			if (!CPU_COL_RESUME(&points, i))
+				goto fail;
+		} else if (data[i]->next &&
+			   !cond(kshark_ctx, data[i]->next, sd, values)) {
+			/* Break at the "next" entry, which can be anywhere. */
+			points.good_data = false;
+			i = indexed_col_find(data, n_rows, i + 1,
+					     data[i]->next);
+			if (!CPU_COL_BREAK(&points, i))
+				goto fail;
+
+			while (k + 1 < n_indexed && rows[k + 1] <= i)
+				++k;
+		}
+	}
+
+	if (points.good_data && !CPU_COL_BREAK(&points, n_rows - 1))
+		goto fail;
+
+	memcpy(col->values, values, n_val * sizeof(*col->values));
+	col->cond = cond;
+	col->n_val = n_val;
+	col->stream_id = sd;
+	col->resume_points = points.resume_points;
+	col->break_points = points.break_points;
+	col->size = points.n_resume;
+
+	col->next = *col_list;
+	*col_list = col;
+
+	return col;
+
+fail:
+	fprintf(stderr, "Failed to allocate memory for Data collection.\n");
+
+	free(points.resume_points);
+	free(points.break_points);
+	if (col)
+		free(col->values);
+
+	free(col);
+
+	return NULL;
+}
+
+/**
+ * @brief Process a data collection, visiting only a given set of rows of the
+ *	  data, and add it to the list of collections used by the session.
+ *
+ * @param kshark_ctx: Input location for the session context pointer.
+ * @param data: Input location for the trace data.
+ * @param n_rows: The size of the inputted data.
+ * @param rows: The sorted indexes of the rows to visit. All entries, which
+ *		may satisfy the Matching condition, must be among them.
+ * @param n_indexed: The size of the array of indexes.
+ * @param cond: Matching condition function for the collection to be
+ *	        registered.
+ * @param sd: Data stream identifier.
+ * @param values: Array of matching condition values for the collection to be
+ *		  registered.
+ * @param n_val: The number of matching condition values.
+ *
+ * @returns Pointer to the newly allocated collection, or NULL on failure.
+ */
+struct kshark_entry_collection *
+kshark_register_indexed_collection(struct kshark_context *kshark_ctx,
+				   struct kshark_entry **data, size_t n_rows,
+				   const uint32_t *rows, size_t n_indexed,
+				   matching_condition_func cond,
+				   int sd, int *values, size_t n_val)
+{
+	return kshark_add_indexed_collection_to_list(kshark_ctx,
+						     &kshark_ctx->collections,
+						     data, n_rows,
+						     rows, n_indexed,
+						     cond, sd, values, n_val);
+}
+// END of change
+
 /**
  * @brief Search the list of Data collections for a collection defined
  *	  with a given Matching condition function and value. If such a
@@ -0,0 +1,798 @@
+//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+/* Copyright (C) 2026, David Jaromír Šebánek <djsebofficial@gmail.com> */
+
+/**
+ *  @file    libkshark-compact.c
+ *  @brief   Compact storage of trace data, using 24 bytes per entry.
+ */
+
+// C
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// KernelShark
+#include "libkshark.h"
+#include "libkshark-tepdata.h"
+#include "libkshark-couplebreak.h"
+#include "libkshark-compact.h"
+
+_Static_assert(sizeof(struct kshark_compact_entry) == 24,
+	       "Unexpected size of the compact entry.");
+
+/** Mask of the index of an entry inside its chunk. */
+#define KS_COMPACT_CHUNK_MASK	((1UL << KS_COMPACT_CHUNK_NBITS) - 1)
+
+static inline size_t compact_chunk(size_t index)
+{
+	return index >> KS_COMPACT_CHUNK_NBITS;
+}
+
+static inline bool compact_first_in_chunk(size_t index)
+{
+	return !(index & KS_COMPACT_CHUNK_MASK);
+}
+
+static inline bool compact_ts_fits(int64_t delta)
+{
+	return delta >= 0 && delta < KS_COMPACT_NONE;
+}
+
+/**
+ * @brief Initialize an empty compact data set.
+ *
+ * @param data: Input location for the data set.
+ */
+void kshark_compact_init(struct kshark_compact_data *data)
+{
+	memset(data, 0, sizeof(*data));
+}
+
+/**
+ * @brief Free all memory used by a compact data set. The data set is left
+ *	  empty and can be used again.
+ *
+ * @param data: Input location for the data set.
+ */
+void kshark_compact_free(struct kshark_compact_data *data)
+{
+	int sd;
+
+	for (sd = 0; sd < data->n_tail_streams; ++sd)
+		free(data->cpu_tail[sd]);
+
+	free(data->cpu_tail);
+	free(data->n_tail_cpus);
+	free(data->entries);
+	free(data->ts_base);
+	free(data->ts_overflow);
+	free(data->origins);
+	kshark_compact_init(data);
+}
+
+/* Make sure that the last entry of a given CPU can be tracked. */
+static int compact_reserve_tail(struct kshark_compact_data *data,
+				int sd, int cpu)
+{
+	int *n_cpus, i;
+	uint32_t **tails, *cpu_tail;
+
+	if (sd >= data->n_tail_streams) {
+		tails = realloc(data->cpu_tail, (sd + 1) * sizeof(*tails));
+		if (!tails)
+			return -ENOMEM;
+
+		data->cpu_tail = tails;
+
+		n_cpus = realloc(data->n_tail_cpus, (sd + 1) * sizeof(*n_cpus));
+		if (!n_cpus)
+			return -ENOMEM;
+
+		data->n_tail_cpus = n_cpus;
+
+		for (i = data->n_tail_streams; i <= sd; ++i) {
+			data->cpu_tail[i] = NULL;
+			data->n_tail_cpus[i] = 0;
+		}
+
+		data->n_tail_streams = sd + 1;
+	}
+
+	if (cpu >= data->n_tail_cpus[sd]) {
+		cpu_tail = realloc(data->cpu_tail[sd],
+				   (cpu + 1) * sizeof(*cpu_tail));
+		if (!cpu_tail)
+			return -ENOMEM;
+
+		for (i = data->n_tail_cpus[sd]; i <= cpu; ++i)
+			cpu_tail[i] = KS_COMPACT_NONE;
+
+		data->cpu_tail[sd] = cpu_tail;
+		data->n_tail_cpus[sd] = cpu + 1;
+	}
+
+	return 0;
+}
+
+/* Make sure that the arrays of the data set can hold "n" more entries. */
+static int compact_reserve(struct kshark_compact_data *data, size_t n,
+			   size_t n_ts_overflow, size_t n_origins)
+{
+	struct kshark_compact_entry *entries;
+	struct kshark_compact_ts *ts_overflow;
+	size_t capacity = data->capacity;
+	uint32_t *origins;
+	int64_t *ts_base;
+
+	if (data->size + n > capacity) {
+		capacity = capacity ? 2 * capacity : KS_COMPACT_CHUNK_MASK + 1;
+		if (capacity < data->size + n)
+			capacity = data->size + n;
+
+		entries = realloc(data->entries, capacity * sizeof(*entries));
+		if (!entries)
+			return -ENOMEM;
+
+		data->entries = entries;
+
+		ts_base = realloc(data->ts_base,
+				  (compact_chunk(capacity - 1) + 1) *
+				  sizeof(*ts_base));
+		if (!ts_base)
+			return -ENOMEM;
+
+		data->ts_base = ts_base;
+		data->capacity = capacity;
+	}
+
+	if (n_ts_overflow) {
+		ts_overflow = realloc(data->ts_overflow,
+				      (data->n_ts_overflow + n_ts_overflow) *
+				      sizeof(*ts_overflow));
+		if (!ts_overflow)
+			return -ENOMEM;
+
+		data->ts_overflow = ts_overflow;
+	}
+
+	if (n_origins) {
+		origins = realloc(data->origins,
+				  (data->n_origins + n_origins) *
+				  sizeof(*origins));
+		if (!origins)
+			return -ENOMEM;
+
+		data->origins = origins;
+	}
+
+	return 0;
+}
+
+/*
+ * Get the row of an entry, pointed by another entry of the same time-sorted
+ * batch, or KS_COMPACT_NONE if the entry is not in the batch.
+ */
+static uint32_t compact_row(struct kshark_entry **rows, size_t n,
+			    const struct kshark_entry *entry)
+{
+	size_t l = 0, h = n, mid;
+
+	while (l < h) {
+		mid = l + (h - l) / 2;
+		if (rows[mid]->ts < entry->ts)
+			l = mid + 1;
+		else
+			h = mid;
+	}
+
+	for (; l < n && rows[l]->ts == entry->ts; ++l)
+		if (rows[l] == entry)
+			return l;
+
+	return KS_COMPACT_NONE;
+}
+
+/*
+ * Append the lists of the CPUs of a batch of entries to the lists already in
+ * the data set. A couplebreak wakeup stays in the list of the waker CPU, so
+ * the CPU of a list is taken from its first entry, which is not a couplebreak
+ * entry. Such entry is always there, since the origin of a couplebreak entry
+ * is in the same list.
+ */
+static void compact_link_lists(struct kshark_compact_data *data,
+			       size_t first, size_t n, const bool *linked)
+{
+	struct kshark_compact_entry *compact;
+	uint32_t *tail, last;
+	size_t i, j;
+	int cpu;
+
+	for (i = 0; i < n; ++i) {
+		if (linked[i])
+			continue;
+
+		/* The head of a list. Find its CPU and its last entry. */
+		cpu = -1;
+		for (j = first + i; j != KS_COMPACT_NONE;
+		     j = data->entries[j].next) {
+			compact = &data->entries[j];
+			if (cpu < 0 && !is_couplebreak_event(compact->event_id))
+				cpu = compact->cpu;
+
+			last = j;
+		}
+
+		compact = &data->entries[first + i];
+		if (cpu < 0)
+			cpu = compact->cpu;
+
+		if (compact->stream_id < 0 || cpu < 0)
+			continue;
+
+		tail = &data->cpu_tail[compact->stream_id][cpu];
+		if (*tail != KS_COMPACT_NONE)
+			data->entries[*tail].next = first + i;
+
+		*tail = last;
+	}
+}
+
+/**
+ * @brief Append time-sorted trace entries to a compact data set. The entries
+ *	  must not be older than the entries already in the data set. The
+ *	  inputted entries are not modified and can be freed after the call.
+ *	  The "next" links between the entries are kept. The lists of the
+ *	  CPUs, which the entries form, continue the lists already in the
+ *	  data set.
+ *
+ * @param data: Input location for the data set.
+ * @param rows: Input location for the entries to append.
+ * @param n: The number of entries to append.
+ *
+ * @returns Zero on success, or a negative error code on failure. On failure
+ *	    no entry is appended.
+ */
+int kshark_compact_append(struct kshark_compact_data *data,
+			  struct kshark_entry **rows, size_t n)
+{
+	size_t i, index, first = data->size, n_ts_overflow = 0, n_origins = 0;
+	struct kshark_compact_entry *compact;
+	struct kshark_entry *entry;
+	int64_t base = 0, origin;
+	uint32_t *links = NULL;
+	bool *linked = NULL;
+	int ret;
+
+	if (first + n >= KS_COMPACT_NONE)
+		return -EOVERFLOW;
+
+	if (!n)
+		return 0;
+
+	/* Translate the "next" pointers into rows of the batch. */
+	links = malloc(n * sizeof(*links));
+	linked = calloc(n, sizeof(*linked));
+	if (!links || !linked) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	for (i = 0; i < n; ++i) {
+		links[i] = rows[i]->next ?
+			   compact_row(rows, n, rows[i]->next) :
+			   KS_COMPACT_NONE;
+
+		if (links[i] != KS_COMPACT_NONE)
+			linked[links[i]] = true;
+	}
+
+	/*
+	 * First check the entries and count the values going into the side
+	 * tables, so that the data set can be left untouched on failure.
+	 */
+	if (first && !compact_first_in_chunk(first))
+		base = data->ts_base[compact_chunk(first)];
+
+	for (i = 0; i < n; ++i) {
+		entry = rows[i];
+		if (compact_first_in_chunk(first + i))
+			base = entry->ts;
+
+		if (!compact_ts_fits(entry->ts - base))
+			++n_ts_overflow;
+
+		if (is_couplebreak_event(entry->event_id)) {
+			++n_origins;
+		} else if (entry->offset < 0 ||
+			   entry->offset > KS_COMPACT_MAX_OFFSET) {
+			ret = -EOVERFLOW;
+			goto out;
+		}
+
+		if (entry->stream_id >= 0 && entry->cpu >= 0) {
+			ret = compact_reserve_tail(data, entry->stream_id,
+						   entry->cpu);
+			if (ret < 0)
+				goto out;
+		}
+	}
+
+	ret = compact_reserve(data, n, n_ts_overflow, n_origins);
+	if (ret < 0)
+		goto out;
+
+	for (i = 0; i < n; ++i) {
+		entry = rows[i];
+		index = first + i;
+		compact = &data->entries[index];
+
+		if (compact_first_in_chunk(index))
+			data->ts_base[compact_chunk(index)] = entry->ts;
+
+		base = data->ts_base[compact_chunk(index)];
+		if (compact_ts_fits(entry->ts - base)) {
+			compact->ts_delta = entry->ts - base;
+		} else {
+			compact->ts_delta = KS_COMPACT_NONE;
+			data->ts_overflow[data->n_ts_overflow].index = index;
+			data->ts_overflow[data->n_ts_overflow++].ts = entry->ts;
+		}
+
+		if (is_couplebreak_event(entry->event_id)) {
+			/* The origin is a pointer. Keep its index instead. */
+			origin = couplebreak_origin_index(rows, n, i);
+			data->origins[data->n_origins] =
+				(origin < 0) ? KS_COMPACT_NONE : first + origin;
+
+			compact->offset_lo = data->n_origins++;
+			compact->offset_hi = 0;
+		} else {
+			compact->offset_lo = entry->offset;
+			compact->offset_hi = entry->offset >> 32;
+		}
+
+		compact->pid = entry->pid;
+		compact->event_id = entry->event_id;
+		compact->cpu = entry->cpu;
+		compact->stream_id = entry->stream_id;
+		compact->visible = entry->visible;
+		compact->next = (links[i] == KS_COMPACT_NONE) ?
+				KS_COMPACT_NONE : first + links[i];
+	}
+
+	compact_link_lists(data, first, n, linked);
+	data->size += n;
+
+ out:
+	free(links);
+	free(linked);
+
+	return ret;
+}
+
+/**
+ * @brief Get the timestamp of an entry of a compact data set.
+ *
+ * @param data: Input location for the data set.
+ * @param index: The index of the entry.
+ */
+int64_t kshark_compact_ts(const struct kshark_compact_data *data,
+			  size_t index)
+{
+	const struct kshark_compact_entry *compact = &data->entries[index];
+	size_t l = 0, h = data->n_ts_overflow, mid;
+
+	if (compact->ts_delta != KS_COMPACT_NONE)
+		return data->ts_base[compact_chunk(index)] + compact->ts_delta;
+
+	/* The side table is sorted by index. */
+	while (h - l > 1) {
+		mid = (l + h) / 2;
+		if (data->ts_overflow[mid].index <= index)
+			l = mid;
+		else
+			h = mid;
+	}
+
+	return data->ts_overflow[l].ts;
+}
+
+/**
+ * @brief Get the index of the next (in time) entry in the list of the same
+ *	  CPU core, as the "next" field of kshark_entry.
+ *
+ * @param data: Input location for the data set.
+ * @param index: The index of the entry.
+ *
+ * @returns The index of the next entry, or -1 if there is no such entry.
+ */
+ssize_t kshark_compact_next(const struct kshark_compact_data *data,
+			    size_t index)
+{
+	uint32_t next = data->entries[index].next;
+
+	return (next == KS_COMPACT_NONE) ? -1 : (ssize_t) next;
+}
+
+/**
+ * @brief Get the index of the origin of a couplebreak entry.
+ *
+ * @param data: Input location for the data set.
+ * @param index: The index of the entry.
+ *
+ * @returns The index of the origin, or -1 if the entry is not a couplebreak
+ *	    entry or if its origin is unknown.
+ */
+ssize_t kshark_compact_origin(const struct kshark_compact_data *data,
+			      size_t index)
+{
+	const struct kshark_compact_entry *compact = &data->entries[index];
+	uint32_t origin;
+
+	if (!is_couplebreak_event(compact->event_id))
+		return -1;
+
+	origin = data->origins[compact->offset_lo];
+
+	return (origin == KS_COMPACT_NONE) ? -1 : (ssize_t) origin;
+}
+
+/**
+ * @brief Get the offset into the trace file of an entry of a compact data
+ *	  set. For couplebreak entries, this is the offset of the origin.
+ *
+ * @param data: Input location for the data set.
+ * @param index: The index of the entry.
+ *
+ * @returns The offset, or -1 for a couplebreak entry with unknown origin.
+ */
+int64_t kshark_compact_offset(const struct kshark_compact_data *data,
+			      size_t index)
+{
+	const struct kshark_compact_entry *compact = &data->entries[index];
+	ssize_t origin;
+
+	if (is_couplebreak_event(compact->event_id)) {
+		origin = kshark_compact_origin(data, index);
+		if (origin < 0)
+			return -1;
+
+		compact = &data->entries[origin];
+	}
+
+	return ((int64_t) compact->offset_hi << 32) | compact->offset_lo;
+}
+
+/**
+ * @brief Get a copy of an entry of a compact data set. The copy is not
+ *	  linked to other entries. Its "next" field is NULL and for
+ *	  couplebreak entries, the "offset" (pointer to the origin) is zero.
+ *	  Use kshark_compact_materialize() if the links are needed.
+ *
+ * @param data: Input location for the data set.
+ * @param index: The index of the entry.
+ * @param entry: Output location for the copy of the entry.
+ */
+void kshark_compact_get_entry(const struct kshark_compact_data *data,
+			      size_t index, struct kshark_entry *entry)
+{
+	const struct kshark_compact_entry *compact = &data->entries[index];
+
+	entry->next = NULL;
+	entry->visible = compact->visible;
+	entry->stream_id = compact->stream_id;
+	entry->event_id = compact->event_id;
+	entry->cpu = compact->cpu;
+	entry->pid = compact->pid;
+	entry->ts = kshark_compact_ts(data, index);
+
+	if (is_couplebreak_event(compact->event_id))
+		entry->offset = 0;
+	else
+		entry->offset = ((int64_t) compact->offset_hi << 32) |
+				compact->offset_lo;
+}
+
+static inline bool in_range(ssize_t index, size_t first, size_t n)
+{
+	return index >= (ssize_t) first && index < (ssize_t) (first + n);
+}
+
+/**
+ * @brief Materialize a range of entries of a compact data set as an array
+ *	  of kshark_entries. The "next" links, pointing inside the range, and
+ *	  the origins of the couplebreak entries are restored. Origins outside
+ *	  of the range are materialized as well, but are not part of the
+ *	  outputted array.
+ *
+ * @param data: Input location for the data set.
+ * @param first: The index of the first entry of the range.
+ * @param n: The number of entries in the range.
+ * @param rows: Output location for the array of entries. The user is
+ *		responsible for freeing it via kshark_compact_free_rows().
+ *
+ * @returns The number of entries in the outputted array, or a negative error
+ *	    code on failure.
+ */
+ssize_t kshark_compact_materialize(const struct kshark_compact_data *data,
+				   size_t first, size_t n,
+				   struct kshark_entry ***rows)
+{
+	struct kshark_entry *entries, **out;
+	size_t i, n_extra = 0, extra;
+	ssize_t next, origin;
+
+	*rows = NULL;
+	if (first > data->size || n > data->size - first)
+		return -EINVAL;
+
+	if (!n)
+		return 0;
+
+	for (i = first; i < first + n; ++i) {
+		origin = kshark_compact_origin(data, i);
+		if (origin >= 0 && !in_range(origin, first, n))
+			++n_extra;
+	}
+
+	entries = malloc((n + n_extra) * sizeof(*entries));
+	out = malloc(n * sizeof(*out));
+	if (!entries || !out) {
+		free(entries);
+		free(out);
+		fprintf(stderr, "Failed to allocate memory for entries.\n");
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < n; ++i) {
+		kshark_compact_get_entry(data, first + i, &entries[i]);
+		out[i] = &entries[i];
+	}
+
+	extra = n;
+	for (i = 0; i < n; ++i) {
+		next = kshark_compact_next(data, first + i);
+		if (in_range(next, first, n))
+			entries[i].next = &entries[next - first];
+
+		origin = kshark_compact_origin(data, first + i);
+		if (origin < 0)
+			continue;
+
+		if (in_range(origin, first, n)) {
+			entries[i].offset = (int64_t) &entries[origin - first];
+		} else {
+			kshark_compact_get_entry(data, origin, &entries[extra]);
+			entries[i].offset = (int64_t) &entries[extra++];
+		}
+	}
+
+	*rows = out;
+
+	return n;
+}
+
+/**
+ * @brief Free an array of entries, outputted by kshark_compact_materialize().
+ *
+ * @param rows: Input location for the array of entries.
+ */
+void kshark_compact_free_rows(struct kshark_entry **rows)
+{
+	if (!rows)
+		return;
+
+	/* All entries share the memory of the first one. */
+	free(rows[0]);
+	free(rows);
+}
+
+/**
+ * @brief Fill columns with the data of a compact data set (see
+ *	  kshark_entry_columns_fill()).
+ *
+ * @param data: Input location for the data set.
+ * @param columns: Input location for the columns. Must be initialized
+ *		   with zeros before the first use.
+ *
+ * @returns True on success. Else false, in which case the columns are empty.
+ */
+bool kshark_compact_columns(const struct kshark_compact_data *data,
+			    struct kshark_entry_columns *columns)
+{
+	const struct kshark_compact_entry *compact;
+	size_t i;
+
+	if (!kshark_entry_columns_alloc(columns, data->size))
+		return false;
+
+	for (i = 0; i < data->size; ++i) {
+		compact = &data->entries[i];
+		columns->ts[i] = kshark_compact_ts(data, i);
+		columns->pid[i] = compact->pid;
+		columns->stream_id[i] = compact->stream_id;
+		columns->cpu[i] = compact->cpu;
+		columns->event_id[i] = compact->event_id;
+	}
+
+	//NOTE: Changed here. (TIME GRID) (2026-10-17)
+	kshark_ts_grid_build(&columns->grid, columns->ts, data->size);
+	// END of change
+
+	return true;
+}
+
+/**
+ * @brief Set the visibility of the entries of a compact data set according
+ *	  to the Id filters of the session's context (see
+ *	  kshark_filter_stream_entries()).
+ *
+ * @param kshark_ctx: Input location for the session context pointer.
+ * @param sd: Data stream identifier. Use a negative value for all streams.
+ * @param data: Input location for the data set.
+ */
+void kshark_compact_filter(struct kshark_context *kshark_ctx, int sd,
+			   struct kshark_compact_data *data)
+{
+	struct kshark_data_stream *stream = NULL;
+	struct kshark_compact_entry *compact;
+	struct kshark_entry entry;
+	size_t i;
+
+	if (sd >= 0) {
+		stream = kshark_get_data_stream(kshark_ctx, sd);
+		if (!stream)
+			return;
+
+		if (kshark_is_tep(stream) && kshark_tep_filter_is_set(stream)) {
+			fprintf(stderr, "Failed to filter (sd = %i)!\n", sd);
+			fprintf(stderr,
+				"Reset the Advanced filter or reload the data.\n");
+			return;
+		}
+	}
+
+	//NOTE: Changed here. (ID SETS) (2026-10-17)
+	kshark_update_filter_sets(kshark_ctx, sd);
+	// END of change
+
+	for (i = 0; i < data->size; ++i) {
+		compact = &data->entries[i];
+		if (sd >= 0 && compact->stream_id != sd)
+			continue;
+
+		if (sd < 0) {
+			stream = kshark_get_data_stream(kshark_ctx,
+							compact->stream_id);
+			if (!stream)
+				continue;
+		}
+
+		/* The filters only use the Ids of the entry. */
+		entry.event_id = compact->event_id;
+		entry.cpu = compact->cpu;
+		entry.pid = compact->pid;
+
+		/* Keep the original value of the PLUGIN_UNTOUCHED bit flag. */
+		entry.visible = compact->visible |
+				(0xFF & ~KS_PLUGIN_UNTOUCHED_MASK);
+
+		kshark_apply_filters(kshark_ctx, stream, &entry);
+		compact->visible = entry.visible;
+	}
+
+	if (sd >= 0)
+		stream->filter_is_applied = kshark_filter_is_set(kshark_ctx, sd);
+}
+
+/** State of the loading of a Data stream into a compact data set. */
+struct compact_load {
+	/** The data set. */
+	struct kshark_compact_data	*data;
+
+	/** Zero, or the error code of the first failed append. */
+	int				ret;
+};
+
+static void compact_load_batch(__attribute__ ((unused)) struct kshark_data_stream *stream,
+			       struct kshark_entry **batch,
+			       ssize_t n_entries,
+			       __attribute__ ((unused)) const struct kshark_load_progress *progress,
+			       void *data)
+{
+	struct compact_load *load = data;
+
+	if (!load->ret)
+		load->ret = kshark_compact_append(load->data, batch, n_entries);
+}
+
+/* Drop the entries appended after the data set had "size" entries. */
+static void compact_truncate(struct kshark_compact_data *data, int sd,
+			     size_t size, size_t n_ts_overflow,
+			     size_t n_origins, const uint32_t *tails,
+			     int n_tails)
+{
+	uint32_t tail;
+	int cpu;
+
+	data->size = size;
+	data->n_ts_overflow = n_ts_overflow;
+	data->n_origins = n_origins;
+
+	if (sd >= data->n_tail_streams)
+		return;
+
+	for (cpu = 0; cpu < data->n_tail_cpus[sd]; ++cpu) {
+		tail = (cpu < n_tails) ? tails[cpu] : KS_COMPACT_NONE;
+		data->cpu_tail[sd][cpu] = tail;
+		if (tail != KS_COMPACT_NONE)
+			data->entries[tail].next = KS_COMPACT_NONE;
+	}
+}
+
+/**
+ * @brief Load the content of the trace data file asociated with a given
+ *	  Data stream and append it to a compact data set. The stream is
+ *	  loaded in time windows (see kshark_load_entries_progressive()) and
+ *	  the full kshark_entries of each window are released, once they are
+ *	  appended. The entries of the stream must not be older than the
+ *	  entries already in the data set.
+ *
+ * @note The event-specific plugin actions are not run, because the plugins
+ *	 may keep pointers to the released entries.
+ *
+ * @param kshark_ctx: Input location for context pointer.
+ * @param sd: Data stream identifier.
+ * @param data: Input location for the data set.
+ *
+ * @returns The number of appended entries in the case of success, or a
+ *	    negative error code on failure. On failure the data set is left
+ *	    unchanged.
+ */
+ssize_t kshark_load_compact_entries(struct kshark_context *kshark_ctx, int sd,
+				    struct kshark_compact_data *data)
+{
+	struct kshark_data_stream *stream =
+		kshark_get_data_stream(kshark_ctx, sd);
+	size_t size = data->size, n_ts_overflow = data->n_ts_overflow;
+	struct compact_load load = {.data = data};
+	size_t n_origins = data->n_origins;
+	uint32_t *tails = NULL;
+	int n_tails = 0;
+	ssize_t ret;
+
+	if (!stream)
+		return -EFAULT;
+
+	/* Remember the last entries of the stream, in case of failure. */
+	if (sd < data->n_tail_streams && data->n_tail_cpus[sd]) {
+		n_tails = data->n_tail_cpus[sd];
+		tails = malloc(n_tails * sizeof(*tails));
+		if (!tails)
+			return -ENOMEM;
+
+		memcpy(tails, data->cpu_tail[sd], n_tails * sizeof(*tails));
+	}
+
+	ret = kshark_load_entries_progressive(kshark_ctx, sd,
+					      compact_load_batch, &load,
+					      NULL);
+	if (ret >= 0)
+		ret = load.ret;
+
+	if (ret >= 0 && kshark_is_tep(stream) && stream->couplebreak_on)
+		ret = kshark_tep_compact_couplebreak_cpus(data, size);
+
+	if (ret < 0) {
+		compact_truncate(data, sd, size, n_ts_overflow, n_origins,
+				 tails, n_tails);
+	} else {
+		ret = data->size - size;
+	}
+
+	free(tails);
+
+	return ret;
+}
+// END of change
@@ -0,0 +1,162 @@
+//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+/* Copyright (C) 2026, David Jaromír Šebánek <djsebofficial@gmail.com> */
+
+/**
+ *  @file    libkshark-compact.h
+ *  @brief   Compact storage of trace data, using 24 bytes per entry.
+ */
+
+#ifndef _LIB_KSHARK_COMPACT_H
+#define _LIB_KSHARK_COMPACT_H
+
+// KernelShark
+#include "libkshark.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Index value used when there is no such entry (e.g. no next entry). */
+#define KS_COMPACT_NONE		UINT32_MAX
+
+/**
+ * The entries are grouped in chunks of (1 << KS_COMPACT_CHUNK_NBITS)
+ * consecutive entries. The timestamps of the entries of a chunk are stored
+ * as deltas from a base, common for the chunk.
+ */
+#define KS_COMPACT_CHUNK_NBITS	10
+
+/** The biggest record offset a compact entry can hold (40 bits). */
+#define KS_COMPACT_MAX_OFFSET	((INT64_C(1) << 40) - 1)
+
+/**
+ * Compact version of kshark_entry. The entry is stored in an array of entries
+ * (struct kshark_compact_data) and is identified by its index in this array.
+ */
+struct kshark_compact_entry {
+	/**
+	 * Index of the next (in time) entry in the list of the same CPU
+	 * core (as "next" of kshark_entry), or KS_COMPACT_NONE.
+	 */
+	uint32_t	next;
+
+	/**
+	 * Timestamp, relative to the base of the chunk. KS_COMPACT_NONE if
+	 * the delta does not fit. The timestamp is then stored in a side
+	 * table.
+	 */
+	uint32_t	ts_delta;
+
+	/**
+	 * Lower 32 bits of the offset into the trace file. For couplebreak
+	 * entries, this is the position of the origin in a side table.
+	 */
+	uint32_t	offset_lo;
+
+	/** The PID of the task the record was generated. */
+	int32_t		pid;
+
+	/** Unique Id of the trace event type. */
+	int16_t		event_id;
+
+	/** The CPU core of the record. */
+	int16_t		cpu;
+
+	/** Data stream identifier. */
+	int16_t		stream_id;
+
+	/** A bit mask controlling the visibility of the entry. */
+	uint8_t		visible;
+
+	/** Upper 8 bits of the offset into the trace file. */
+	uint8_t		offset_hi;
+};
+
+/** Timestamp, which does not fit into the delta of a compact entry. */
+struct kshark_compact_ts {
+	/** Index of the entry. */
+	uint32_t	index;
+
+	/** The timestamp of the entry. */
+	int64_t		ts;
+};
+
+/** Time-sorted array of compact entries, together with its side tables. */
+struct kshark_compact_data {
+	/** Array of entries. */
+	struct kshark_compact_entry	*entries;
+
+	/** The number of entries. */
+	size_t				size;
+
+	/** The number of entries the array can hold. */
+	size_t				capacity;
+
+	/** Timestamp base of each chunk. */
+	int64_t				*ts_base;
+
+	/** Side table of the timestamps not fitting into a delta. */
+	struct kshark_compact_ts	*ts_overflow;
+
+	/** The number of timestamps in the side table. */
+	size_t				n_ts_overflow;
+
+	/** Side table of the indexes of the origins of couplebreak entries. */
+	uint32_t			*origins;
+
+	/** The number of origins in the side table. */
+	size_t				n_origins;
+
+	/** Index of the last entry on each CPU of each Data stream. */
+	uint32_t			**cpu_tail;
+
+	/** The number of CPUs in "cpu_tail" for each Data stream. */
+	int				*n_tail_cpus;
+
+	/** The number of Data streams in "cpu_tail". */
+	int				n_tail_streams;
+};
+
+void kshark_compact_init(struct kshark_compact_data *data);
+
+void kshark_compact_free(struct kshark_compact_data *data);
+
+int kshark_compact_append(struct kshark_compact_data *data,
+			  struct kshark_entry **rows, size_t n);
+
+int64_t kshark_compact_ts(const struct kshark_compact_data *data,
+			  size_t index);
+
+ssize_t kshark_compact_next(const struct kshark_compact_data *data,
+			    size_t index);
+
+ssize_t kshark_compact_origin(const struct kshark_compact_data *data,
+			      size_t index);
+
+int64_t kshark_compact_offset(const struct kshark_compact_data *data,
+			      size_t index);
+
+void kshark_compact_get_entry(const struct kshark_compact_data *data,
+			      size_t index, struct kshark_entry *entry);
+
+ssize_t kshark_compact_materialize(const struct kshark_compact_data *data,
+				   size_t first, size_t n,
+				   struct kshark_entry ***rows);
+
+void kshark_compact_free_rows(struct kshark_entry **rows);
+
+bool kshark_compact_columns(const struct kshark_compact_data *data,
+			    struct kshark_entry_columns *columns);
+
+void kshark_compact_filter(struct kshark_context *kshark_ctx, int sd,
+			   struct kshark_compact_data *data);
+
+ssize_t kshark_load_compact_entries(struct kshark_context *kshark_ctx, int sd,
+				    struct kshark_compact_data *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _LIB_KSHARK_COMPACT_H
+// END of change
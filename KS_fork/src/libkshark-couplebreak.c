@@ -153,3 +153,37 @@ struct kshark_entry* couplebreak_get_origin(const struct kshark_entry *entry) {
 	return origin_entry;
 }
 // END of change
+
+//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+/**
+ * @brief Find the origin of a couplebreak entry in a time-sorted array of
+ * entries. The origin has the same timestamp and is stored close to the
+ * couplebreak entry, hence only the neighbours with equal timestamps
+ * are checked.
+ *
+ * @param rows Time-sorted array of entries.
+ * @param n_rows The size of the array.
+ * @param i Index of the couplebreak entry.
+ * @return Index of the origin entry or -1 if it is not in the array.
+ */
+ssize_t couplebreak_origin_index(struct kshark_entry **rows, ssize_t n_rows,
+				 ssize_t i)
+{
+	struct kshark_entry *origin = couplebreak_get_origin(rows[i]);
+	ssize_t d;
+
+	for (d = 1; i - d >= 0 || i + d < n_rows; ++d) {
+		if (i - d >= 0 && rows[i - d] == origin)
+			return i - d;
+
+		if (i + d < n_rows && rows[i + d] == origin)
+			return i + d;
+
+		if ((i - d < 0 || rows[i - d]->ts != rows[i]->ts) &&
+		    (i + d >= n_rows || rows[i + d]->ts != rows[i]->ts))
+			break;
+	}
+
+	return -1;
+}
+// END of change
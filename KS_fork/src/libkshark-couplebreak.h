@@ -38,6 +38,10 @@ int couplebreak_id_to_flag_pos(int event_id);
 int flag_pos_to_couplebreak_id(int flag_pos);
 bool is_couplebreak_event(int event_id);
 char *get_couplebreak_event_name(int event_id);
+//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+ssize_t couplebreak_origin_index(struct kshark_entry **rows, ssize_t n_rows,
+				 ssize_t i);
+// END of change
 
 #ifdef __cplusplus
 }
@@ -14,6 +14,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+//NOTE: Changed here. (ID SETS) (2026-10-17)
+#include <string.h>
+// END of change
 
 // KernelShark
 #include "libkshark.h"
@@ -133,6 +136,9 @@ int kshark_hash_id_add(struct kshark_hash_id *hash, int id)
 	item->next = hash->hash[key];
 	hash->hash[key] = item;
 	hash->count++;
+	//NOTE: Changed here. (ID SETS) (2026-10-17)
+	hash->version++;
+	// END of change
 
 	return 1;
 }
@@ -158,6 +164,9 @@ void kshark_hash_id_remove(struct kshark_hash_id *hash, int id)
 	assert(hash->count);
 
 	hash->count--;
+	//NOTE: Changed here. (ID SETS) (2026-10-17)
+	hash->version++;
+	// END of change
 	item = *next;
 	*next = item->next;
 
@@ -188,6 +197,9 @@ void kshark_hash_id_clear(struct kshark_hash_id *hash)
 	}
 
 	hash->count = 0;
+	//NOTE: Changed here. (ID SETS) (2026-10-17)
+	hash->version++;
+	// END of change
 }
 
 static int compare_ids(const void* a, const void* b)
@@ -236,3 +248,92 @@ int *kshark_hash_ids(struct kshark_hash_id *hash)
 
 	return ids;
 }
+
+//NOTE: Changed here. (ID SETS) (2026-10-17)
+/**
+ * @brief Build a set of Ids, containing the same Ids as a hash table.
+ *	  If the Ids are within a narrow range, the set is a bitmap.
+ *	  Otherwise it is an open addressing hash table.
+ *
+ * @param set: Output location for the set. The previous content of the set
+ *	       is released.
+ * @param hash: The hash table. NULL is the same as an empty hash table.
+ *
+ * @returns Zero on success, -EINVAL if the hash table holds the Id
+ *	    KS_ID_SET_EMPTY and the Ids are sparse, or -ENOMEM on failure.
+ *	    The set is empty on failure.
+ */
+int kshark_id_set_build(struct kshark_id_set *set, struct kshark_hash_id *hash)
+{
+	size_t i, size, slot, n_words;
+	int64_t range;
+	int *ids;
+
+	kshark_id_set_free(set);
+
+	if (!hash || !hash->count)
+		return 0;
+
+	ids = kshark_hash_ids(hash);
+	if (!ids)
+		return -ENOMEM;
+
+	range = (int64_t) ids[hash->count - 1] - ids[0] + 1;
+	if (range <= KS_ID_SET_DENSE_MAX) {
+		n_words = (range + 63) / 64;
+		set->bits = calloc(n_words, sizeof(*set->bits));
+		if (!set->bits)
+			goto fail;
+
+		set->min = ids[0];
+		set->n_bits = range;
+		for (i = 0; i < hash->count; ++i)
+			set->bits[(ids[i] - set->min) / 64] |=
+				UINT64_C(1) << ((ids[i] - set->min) % 64);
+	} else {
+		if (ids[0] == KS_ID_SET_EMPTY) {
+			/* This value marks the empty slots. */
+			free(ids);
+			return -EINVAL;
+		}
+
+		/* Keep the load factor under 1/2. */
+		for (size = 16; size < hash->count * 2; size *= 2)
+			;
+
+		set->slots = malloc(size * sizeof(*set->slots));
+		if (!set->slots)
+			goto fail;
+
+		set->mask = size - 1;
+		for (i = 0; i < size; ++i)
+			set->slots[i] = KS_ID_SET_EMPTY;
+
+		for (i = 0; i < hash->count; ++i) {
+			slot = kshark_id_set_slot(set, ids[i]);
+			while (set->slots[slot] != KS_ID_SET_EMPTY)
+				slot = (slot + 1) & set->mask;
+
+			set->slots[slot] = ids[i];
+		}
+	}
+
+	set->count = hash->count;
+	free(ids);
+
+	return 0;
+
+ fail:
+	fprintf(stderr, "Failed to allocate memory for Id set.\n");
+	free(ids);
+	return -ENOMEM;
+}
+
+/** Release the memory of a set of Ids. The set becomes empty. */
+void kshark_id_set_free(struct kshark_id_set *set)
+{
+	free(set->bits);
+	free(set->slots);
+	memset(set, 0, sizeof(*set));
+}
+// END of change
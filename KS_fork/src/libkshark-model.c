@@ -27,6 +27,35 @@
 /** For all bins. */
 # define ALLB(histo) LOB(histo)
 
+//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+/* Get the timestamp of a given row of the trace data. */
+static inline int64_t ksmodel_ts(const struct kshark_trace_histo *histo,
+				 size_t row)
+{
+	if (histo->columns)
+		return histo->columns->ts[row];
+
+	return histo->data[row]->ts;
+}
+
+/*
+ * Binary search for the first row of the trace data having timestamp equal
+ * or bigger than "time". Same as kshark_find_entry_by_time(), but uses the
+ * timestamp column and its time grid, if available.
+ */
+static ssize_t ksmodel_find_row(const struct kshark_trace_histo *histo,
+				int64_t time, size_t l, size_t h)
+{
+	//NOTE: Changed here. (TIME GRID) (2026-10-17)
+	if (histo->columns)
+		return kshark_find_ts_by_grid(time, histo->columns->ts,
+					      &histo->columns->grid, l, h);
+	// END of change
+
+	return kshark_find_entry_by_time(time, histo->data, l, h);
+}
+// END of change
+
 /**
  * @brief Initialize the Visualization model.
  *
@@ -95,7 +124,9 @@ static void ksmodel_set_in_range_bining(struct kshark_trace_histo *histo,
 					bool force_in_range)
 {
 	int64_t corrected_range, delta_range, range = max - min;
-	struct kshark_entry *last;
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	int64_t first_ts, last_ts;
+	// END of change
 
 	if (n <= 0) {
 		histo->n_bins = histo->bin_size = 0;
@@ -155,14 +186,17 @@ static void ksmodel_set_in_range_bining(struct kshark_trace_histo *histo,
 		 * Make sure that the new range doesn't go outside of the time
 		 * interval of the dataset.
 		 */
-		last = histo->data[histo->data_size - 1];
-		if (histo->min < histo->data[0]->ts) {
-			histo->min = histo->data[0]->ts;
+		//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+		first_ts = ksmodel_ts(histo, 0);
+		last_ts = ksmodel_ts(histo, histo->data_size - 1);
+		if (histo->min < first_ts) {
+			histo->min = first_ts;
 			histo->max = histo->min + corrected_range;
-		} else if (histo->max > last->ts) {
-			histo->max = last->ts;
+		} else if (histo->max > last_ts) {
+			histo->max = last_ts;
 			histo->min = histo->max - corrected_range;
 		}
+		// END of change
 	}
 }
 
@@ -187,10 +221,10 @@ static size_t ksmodel_set_lower_edge(struct kshark_trace_histo *histo)
 	 * (timestamp >= min). Note that the value of "min" is considered
 	 * inside the range.
 	 */
-	ssize_t row = kshark_find_entry_by_time(histo->min,
-						histo->data,
-						0,
-						histo->data_size - 1);
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	ssize_t row = ksmodel_find_row(histo, histo->min,
+				       0, histo->data_size - 1);
+	// END of change
 
 	assert(row != BSEARCH_ALL_SMALLER);
 
@@ -220,7 +254,9 @@ static size_t ksmodel_set_lower_edge(struct kshark_trace_histo *histo)
 	 * Now check if the first entry inside the range falls into the first
 	 * bin.
 	 */
-	if (histo->data[row]->ts < histo->min + histo->bin_size) {
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	if (ksmodel_ts(histo, row) < histo->min + histo->bin_size) {
+	// END of change
 		/*
 		 * It is inside the first bin. Set the beginning
 		 * of the first bin.
@@ -242,10 +278,10 @@ static size_t ksmodel_set_upper_edge(struct kshark_trace_histo *histo)
 	 * the range. Remember that kshark_find_entry_by_time returns the first
 	 * entry which is equal or greater than the reference time.
 	 */
-	ssize_t row = kshark_find_entry_by_time(histo->max + 1,
-						histo->data,
-						0,
-						histo->data_size - 1);
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	ssize_t row = ksmodel_find_row(histo, histo->max + 1,
+				       0, histo->data_size - 1);
+	// END of change
 
 	assert(row != BSEARCH_ALL_GREATER);
 
@@ -289,10 +325,12 @@ static void ksmodel_set_next_bin_edge(struct kshark_trace_histo *histo,
 	 * Find the index of the first entry inside
 	 * the next bin (timestamp > time_min).
 	 */
-	row = kshark_find_entry_by_time(time_min, histo->data, last_row,
-					histo->data_size - 1);
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	row = ksmodel_find_row(histo, time_min, last_row,
+			       histo->data_size - 1);
 
-	if (row < 0 || histo->data[row]->ts >= time_max) {
+	if (row < 0 || ksmodel_ts(histo, row) >= time_max) {
+	// END of change
 		/* The bin is empty. */
 		histo->map[next_bin] = KS_EMPTY_BIN;
 		return;
@@ -382,23 +420,13 @@ static void ksmodel_set_bin_counts(struct kshark_trace_histo *histo)
 	histo->tot_count += histo->bin_count[prev_not_empty] = count_tmp;
 }
 
-/**
- * @brief Provide the Visualization model with data. Calculate the current
- *	  state of the model.
- *
- * @param histo: Input location for the model descriptor.
- * @param data: Input location for the trace data.
- * @param n: Number of bins.
- */
-void ksmodel_fill(struct kshark_trace_histo *histo,
-		  struct kshark_entry **data, size_t n)
+//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+/* Recalculate the state of the model, using the data it already has. */
+static void ksmodel_refill(struct kshark_trace_histo *histo)
 {
 	size_t last_row = 0;
 	int bin;
 
-	histo->data_size = n;
-	histo->data = data;
-
 	if (histo->n_bins == 0 ||
 	    histo->bin_size == 0 ||
 	    histo->data_size == 0) {
@@ -434,6 +462,49 @@ void ksmodel_fill(struct kshark_trace_histo *histo,
 	ksmodel_set_bin_counts(histo);
 }
 
+/**
+ * @brief Provide the Visualization model with data. Calculate the current
+ *	  state of the model. If the model has columns (see
+ *	  ksmodel_fill_columns()), they are kept only if the data is the same
+ *	  as the one the model already has.
+ *
+ * @param histo: Input location for the model descriptor.
+ * @param data: Input location for the trace data.
+ * @param n: Number of bins.
+ */
+void ksmodel_fill(struct kshark_trace_histo *histo,
+		  struct kshark_entry **data, size_t n)
+{
+	if (data != histo->data || n != histo->data_size)
+		histo->columns = NULL;
+
+	histo->data_size = n;
+	histo->data = data;
+	ksmodel_refill(histo);
+}
+
+/**
+ * @brief Provide the Visualization model with data and with a columnar copy
+ *	  of this data. Calculate the current state of the model. The bining
+ *	  reads only the timestamp column. The columns must stay valid (and
+ *	  in sync with the data) as long as the model uses them.
+ *
+ * @param histo: Input location for the model descriptor.
+ * @param data: Input location for the trace data.
+ * @param columns: Input location for the columns, filled with the same data
+ *		   (see kshark_entry_columns_fill()).
+ */
+void ksmodel_fill_columns(struct kshark_trace_histo *histo,
+			  struct kshark_entry **data,
+			  const struct kshark_entry_columns *columns)
+{
+	histo->data_size = columns->size;
+	histo->data = data;
+	histo->columns = columns->size ? columns : NULL;
+	ksmodel_refill(histo);
+}
+// END of change
+
 /**
  * @brief Get the total number of entries in a given bin.
  *
@@ -491,7 +562,9 @@ void ksmodel_shift_forward(struct kshark_trace_histo *histo, int n)
 		ksmodel_set_bining(histo, histo->n_bins, histo->min,
 							 histo->max);
 
-		ksmodel_fill(histo, histo->data, histo->data_size);
+		//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+		ksmodel_refill(histo);
+		// END of change
 		return;
 	}
 
@@ -569,7 +642,9 @@ void ksmodel_shift_backward(struct kshark_trace_histo *histo, int n)
 		ksmodel_set_bining(histo, histo->n_bins, histo->min,
 							 histo->max);
 
-		ksmodel_fill(histo, histo->data, histo->data_size);
+		//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+		ksmodel_refill(histo);
+		// END of change
 		return;
 	}
 
@@ -629,11 +704,13 @@ void ksmodel_jump_to(struct kshark_trace_histo *histo, int64_t ts)
 	min = ts - histo->n_bins * histo->bin_size / 2;
 
 	/* Make sure that the range does not go outside of the dataset. */
-	if (min < histo->data[0]->ts) {
-		min = histo->data[0]->ts;
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	if (min < ksmodel_ts(histo, 0)) {
+		min = ksmodel_ts(histo, 0);
 	} else {
-		range_min = histo->data[histo->data_size - 1]->ts -
+		range_min = ksmodel_ts(histo, histo->data_size - 1) -
 			    histo->n_bins * histo->bin_size;
+	// END of change
 
 		if (min > range_min)
 			min = range_min;
@@ -643,7 +720,9 @@ void ksmodel_jump_to(struct kshark_trace_histo *histo, int64_t ts)
 
 	/* Use the new range to recalculate all bins from scratch. */
 	ksmodel_set_bining(histo, histo->n_bins, min, max);
-	ksmodel_fill(histo, histo->data, histo->data_size);
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	ksmodel_refill(histo);
+	// END of change
 }
 
 static void ksmodel_zoom(struct kshark_trace_histo *histo,
@@ -697,11 +776,13 @@ static void ksmodel_zoom(struct kshark_trace_histo *histo,
 
 
 	/* Make sure the new range doesn't go outside of the dataset. */
-	if (min < histo->data[0]->ts)
-		min = histo->data[0]->ts;
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	if (min < ksmodel_ts(histo, 0))
+		min = ksmodel_ts(histo, 0);
 
-	if (max > histo->data[histo->data_size - 1]->ts)
-		max = histo->data[histo->data_size - 1]->ts;
+	if (max > ksmodel_ts(histo, histo->data_size - 1))
+		max = ksmodel_ts(histo, histo->data_size - 1);
+	// END of change
 
 	/*
 	 * Use the new range to recalculate all bins from scratch. Enforce
@@ -710,7 +791,9 @@ static void ksmodel_zoom(struct kshark_trace_histo *histo,
 	 * first or the very last entry is used as a focal point.
 	 */
 	ksmodel_set_in_range_bining(histo, histo->n_bins, min, max, true);
-	ksmodel_fill(histo, histo->data, histo->data_size);
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	ksmodel_refill(histo);
+	// END of change
 }
 
 /**
@@ -793,45 +876,58 @@ static bool ksmodel_is_visible(struct kshark_entry *e)
 	return false;
 }
 
-static struct kshark_entry_request *
-ksmodel_entry_front_request_alloc(struct kshark_trace_histo *histo,
-				  int bin, bool vis_only,
-				  matching_condition_func func,
-				  int sd, int *values)
+//NOTE: Changed here. (BIN BATCH) (2026-10-17)
+/*
+ * The first request of a search is kept on the stack of the caller. Only the
+ * additional requests, created when searching through a Data collection, are
+ * allocated (and freed with kshark_free_entry_request(req->next)).
+ */
+static bool ksmodel_entry_request_init(struct kshark_entry_request *req,
+				       size_t first, size_t n, bool vis_only,
+				       matching_condition_func func,
+				       int sd, int *values)
 {
-	size_t first, n;
-
-	/* Get the number of entries in this bin. */
-	n = ksmodel_bin_count(histo, bin);
 	if (!n)
-		return NULL;
+		return false;
 
-	first = ksmodel_first_index_at_bin(histo, bin);
+	req->next = NULL;
+	req->first = first;
+	req->n = n;
+	req->cond = func;
+	req->sd = sd;
+	req->values = values;
+	req->vis_only = vis_only;
+	req->vis_mask = KS_GRAPH_VIEW_FILTER_MASK;
 
-	return kshark_entry_request_alloc(first, n,
-					  func, sd, values,
-					  vis_only, KS_GRAPH_VIEW_FILTER_MASK);
+	return true;
 }
 
-static struct kshark_entry_request *
-ksmodel_entry_back_request_alloc(struct kshark_trace_histo *histo,
+static bool
+ksmodel_entry_front_request_init(struct kshark_trace_histo *histo,
 				 int bin, bool vis_only,
 				 matching_condition_func func,
-				 int sd, int *values)
+				 int sd, int *values,
+				 struct kshark_entry_request *req)
 {
-	size_t first, n;
-
-	/* Get the number of entries in this bin. */
-	n = ksmodel_bin_count(histo, bin);
-	if (!n)
-		return NULL;
-
-	first = ksmodel_last_index_at_bin(histo, bin);
+	return ksmodel_entry_request_init(req,
+					  ksmodel_first_index_at_bin(histo, bin),
+					  ksmodel_bin_count(histo, bin),
+					  vis_only, func, sd, values);
+}
 
-	return kshark_entry_request_alloc(first, n,
-					  func, sd, values,
-					  vis_only, KS_GRAPH_VIEW_FILTER_MASK);
+static bool
+ksmodel_entry_back_request_init(struct kshark_trace_histo *histo,
+				int bin, bool vis_only,
+				matching_condition_func func,
+				int sd, int *values,
+				struct kshark_entry_request *req)
+{
+	return ksmodel_entry_request_init(req,
+					  ksmodel_last_index_at_bin(histo, bin),
+					  ksmodel_bin_count(histo, bin),
+					  vis_only, func, sd, values);
 }
+// END of change
 
 /**
  * @brief Get the index of the first entry from a given Cpu in a given bin.
@@ -855,13 +951,22 @@ ssize_t ksmodel_first_index_at_cpu(struct kshark_trace_histo *histo,
 	first = ksmodel_first_index_at_bin(histo, bin);
 
 	for (i = first; i < first + n; ++i) {
-		if (histo->data[i]->cpu == cpu &&
-		    histo->data[i]->stream_id == sd) {
-			if (ksmodel_is_visible(histo->data[i]))
-				return i;
-			else
-				not_found = KS_FILTERED_BIN;
+		//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+		if (histo->columns) {
+			/* Touch the entry only if its Ids are matching. */
+			if (histo->columns->cpu[i] != cpu ||
+			    histo->columns->stream_id[i] != sd)
+				continue;
+		} else if (histo->data[i]->cpu != cpu ||
+			   histo->data[i]->stream_id != sd) {
+			continue;
 		}
+		// END of change
+
+		if (ksmodel_is_visible(histo->data[i]))
+			return i;
+		else
+			not_found = KS_FILTERED_BIN;
 	}
 
 	return not_found;
@@ -889,13 +994,22 @@ ssize_t ksmodel_first_index_at_pid(struct kshark_trace_histo *histo,
 	first = ksmodel_first_index_at_bin(histo, bin);
 
 	for (i = first; i < first + n; ++i) {
-		if (histo->data[i]->pid == pid &&
-		    histo->data[i]->stream_id == sd) {
-			if (ksmodel_is_visible(histo->data[i]))
-				return i;
-			else
-				not_found = KS_FILTERED_BIN;
+		//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+		if (histo->columns) {
+			/* Touch the entry only if its Ids are matching. */
+			if (histo->columns->pid[i] != pid ||
+			    histo->columns->stream_id[i] != sd)
+				continue;
+		} else if (histo->data[i]->pid != pid ||
+			   histo->data[i]->stream_id != sd) {
+			continue;
 		}
+		// END of change
+
+		if (ksmodel_is_visible(histo->data[i]))
+			return i;
+		else
+			not_found = KS_FILTERED_BIN;
 	}
 
 	return not_found;
@@ -926,25 +1040,26 @@ ksmodel_get_entry_front(struct kshark_trace_histo *histo,
 			struct kshark_entry_collection *col,
 			ssize_t *index)
 {
-	struct kshark_entry_request *req;
+	//NOTE: Changed here. (BIN BATCH) (2026-10-17)
+	struct kshark_entry_request req;
 	const struct kshark_entry *entry;
 
 	if (index)
 		*index = KS_EMPTY_BIN;
 
 	/* Set the position at the beginning of the bin and go forward. */
-	req = ksmodel_entry_front_request_alloc(histo, bin, vis_only,
-						func, sd, values);
-	if (!req)
+	if (!ksmodel_entry_front_request_init(histo, bin, vis_only,
+					      func, sd, values, &req))
 		return NULL;
 
 	if (col && col->size)
-		entry = kshark_get_collection_entry_front(req, histo->data,
+		entry = kshark_get_collection_entry_front(&req, histo->data,
 							  col, index);
 	else
-		entry = kshark_get_entry_front(req, histo->data, index);
+		entry = kshark_get_entry_front(&req, histo->data, index);
 
-	kshark_free_entry_request(req);
+	kshark_free_entry_request(req.next);
+	// END of change
 
 	return entry;
 }
@@ -974,25 +1089,26 @@ ksmodel_get_entry_back(struct kshark_trace_histo *histo,
 		       struct kshark_entry_collection *col,
 		       ssize_t *index)
 {
-	struct kshark_entry_request *req;
+	//NOTE: Changed here. (BIN BATCH) (2026-10-17)
+	struct kshark_entry_request req;
 	const struct kshark_entry *entry;
 
 	if (index)
 		*index = KS_EMPTY_BIN;
 
 	/* Set the position at the end of the bin and go backwards. */
-	req = ksmodel_entry_back_request_alloc(histo, bin, vis_only,
-					       func, sd, values);
-	if (!req)
+	if (!ksmodel_entry_back_request_init(histo, bin, vis_only,
+					     func, sd, values, &req))
 		return NULL;
 
 	if (col && col->size)
-		entry = kshark_get_collection_entry_back(req, histo->data,
+		entry = kshark_get_collection_entry_back(&req, histo->data,
 							 col, index);
 	else
-		entry = kshark_get_entry_back(req, histo->data, index);
+		entry = kshark_get_entry_back(&req, histo->data, index);
 
-	kshark_free_entry_request(req);
+	kshark_free_entry_request(req.next);
+	// END of change
 
 	return entry;
 }
@@ -1184,17 +1300,18 @@ bool ksmodel_cpu_visible_event_exist(struct kshark_trace_histo *histo,
 				     struct kshark_entry_collection *col,
 				     ssize_t *index)
 {
-	struct kshark_entry_request *req;
+	//NOTE: Changed here. (BIN BATCH) (2026-10-17)
+	struct kshark_entry_request req;
 	const struct kshark_entry *entry;
 
 	if (index)
 		*index = KS_EMPTY_BIN;
 
 	/* Set the position at the beginning of the bin and go forward. */
-	req = ksmodel_entry_front_request_alloc(histo,
-						bin, true,
-						kshark_match_cpu, sd, &cpu);
-	if (!req)
+	if (!ksmodel_entry_front_request_init(histo,
+					      bin, true,
+					      kshark_match_cpu, sd, &cpu,
+					      &req))
 		return false;
 
 	/*
@@ -1202,15 +1319,16 @@ bool ksmodel_cpu_visible_event_exist(struct kshark_trace_histo *histo,
 	 * KS_GRAPH_VIEW_FILTER_MASK. Change the mask to
 	 * KS_EVENT_VIEW_FILTER_MASK because we want to find a visible event.
 	 */
-	req->vis_mask = KS_EVENT_VIEW_FILTER_MASK;
+	req.vis_mask = KS_EVENT_VIEW_FILTER_MASK;
 
 	if (col && col->size)
-		entry = kshark_get_collection_entry_front(req, histo->data,
+		entry = kshark_get_collection_entry_front(&req, histo->data,
 							  col, index);
 	else
-		entry = kshark_get_entry_front(req, histo->data, index);
+		entry = kshark_get_entry_front(&req, histo->data, index);
 
-	kshark_free_entry_request(req);
+	kshark_free_entry_request(req.next);
+	// END of change
 
 	if (!entry || !entry->visible) {
 		/* No visible entry has been found. */
@@ -1238,17 +1356,18 @@ bool ksmodel_task_visible_event_exist(struct kshark_trace_histo *histo,
 				      struct kshark_entry_collection *col,
 				      ssize_t *index)
 {
-	struct kshark_entry_request *req;
+	//NOTE: Changed here. (BIN BATCH) (2026-10-17)
+	struct kshark_entry_request req;
 	const struct kshark_entry *entry;
 
 	if (index)
 		*index = KS_EMPTY_BIN;
 
 	/* Set the position at the beginning of the bin and go forward. */
-	req = ksmodel_entry_front_request_alloc(histo,
-						bin, true,
-						kshark_match_pid, sd, &pid);
-	if (!req)
+	if (!ksmodel_entry_front_request_init(histo,
+					      bin, true,
+					      kshark_match_pid, sd, &pid,
+					      &req))
 		return false;
 
 	/*
@@ -1256,15 +1375,16 @@ bool ksmodel_task_visible_event_exist(struct kshark_trace_histo *histo,
 	 * KS_GRAPH_VIEW_FILTER_MASK. Change the mask to
 	 * KS_EVENT_VIEW_FILTER_MASK because we want to find a visible event.
 	 */
-	req->vis_mask = KS_EVENT_VIEW_FILTER_MASK;
+	req.vis_mask = KS_EVENT_VIEW_FILTER_MASK;
 
 	if (col && col->size)
-		entry = kshark_get_collection_entry_front(req, histo->data,
+		entry = kshark_get_collection_entry_front(&req, histo->data,
 							  col, index);
 	else
-		entry = kshark_get_entry_front(req, histo->data, index);
+		entry = kshark_get_entry_front(&req, histo->data, index);
 
-	kshark_free_entry_request(req);
+	kshark_free_entry_request(req.next);
+	// END of change
 
 	if (!entry || !entry->visible) {
 		/* No visible entry has been found. */
@@ -1338,6 +1458,516 @@ ksmodel_get_task_missed_events(struct kshark_trace_histo *histo,
 				       col, index);
 }
 
+//NOTE: Changed here. (BIN BATCH) (2026-10-17)
+/* Cursor over the data intervals of a collection, moving forward only. */
+struct ksmodel_col_cursor {
+	const struct kshark_entry_collection	*col;
+	size_t					interval;
+};
+
+static void ksmodel_col_cursor_init(struct ksmodel_col_cursor *cursor,
+				    const struct kshark_entry_collection *col)
+{
+	cursor->col = (col && col->size) ? col : NULL;
+	cursor->interval = 0;
+}
+
+/*
+ * Get the first row, which is not before "row" and is inside the data
+ * intervals of the collection. Without a collection, this is "row" itself.
+ * SIZE_MAX is returned if there is no such row.
+ */
+static size_t ksmodel_col_next(struct ksmodel_col_cursor *cursor, size_t row)
+{
+	const struct kshark_entry_collection *col = cursor->col;
+
+	if (!col)
+		return row;
+
+	while (cursor->interval < col->size &&
+	       col->break_points[cursor->interval] < row)
+		++cursor->interval;
+
+	if (cursor->interval == col->size)
+		return SIZE_MAX;
+
+	if (row < col->resume_points[cursor->interval])
+		return col->resume_points[cursor->interval];
+
+	return row;
+}
+
+static inline bool ksmodel_row_at_cpu(const struct kshark_trace_histo *histo,
+				      size_t row, int sd, int cpu)
+{
+	if (histo->columns)
+		return histo->columns->cpu[row] == cpu &&
+		       histo->columns->stream_id[row] == sd;
+
+	return histo->data[row]->cpu == cpu &&
+	       histo->data[row]->stream_id == sd;
+}
+
+static inline bool ksmodel_row_at_pid(const struct kshark_trace_histo *histo,
+				      size_t row, int sd, int pid)
+{
+	if (histo->columns)
+		return histo->columns->pid[row] == pid &&
+		       histo->columns->stream_id[row] == sd;
+
+	return histo->data[row]->pid == pid &&
+	       histo->data[row]->stream_id == sd;
+}
+
+static void ksmodel_graph_bin_reset(struct ksmodel_graph_bin *bin)
+{
+	bin->id_front = bin->id_back = KS_EMPTY_BIN;
+	bin->pid_front = bin->pid_back = KS_EMPTY_BIN;
+	bin->vis_mask = 0x0;
+}
+
+/* Rows of a graph, found while sweeping through a bin. */
+struct ksmodel_bin_sweep {
+	/* The first and the last row from the graph. */
+	ssize_t	first, last;
+
+	/* The first and the last row from the graph, visible in the graphs. */
+	ssize_t	front, back;
+
+	/* The first row from the graph, which is a visible event. */
+	ssize_t	event;
+};
+
+static inline void ksmodel_bin_sweep_reset(struct ksmodel_bin_sweep *sweep)
+{
+	sweep->first = sweep->last = -1;
+	sweep->front = sweep->back = -1;
+	sweep->event = -1;
+}
+
+static inline void ksmodel_bin_sweep_add(struct ksmodel_bin_sweep *sweep,
+					 uint8_t visible, size_t row)
+{
+	if (sweep->first < 0)
+		sweep->first = row;
+
+	sweep->last = row;
+	if (visible & KS_GRAPH_VIEW_FILTER_MASK) {
+		if (sweep->front < 0)
+			sweep->front = row;
+
+		sweep->back = row;
+	}
+
+	if (sweep->event < 0 && (visible & KS_EVENT_VIEW_FILTER_MASK))
+		sweep->event = row;
+}
+
+/*
+ * The visibility mask of a bin is the one of its front entry, unless this
+ * entry is not a visible event and there is a visible event in the bin.
+ */
+static uint8_t ksmodel_bin_vis_mask(const struct kshark_trace_histo *histo,
+				    ssize_t front, ssize_t event)
+{
+	uint8_t visible = histo->data[front]->visible;
+
+	if (!(visible & KS_EVENT_VIEW_FILTER_MASK) && event >= 0)
+		return histo->data[event]->visible;
+
+	return visible;
+}
+
+/* Set a bin of a CPU graph from the rows of the CPU in this bin. */
+static void ksmodel_cpu_bin_set(const struct kshark_trace_histo *histo,
+				const struct ksmodel_bin_sweep *sweep,
+				struct ksmodel_graph_bin *bin)
+{
+	ksmodel_graph_bin_reset(bin);
+	if (sweep->last < 0)
+		return;
+
+	/* Some entries are found. If none of them is visible, the bin is
+	 * filtered. */
+	bin->id_front = (sweep->front < 0) ? KS_FILTERED_BIN :
+			histo->data[sweep->front]->pid;
+
+	/* The bin ends with filtered data from another task. */
+	bin->id_back = (sweep->back < 0) ? KS_FILTERED_BIN :
+		       histo->data[sweep->back]->pid;
+
+	if (bin->id_back != histo->data[sweep->last]->pid)
+		bin->id_back = KS_FILTERED_BIN;
+
+	if (sweep->front >= 0)
+		bin->vis_mask = ksmodel_bin_vis_mask(histo, sweep->front,
+						     sweep->event);
+}
+
+/*
+ * Set a bin of a Task graph from the rows of the task in this bin. The
+ * bin starts at row "start" and ends before row "end". The cursor must not
+ * be past the start of the bin.
+ */
+static void ksmodel_task_bin_set(const struct kshark_trace_histo *histo,
+				 int sd, const struct ksmodel_bin_sweep *sweep,
+				 struct ksmodel_col_cursor *cursor,
+				 size_t start, size_t end,
+				 struct ksmodel_graph_bin *bin)
+{
+	size_t i;
+
+	ksmodel_graph_bin_reset(bin);
+	if (sweep->first < 0)
+		return;
+
+	bin->id_front = histo->data[sweep->first]->cpu;
+	bin->id_back = histo->data[sweep->last]->cpu;
+	if (bin->id_front < 0) {
+		bin->pid_front = bin->pid_back = bin->id_front;
+		return;
+	}
+
+	/*
+	 * The first entry on the CPU of the first entry of the task cannot
+	 * come after this entry of the task.
+	 */
+	for (i = ksmodel_col_next(cursor, start); i <= (size_t) sweep->first;
+	     i = ksmodel_col_next(cursor, i + 1)) {
+		if (ksmodel_row_at_cpu(histo, i, sd, bin->id_front)) {
+			bin->pid_front = histo->data[i]->pid;
+			break;
+		}
+	}
+
+	/*
+	 * The last entry on the CPU of the last entry of the task cannot come
+	 * before this entry of the task.
+	 */
+	if (bin->id_back >= 0) {
+		for (i = ksmodel_col_next(cursor, sweep->last); i < end;
+		     i = ksmodel_col_next(cursor, i + 1)) {
+			if (ksmodel_row_at_cpu(histo, i, sd, bin->id_back))
+				bin->pid_back = histo->data[i]->pid;
+		}
+	}
+
+	bin->vis_mask = ksmodel_bin_vis_mask(histo, sweep->first,
+					     sweep->event);
+}
+
+/**
+ * @brief Compute the content of all bins of a CPU graph in a single forward
+ *	  sweep over the data of the model. The result is the same as the
+ *	  one of calling ksmodel_get_pid_front(), ksmodel_get_pid_back() (with
+ *	  and without "vis_only") and ksmodel_cpu_visible_event_exist() for
+ *	  each bin, but no memory is allocated.
+ *
+ * @param histo: Input location for the model descriptor.
+ * @param sd: Data stream identifier.
+ * @param cpu: CPU Id.
+ * @param col: Optional input location for Data collection.
+ * @param bins: Output location for the content of the bins. The array must
+ *		have "histo->n_bins" elements. For each bin, "id_front" is the
+ *		Process Id of the first visible entry from the CPU, "id_back"
+ *		is the Process Id of the last visible entry (KS_FILTERED_BIN
+ *		if the last entry is filtered) and "vis_mask" is the
+ *		visibility mask of the bin.
+ */
+void ksmodel_fill_cpu_graph_bins(struct kshark_trace_histo *histo,
+				 int sd, int cpu,
+				 const struct kshark_entry_collection *col,
+				 struct ksmodel_graph_bin *bins)
+{
+	struct ksmodel_col_cursor cursor;
+	struct ksmodel_bin_sweep sweep;
+	size_t i, end;
+	int bin;
+
+	ksmodel_col_cursor_init(&cursor, col);
+	for (bin = 0; bin < histo->n_bins; ++bin) {
+		if (cpu < 0 || !histo->bin_count[bin]) {
+			ksmodel_graph_bin_reset(&bins[bin]);
+			continue;
+		}
+
+		ksmodel_bin_sweep_reset(&sweep);
+		end = histo->map[bin] + histo->bin_count[bin];
+		for (i = ksmodel_col_next(&cursor, histo->map[bin]); i < end;
+		     i = ksmodel_col_next(&cursor, i + 1)) {
+			if (ksmodel_row_at_cpu(histo, i, sd, cpu))
+				ksmodel_bin_sweep_add(&sweep,
+						      histo->data[i]->visible, i);
+		}
+
+		ksmodel_cpu_bin_set(histo, &sweep, &bins[bin]);
+	}
+}
+
+/**
+ * @brief Compute the content of all bins of a Task graph in a single forward
+ *	  sweep over the data of the model. The result is the same as the
+ *	  one of calling ksmodel_get_cpu_front(), ksmodel_get_cpu_back(),
+ *	  ksmodel_get_pid_front(), ksmodel_get_pid_back() (all without
+ *	  "vis_only") and ksmodel_task_visible_event_exist() for each bin, but
+ *	  no memory is allocated.
+ *
+ * @param histo: Input location for the model descriptor.
+ * @param sd: Data stream identifier.
+ * @param pid: Process Id of the task.
+ * @param col: Optional input location for Data collection.
+ * @param bins: Output location for the content of the bins. The array must
+ *		have "histo->n_bins" elements. For each bin, "id_front" and
+ *		"id_back" are the CPUs of the first and of the last entry
+ *		from the task, "pid_front" is the Process Id of the first
+ *		entry on "id_front", "pid_back" is the Process Id of the last
+ *		entry on "id_back" and "vis_mask" is the visibility mask of
+ *		the bin.
+ */
+void ksmodel_fill_task_graph_bins(struct kshark_trace_histo *histo,
+				  int sd, int pid,
+				  const struct kshark_entry_collection *col,
+				  struct ksmodel_graph_bin *bins)
+{
+	struct ksmodel_col_cursor cursor, bin_start;
+	struct ksmodel_bin_sweep sweep;
+	size_t i, end;
+	int bin;
+
+	ksmodel_col_cursor_init(&cursor, col);
+	for (bin = 0; bin < histo->n_bins; ++bin) {
+		if (pid < 0 || !histo->bin_count[bin]) {
+			ksmodel_graph_bin_reset(&bins[bin]);
+			continue;
+		}
+
+		ksmodel_bin_sweep_reset(&sweep);
+		bin_start = cursor;
+		end = histo->map[bin] + histo->bin_count[bin];
+		for (i = ksmodel_col_next(&cursor, histo->map[bin]); i < end;
+		     i = ksmodel_col_next(&cursor, i + 1)) {
+			if (ksmodel_row_at_pid(histo, i, sd, pid))
+				ksmodel_bin_sweep_add(&sweep,
+						      histo->data[i]->visible, i);
+		}
+
+		ksmodel_task_bin_set(histo, sd, &sweep, &bin_start,
+				     histo->map[bin], end, &bins[bin]);
+	}
+}
+// END of change
+
+//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+/* A Task graph, looked up by the Process Id of a row. */
+struct ksmodel_task_key {
+	int	pid;
+	int	graph;
+};
+
+static int ksmodel_task_key_cmp(const void *a, const void *b)
+{
+	const struct ksmodel_task_key *ka = a, *kb = b;
+
+	if (ka->pid != kb->pid)
+		return (ka->pid < kb->pid) ? -1 : 1;
+
+	return ka->graph - kb->graph;
+}
+
+/* Get the first Task graph of a task, or "n_keys" if there is no such graph. */
+static size_t ksmodel_task_key_find(const struct ksmodel_task_key *keys,
+				    size_t n_keys, int pid)
+{
+	size_t l = 0, h = n_keys;
+
+	if (!n_keys || pid < keys[0].pid || pid > keys[n_keys - 1].pid)
+		return n_keys;
+
+	while (l < h) {
+		size_t mid = l + (h - l) / 2;
+
+		if (keys[mid].pid < pid)
+			l = mid + 1;
+		else
+			h = mid;
+	}
+
+	return (l < n_keys && keys[l].pid == pid) ? l : n_keys;
+}
+
+/* Memory, used while filling a table of graphs. */
+struct ksmodel_graph_table_ctx {
+	struct ksmodel_bin_sweep	*sweeps;
+	struct ksmodel_col_cursor	*cursors;
+	struct ksmodel_col_cursor	*bin_starts;
+	struct ksmodel_task_key		*task_keys;
+	size_t				n_task_keys;
+
+	/* The first CPU graph of each CPU and the next graph of each graph. */
+	int				*cpu_first;
+	int				*cpu_next;
+	int				n_cpus;
+};
+
+static void ksmodel_graph_table_ctx_free(struct ksmodel_graph_table_ctx *ctx)
+{
+	free(ctx->sweeps);
+	free(ctx->cursors);
+	free(ctx->bin_starts);
+	free(ctx->task_keys);
+	free(ctx->cpu_first);
+	free(ctx->cpu_next);
+}
+
+static bool ksmodel_graph_table_ctx_init(struct ksmodel_graph_table_ctx *ctx,
+					 const struct ksmodel_graph_desc *graphs,
+					 size_t n_graphs)
+{
+	size_t g;
+	int cpu;
+
+	memset(ctx, 0, sizeof(*ctx));
+	for (g = 0; g < n_graphs; ++g)
+		if (!graphs[g].task && graphs[g].id >= ctx->n_cpus)
+			ctx->n_cpus = graphs[g].id + 1;
+
+	ctx->sweeps = calloc(n_graphs, sizeof(*ctx->sweeps));
+	ctx->cursors = calloc(n_graphs, sizeof(*ctx->cursors));
+	ctx->bin_starts = calloc(n_graphs, sizeof(*ctx->bin_starts));
+	ctx->task_keys = calloc(n_graphs, sizeof(*ctx->task_keys));
+	ctx->cpu_next = calloc(n_graphs, sizeof(*ctx->cpu_next));
+	ctx->cpu_first = calloc(ctx->n_cpus + 1, sizeof(*ctx->cpu_first));
+	if (!ctx->sweeps || !ctx->cursors || !ctx->bin_starts ||
+	    !ctx->task_keys || !ctx->cpu_next || !ctx->cpu_first) {
+		ksmodel_graph_table_ctx_free(ctx);
+		return false;
+	}
+
+	for (cpu = 0; cpu < ctx->n_cpus; ++cpu)
+		ctx->cpu_first[cpu] = -1;
+
+	/* Chain the CPU graphs in reverse, so that each chain is in order. */
+	for (g = n_graphs; g-- > 0;) {
+		ksmodel_col_cursor_init(&ctx->cursors[g], graphs[g].col);
+		if (graphs[g].id < 0)
+			continue;
+
+		if (graphs[g].task) {
+			ctx->task_keys[ctx->n_task_keys].pid = graphs[g].id;
+			ctx->task_keys[ctx->n_task_keys++].graph = g;
+		} else {
+			ctx->cpu_next[g] = ctx->cpu_first[graphs[g].id];
+			ctx->cpu_first[graphs[g].id] = g;
+		}
+	}
+
+	qsort(ctx->task_keys, ctx->n_task_keys, sizeof(*ctx->task_keys),
+	      ksmodel_task_key_cmp);
+
+	return true;
+}
+
+/* Add a row to a graph, if the row is inside the Data collection of it. */
+static inline void ksmodel_graph_table_add(struct ksmodel_graph_table_ctx *ctx,
+					   int graph, uint8_t visible,
+					   size_t row)
+{
+	if (ksmodel_col_next(&ctx->cursors[graph], row) == row)
+		ksmodel_bin_sweep_add(&ctx->sweeps[graph], visible, row);
+}
+
+/**
+ * @brief Compute the content of all bins of many CPU and Task graphs in a
+ *	  single forward sweep over the data of the model. Each graph gets the
+ *	  same result as the one of ksmodel_fill_cpu_graph_bins() or
+ *	  ksmodel_fill_task_graph_bins(), but each entry of the model is read
+ *	  only once for all CPU and Task graphs.
+ *
+ * @param histo: Input location for the model descriptor.
+ * @param sd: Data stream identifier.
+ * @param graphs: Input location for the descriptors of the graphs.
+ * @param n_graphs: The number of graphs.
+ * @param table: Output location for the content of the bins. The array must
+ *		 have "n_graphs * histo->n_bins" elements. The bins of graph
+ *		 "g" start at "table[g * histo->n_bins]".
+ *
+ * @returns True on success, or false if memory allocation failed.
+ */
+bool ksmodel_fill_graph_table(struct kshark_trace_histo *histo, int sd,
+			      const struct ksmodel_graph_desc *graphs,
+			      size_t n_graphs,
+			      struct ksmodel_graph_bin *table)
+{
+	struct ksmodel_graph_table_ctx ctx;
+	int bin, cpu, pid, stream_id, g;
+	size_t i, k, end, n_bins;
+	uint8_t visible;
+
+	if (!n_graphs)
+		return true;
+
+	if (!ksmodel_graph_table_ctx_init(&ctx, graphs, n_graphs)) {
+		fprintf(stderr,
+			"Failed to allocate memory for a table of graphs.\n");
+		return false;
+	}
+
+	n_bins = histo->n_bins;
+	for (bin = 0; bin < histo->n_bins; ++bin) {
+		for (g = 0; g < (int) n_graphs; ++g) {
+			ksmodel_bin_sweep_reset(&ctx.sweeps[g]);
+			ctx.bin_starts[g] = ctx.cursors[g];
+		}
+
+		end = histo->map[bin] + histo->bin_count[bin];
+		for (i = histo->map[bin]; histo->bin_count[bin] && i < end; ++i) {
+			if (histo->columns) {
+				stream_id = histo->columns->stream_id[i];
+				cpu = histo->columns->cpu[i];
+				pid = histo->columns->pid[i];
+			} else {
+				stream_id = histo->data[i]->stream_id;
+				cpu = histo->data[i]->cpu;
+				pid = histo->data[i]->pid;
+			}
+
+			if (stream_id != sd)
+				continue;
+
+			visible = histo->data[i]->visible;
+			if (cpu >= 0 && cpu < ctx.n_cpus)
+				for (g = ctx.cpu_first[cpu]; g >= 0;
+				     g = ctx.cpu_next[g])
+					ksmodel_graph_table_add(&ctx, g,
+								visible, i);
+
+			for (k = ksmodel_task_key_find(ctx.task_keys,
+						       ctx.n_task_keys, pid);
+			     k < ctx.n_task_keys && ctx.task_keys[k].pid == pid;
+			     ++k)
+				ksmodel_graph_table_add(&ctx,
+							ctx.task_keys[k].graph,
+							visible, i);
+		}
+
+		for (g = 0; g < (int) n_graphs; ++g) {
+			if (graphs[g].task)
+				ksmodel_task_bin_set(histo, sd, &ctx.sweeps[g],
+						     &ctx.bin_starts[g],
+						     histo->map[bin], end,
+						     &table[g * n_bins + bin]);
+			else
+				ksmodel_cpu_bin_set(histo, &ctx.sweeps[g],
+						    &table[g * n_bins + bin]);
+		}
+	}
+
+	ksmodel_graph_table_ctx_free(&ctx);
+
+	return true;
+}
+// END of change
+
 /**
  * @brief Find the bin Id of a give entry.
  *
@@ -71,6 +71,15 @@ struct kshark_trace_histo {
 
 	/** Number of bins. */
 	int			n_bins;
+
+	//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+	/**
+	 * Optional columnar copy of the trace data array. If available, the
+	 * timestamps and the Ids are read from it, instead of dereferencing
+	 * the entries. Not owned by the model.
+	 */
+	const struct kshark_entry_columns	*columns;
+	// END of change
 };
 
 void ksmodel_init(struct kshark_trace_histo *histo);
@@ -83,6 +92,12 @@ void ksmodel_set_bining(struct kshark_trace_histo *histo,
 void ksmodel_fill(struct kshark_trace_histo *histo,
 		  struct kshark_entry **data, size_t n);
 
+//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+void ksmodel_fill_columns(struct kshark_trace_histo *histo,
+			  struct kshark_entry **data,
+			  const struct kshark_entry_columns *columns);
+// END of change
+
 size_t ksmodel_bin_count(struct kshark_trace_histo *histo, int bin);
 
 void ksmodel_shift_forward(struct kshark_trace_histo *histo, int n);
@@ -163,6 +178,62 @@ ksmodel_get_task_missed_events(struct kshark_trace_histo *histo,
 			       struct kshark_entry_collection *col,
 			       ssize_t *index);
 
+//NOTE: Changed here. (BIN BATCH) (2026-10-17)
+/**
+ * Content of a bin of a CPU or a Task graph, computed for all bins of the
+ * graph at once.
+ */
+struct ksmodel_graph_bin {
+	/**
+	 * Id at the front (first in time) edge of the bin. Process Id for a
+	 * CPU graph and CPU Id for a Task graph. Negative identifier
+	 * (KS_EMPTY_BIN or KS_FILTERED_BIN) if no such Id exists.
+	 */
+	int	id_front;
+
+	/** Id at the back (last in time) edge of the bin. */
+	int	id_back;
+
+	/** Task graph only: Process Id of the first entry on "id_front". */
+	int	pid_front;
+
+	/** Task graph only: Process Id of the last entry on "id_back". */
+	int	pid_back;
+
+	/** The visibility mask of the bin. */
+	uint8_t	vis_mask;
+};
+
+void ksmodel_fill_cpu_graph_bins(struct kshark_trace_histo *histo,
+				 int sd, int cpu,
+				 const struct kshark_entry_collection *col,
+				 struct ksmodel_graph_bin *bins);
+
+void ksmodel_fill_task_graph_bins(struct kshark_trace_histo *histo,
+				  int sd, int pid,
+				  const struct kshark_entry_collection *col,
+				  struct ksmodel_graph_bin *bins);
+// END of change
+
+//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+/** Descriptor of a graph, computed by ksmodel_fill_graph_table(). */
+struct ksmodel_graph_desc {
+	/** CPU Id of a CPU graph or Process Id of a Task graph. */
+	int					id;
+
+	/** True for a Task graph, false for a CPU graph. */
+	bool					task;
+
+	/** Optional Data collection of the graph. */
+	struct kshark_entry_collection		*col;
+};
+
+bool ksmodel_fill_graph_table(struct kshark_trace_histo *histo, int sd,
+			      const struct ksmodel_graph_desc *graphs,
+			      size_t n_graphs,
+			      struct ksmodel_graph_bin *table);
+// END of change
+
 static inline int64_t ksmodel_bin_ts(struct kshark_trace_histo *histo,
 				      int bin)
 {
@@ -15,9 +15,18 @@
 #define _GNU_SOURCE
 #endif // _GNU_SOURCE
 
+//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+/** Declare the OpenGL functions of vertex buffer objects. */
+#define GL_GLEXT_PROTOTYPES
+// END of change
+
 #include <sys/stat.h>
 #include <string.h>
 #include <stdio.h>
+//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+#include <stddef.h>
+#include <stdlib.h>
+// END of change
 
 // KernelShark
 #include "libkshark-plot.h"
@@ -66,6 +75,243 @@ void ksplot_make_scene(int width, int height)
 
 #endif // GLUT_FOUND
 
+//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+/* The batch being recorded, or NULL if the shapes are drawn immediately. */
+static struct ksplot_batch *ksplot_recording = NULL;
+
+static bool ksplot_batch_grow(void **array, size_t *size, size_t n,
+			      size_t elem_size)
+{
+	size_t new_size = *size ? *size : 1024;
+	void *tmp;
+
+	while (new_size < n)
+		new_size *= 2;
+
+	if (new_size == *size)
+		return true;
+
+	tmp = realloc(*array, new_size * elem_size);
+	if (!tmp)
+		return false;
+
+	*array = tmp;
+	*size = new_size;
+
+	return true;
+}
+
+/*
+ * Add "n" vertices to the batch being recorded. The vertices extend the last
+ * run if it has the same kind of primitives, otherwise a new run is started.
+ * Returns a pointer to the new vertices, or NULL on failure.
+ */
+static struct ksplot_vertex *ksplot_batch_add(enum ksplot_primitive type,
+					      float size, GLuint texture,
+					      size_t n)
+{
+	struct ksplot_batch *batch = ksplot_recording;
+	struct ksplot_batch_run *run = NULL;
+	struct ksplot_vertex *v;
+
+	if (batch->failed)
+		return NULL;
+
+	if (!ksplot_batch_grow((void **) &batch->vertices,
+			       &batch->vertices_size,
+			       batch->n_vertices + n,
+			       sizeof(*batch->vertices)))
+		goto fail;
+
+	if (batch->n_runs)
+		run = &batch->runs[batch->n_runs - 1];
+
+	if (!run || run->type != type || run->size != size ||
+	    run->texture != texture) {
+		if (!ksplot_batch_grow((void **) &batch->runs,
+				       &batch->runs_size,
+				       batch->n_runs + 1,
+				       sizeof(*batch->runs)))
+			goto fail;
+
+		run = &batch->runs[batch->n_runs++];
+		run->type = type;
+		run->size = size;
+		run->texture = texture;
+		run->first = batch->n_vertices;
+		run->count = 0;
+	}
+
+	v = &batch->vertices[batch->n_vertices];
+	batch->n_vertices += n;
+	run->count += n;
+
+	return v;
+
+ fail:
+	fprintf(stderr, "Failed to allocate memory for a batch of shapes.\n");
+	batch->failed = true;
+	return NULL;
+}
+
+static void ksplot_vertex_set(struct ksplot_vertex *v, float x, float y,
+			      const struct ksplot_color *col)
+{
+	v->x = x;
+	v->y = y;
+	v->s = v->t = 0;
+	v->color[0] = col->red;
+	v->color[1] = col->green;
+	v->color[2] = col->blue;
+	v->color[3] = 0xFF;
+}
+
+/**
+ * @brief Initialize an empty batch of shapes.
+ *
+ * @param batch: Output location for the batch.
+ */
+void ksplot_batch_init(struct ksplot_batch *batch)
+{
+	memset(batch, 0, sizeof(*batch));
+}
+
+/**
+ * @brief Free the memory used by a batch of shapes. If the batch has been
+ *	  drawn, the OpenGL context used to draw it must be current.
+ *
+ * @param batch: Input location for the batch.
+ */
+void ksplot_batch_free(struct ksplot_batch *batch)
+{
+	if (ksplot_recording == batch)
+		ksplot_recording = NULL;
+
+	if (batch->buffer)
+		glDeleteBuffers(1, &batch->buffer);
+
+	free(batch->vertices);
+	free(batch->runs);
+	ksplot_batch_init(batch);
+}
+
+/**
+ * @brief Start recording a batch of shapes. Until ksplot_batch_end() is
+ *	  called, the ksplot_draw_* functions and ksplot_print_text() add the
+ *	  shapes to the batch instead of drawing them. No OpenGL context is
+ *	  needed for recording.
+ *
+ * @param batch: Input location for the batch. The old content of the batch
+ *		 is dropped.
+ */
+void ksplot_batch_begin(struct ksplot_batch *batch)
+{
+	batch->n_vertices = 0;
+	batch->n_runs = 0;
+	batch->uploaded = false;
+	batch->failed = false;
+
+	ksplot_recording = batch;
+}
+
+/**
+ * @brief Stop recording a batch of shapes.
+ *
+ * @returns True if all shapes have been recorded, or false if memory
+ *	    allocation failed. In this case the shapes have to be drawn again
+ *	    without the batch.
+ */
+bool ksplot_batch_end(void)
+{
+	struct ksplot_batch *batch = ksplot_recording;
+
+	ksplot_recording = NULL;
+
+	return batch && !batch->failed;
+}
+
+/**
+ * @brief Draw a batch of shapes. The vertices are copied to an OpenGL vertex
+ *	  buffer the first time the batch is drawn, after being recorded.
+ *	  Each run of vertices is drawn with a single call.
+ *
+ * @param batch: Input location for the batch.
+ */
+void ksplot_batch_draw(struct ksplot_batch *batch)
+{
+	const GLsizei stride = sizeof(struct ksplot_vertex);
+	const char *base = NULL;
+	size_t i;
+
+	if (!batch->n_runs || batch->failed)
+		return;
+
+	if (!batch->buffer)
+		glGenBuffers(1, &batch->buffer);
+
+	if (batch->buffer) {
+		glBindBuffer(GL_ARRAY_BUFFER, batch->buffer);
+		if (!batch->uploaded)
+			glBufferData(GL_ARRAY_BUFFER,
+				     batch->n_vertices * stride,
+				     batch->vertices, GL_STATIC_DRAW);
+
+		batch->uploaded = true;
+	} else {
+		/* No vertex buffer. Draw from the memory of the batch. */
+		base = (const char *) batch->vertices;
+	}
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(2, GL_FLOAT, stride,
+			base + offsetof(struct ksplot_vertex, x));
+	glColorPointer(4, GL_UNSIGNED_BYTE, stride,
+		       base + offsetof(struct ksplot_vertex, color));
+	glTexCoordPointer(2, GL_FLOAT, stride,
+			  base + offsetof(struct ksplot_vertex, s));
+
+	for (i = 0; i < batch->n_runs; ++i) {
+		const struct ksplot_batch_run *run = &batch->runs[i];
+		GLenum mode = GL_TRIANGLES;
+
+		switch (run->type) {
+		case KSPLOT_POINTS:
+			glPointSize(run->size);
+			mode = GL_POINTS;
+			break;
+
+		case KSPLOT_LINES:
+			glLineWidth(run->size);
+			mode = GL_LINES;
+			break;
+
+		case KSPLOT_TEXT:
+			glEnable(GL_TEXTURE_2D);
+			glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+			glBindTexture(GL_TEXTURE_2D, run->texture);
+			break;
+
+		default:
+			break;
+		}
+
+		glDrawArrays(mode, run->first, run->count);
+
+		if (run->type == KSPLOT_TEXT) {
+			glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+			glDisable(GL_TEXTURE_2D);
+		}
+	}
+
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+
+	if (batch->buffer)
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+// END of change
+
 /**
  * @brief Initialize OpenGL.
  *
@@ -120,6 +366,18 @@ void ksplot_draw_point(const struct ksplot_point *p,
 	if (!p || !col || size < .5f)
 		return;
 
+	//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+	if (ksplot_recording) {
+		struct ksplot_vertex *v;
+
+		v = ksplot_batch_add(KSPLOT_POINTS, size, 0, 1);
+		if (v)
+			ksplot_vertex_set(v, p->x, p->y, col);
+
+		return;
+	}
+	// END of change
+
 	glPointSize(size);
 	glBegin(GL_POINTS);
 	glColor3ub(col->red, col->green, col->blue);
@@ -143,6 +401,20 @@ void ksplot_draw_line(const struct ksplot_point *a,
 	if (!a || !b || !col || size < .5f)
 		return;
 
+	//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+	if (ksplot_recording) {
+		struct ksplot_vertex *v;
+
+		v = ksplot_batch_add(KSPLOT_LINES, size, 0, 2);
+		if (v) {
+			ksplot_vertex_set(&v[0], a->x, a->y, col);
+			ksplot_vertex_set(&v[1], b->x, b->y, col);
+		}
+
+		return;
+	}
+	// END of change
+
 	glLineWidth(size);
 	glBegin(GL_LINES);
 	glColor3ub(col->red, col->green, col->blue);
@@ -201,6 +473,30 @@ void ksplot_draw_polygon(const struct ksplot_point *points,
 		return;
 	}
 
+	//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+	if (ksplot_recording) {
+		struct ksplot_vertex *v;
+
+		/*
+		 * Split the Triangle Fan into separate triangles, so that
+		 * many polygons can be drawn with a single call.
+		 */
+		v = ksplot_batch_add(KSPLOT_TRIANGLES, 0, 0,
+				     3 * (n_points - 2));
+		if (!v)
+			return;
+
+		for (size_t i = 1; i < n_points - 1; ++i, v += 3) {
+			ksplot_vertex_set(&v[0], points[0].x, points[0].y, col);
+			ksplot_vertex_set(&v[1], points[i].x, points[i].y, col);
+			ksplot_vertex_set(&v[2], points[i + 1].x,
+					  points[i + 1].y, col);
+		}
+
+		return;
+	}
+	// END of change
+
 	/* Draw a Triangle Fan. */
 	glBegin(GL_TRIANGLE_FAN);
 	glColor3ub(col->red, col->green, col->blue);
@@ -404,6 +700,53 @@ bool ksplot_init_font(struct ksplot_font *font, float size, const char *file)
 	return false;
 }
 
+//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+static void ksplot_batch_add_text(const struct ksplot_font *font,
+				  const struct ksplot_color *col,
+				  float x, float y,
+				  const char *text)
+{
+	const struct ksplot_color black = {0, 0, 0};
+	struct ksplot_vertex *v;
+
+	if (!col)
+		col = &black;
+
+	for (; *text; ++text) {
+		if (*text < KS_SPACE_CHAR && *text > KS_TILDA_CHAR)
+			continue;
+
+		stbtt_aligned_quad quad;
+
+		/* "x" is incremented here to a new position. */
+		stbtt_GetBakedQuad(font->cdata,
+				   KS_FONT_BITMAP_SIZE,
+				   KS_FONT_BITMAP_SIZE,
+				   *text - KS_SPACE_CHAR,
+				   &x, &y,
+				   &quad,
+				   1);
+
+		/* Each character is a quad, made of two triangles. */
+		v = ksplot_batch_add(KSPLOT_TEXT, 0, font->texture_id, 6);
+		if (!v)
+			return;
+
+		ksplot_vertex_set(&v[0], quad.x0, quad.y1, col);
+		v[0].s = quad.s0; v[0].t = quad.t1;
+		ksplot_vertex_set(&v[1], quad.x1, quad.y1, col);
+		v[1].s = quad.s1; v[1].t = quad.t1;
+		ksplot_vertex_set(&v[2], quad.x1, quad.y0, col);
+		v[2].s = quad.s1; v[2].t = quad.t0;
+
+		v[3] = v[0];
+		v[4] = v[2];
+		ksplot_vertex_set(&v[5], quad.x0, quad.y0, col);
+		v[5].s = quad.s0; v[5].t = quad.t0;
+	}
+}
+// END of change
+
 /**
  * @brief Print(draw) a text.
  *
@@ -418,6 +761,13 @@ void ksplot_print_text(const struct ksplot_font *font,
 		       float x, float y,
 		       const char *text)
 {
+	//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+	if (ksplot_recording) {
+		ksplot_batch_add_text(font, col, x, y, text);
+		return;
+	}
+	// END of change
+
 	glEnable(GL_TEXTURE_2D);
 
 	/* Set the color of the text. */
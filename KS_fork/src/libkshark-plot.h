@@ -135,6 +135,106 @@ void ksplot_print_text(const struct ksplot_font *font,
 		       float x, float y,
 		       const char *text);
 
+//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+/** Structure defining a vertex of a batch of shapes. */
+struct ksplot_vertex {
+	/** The horizontal coordinate of the vertex in pixels. */
+	GLfloat x;
+
+	/** The vertical coordinate of the vertex in pixels. */
+	GLfloat y;
+
+	/** The horizontal texture coordinate (used only by text). */
+	GLfloat s;
+
+	/** The vertical texture coordinate (used only by text). */
+	GLfloat t;
+
+	/** The RGBA color of the vertex. */
+	GLubyte color[4];
+};
+
+/** The kinds of primitives of a batch of shapes. */
+enum ksplot_primitive {
+	/** Points. */
+	KSPLOT_POINTS,
+
+	/** Lines, two vertices per line. */
+	KSPLOT_LINES,
+
+	/** Triangles, three vertices per triangle. */
+	KSPLOT_TRIANGLES,
+
+	/** Characters of a text, two textured triangles per character. */
+	KSPLOT_TEXT,
+};
+
+/**
+ * Structure defining a run of vertices of the same kind of primitives,
+ * drawn with a single OpenGL call.
+ */
+struct ksplot_batch_run {
+	/** The kind of primitives. */
+	enum ksplot_primitive	type;
+
+	/** The size of the points or the width of the lines. */
+	float			size;
+
+	/** The texture of the font of a text. */
+	GLuint			texture;
+
+	/** The index of the first vertex of the run. */
+	size_t			first;
+
+	/** The number of vertices of the run. */
+	size_t			count;
+};
+
+/**
+ * Structure defining a batch of shapes. The shapes are recorded once, by
+ * drawing them with the ksplot_draw_* and ksplot_print_text() functions,
+ * and can then be drawn many times with a few OpenGL calls.
+ */
+struct ksplot_batch {
+	/** The vertices of all shapes, in the order of drawing. */
+	struct ksplot_vertex	*vertices;
+
+	/** The number of vertices. */
+	size_t			n_vertices;
+
+	/** The number of vertices, for which memory is allocated. */
+	size_t			vertices_size;
+
+	/** The runs of vertices, in the order of drawing. */
+	struct ksplot_batch_run	*runs;
+
+	/** The number of runs. */
+	size_t			n_runs;
+
+	/** The number of runs, for which memory is allocated. */
+	size_t			runs_size;
+
+	/** OpenGL vertex buffer object, holding the vertices. */
+	GLuint			buffer;
+
+	/** True if the vertices have been copied to the vertex buffer. */
+	bool			uploaded;
+
+	/** True if memory allocation failed while recording. */
+	bool			failed;
+};
+
+void ksplot_batch_init(struct ksplot_batch *batch);
+
+void ksplot_batch_free(struct ksplot_batch *batch);
+
+void ksplot_batch_begin(struct ksplot_batch *batch);
+
+bool ksplot_batch_end(void);
+
+void ksplot_batch_draw(struct ksplot_batch *batch);
+// END of change
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,6 +21,9 @@
 #include <sys/stat.h>
 #include <dlfcn.h>
 #include <errno.h>
+//NOTE: Changed here. (EVENT DISPATCH) (2026-10-17)
+#include <limits.h>
+// END of change
 
 // KernelShark
 #include "libkshark-plugin.h"
@@ -100,6 +103,15 @@ int kshark_register_event_handler(struct kshark_data_stream *stream,
 	handler->next = stream->event_handlers;
 	stream->event_handlers = handler;
 
+	//NOTE: Changed here. (EVENT DISPATCH) (2026-10-17)
+	if (kshark_update_event_dispatch(stream) < 0) {
+		stream->event_handlers = handler->next;
+		free(handler);
+
+		return -ENOMEM;
+	}
+	// END of change
+
 	return 0;
 }
 
@@ -128,6 +140,14 @@ int kshark_unregister_event_handler(struct kshark_data_stream *stream,
 			*last = this_handler->next;
 			free(this_handler);
 
+			//NOTE: Changed here. (EVENT DISPATCH) (2026-10-17)
+			/*
+			 * On failure the table gets dropped and the handlers
+			 * are found by walking the list.
+			 */
+			kshark_update_event_dispatch(stream);
+			// END of change
+
 			return 0;
 		}
 	}
@@ -151,6 +171,94 @@ void kshark_free_event_handler_list(struct kshark_event_proc_handler *handlers)
 	}
 }
 
+//NOTE: Changed here. (EVENT DISPATCH) (2026-10-17)
+/**
+ * @brief Rebuild the event dispatch table of a Data stream, using its list
+ *	  of Event handlers. The handlers of each event type keep the order
+ *	  they have in the list.
+ *
+ * @param stream Input location for a Trace data stream pointer.
+ *
+ * @returns Zero on success, or -ENOMEM on failure. In the case of failure
+ *	    the stream is left without a dispatch table.
+ */
+int kshark_update_event_dispatch(struct kshark_data_stream *stream)
+{
+	struct kshark_event_dispatch *dispatch;
+	struct kshark_event_proc_handler *h;
+	int min_id = INT_MAX, max_id = INT_MIN;
+	int i, n_handlers = 0;
+	int *next;
+
+	kshark_free_event_dispatch(stream->event_dispatch);
+	stream->event_dispatch = NULL;
+
+	if (!stream->event_handlers)
+		return 0;
+
+	for (h = stream->event_handlers; h; h = h->next) {
+		if (h->id < min_id)
+			min_id = h->id;
+
+		if (h->id > max_id)
+			max_id = h->id;
+
+		++n_handlers;
+	}
+
+	dispatch = calloc(1, sizeof(*dispatch));
+	if (!dispatch)
+		goto fail;
+
+	dispatch->min_id = min_id;
+	dispatch->n_ids = max_id - min_id + 1;
+	dispatch->first = calloc(dispatch->n_ids + 1, sizeof(*dispatch->first));
+	dispatch->handlers = calloc(n_handlers, sizeof(*dispatch->handlers));
+	next = calloc(dispatch->n_ids, sizeof(*next));
+	if (!dispatch->first || !dispatch->handlers || !next) {
+		free(next);
+		kshark_free_event_dispatch(dispatch);
+		goto fail;
+	}
+
+	/* Count the handlers of each event type. */
+	for (h = stream->event_handlers; h; h = h->next)
+		dispatch->first[h->id - min_id + 1]++;
+
+	for (i = 0; i < dispatch->n_ids; ++i) {
+		dispatch->first[i + 1] += dispatch->first[i];
+		next[i] = dispatch->first[i];
+	}
+
+	for (h = stream->event_handlers; h; h = h->next)
+		dispatch->handlers[next[h->id - min_id]++] = h;
+
+	free(next);
+	stream->event_dispatch = dispatch;
+
+	return 0;
+
+ fail:
+	fputs("failed to allocate memory for event dispatch table\n", stderr);
+	return -ENOMEM;
+}
+
+/**
+ * @brief Free an event dispatch table.
+ *
+ * @param dispatch Input location for the event dispatch table.
+ */
+void kshark_free_event_dispatch(struct kshark_event_dispatch *dispatch)
+{
+	if (!dispatch)
+		return;
+
+	free(dispatch->first);
+	free(dispatch->handlers);
+	free(dispatch);
+}
+// END of change
+
 /**
  * @brief Add new event handler to an existing list of handlers.
  *
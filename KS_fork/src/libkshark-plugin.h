@@ -164,6 +164,65 @@ int kshark_unregister_event_handler(struct kshark_data_stream *stream,
 
 void kshark_free_event_handler_list(struct kshark_event_proc_handler *handlers);
 
+//NOTE: Changed here. (EVENT DISPATCH) (2026-10-17)
+/**
+ * Dense table of the Plugin's Trace event processing handlers, indexed by
+ * Event Id. The table is rebuilt every time an event handler gets registered
+ * or unregistered.
+ */
+struct kshark_event_dispatch {
+	/** The smallest Event Id covered by the table. */
+	int					min_id;
+
+	/** The number of Event Ids covered by the table. */
+	int					n_ids;
+
+	/**
+	 * Array of "n_ids + 1" indexes. The handlers of Event Id "id" are
+	 * "handlers[first[id - min_id]]" to "handlers[first[id - min_id + 1] - 1]".
+	 */
+	int					*first;
+
+	/** Array of all event handlers, grouped by Event Id. */
+	struct kshark_event_proc_handler	**handlers;
+};
+
+int kshark_update_event_dispatch(struct kshark_data_stream *stream);
+
+void kshark_free_event_dispatch(struct kshark_event_dispatch *dispatch);
+
+/**
+ * @brief Get the Plugin's event handlers for a given event type.
+ *
+ * @param dispatch Event dispatch table of the Data stream. Can be NULL.
+ * @param event_id Event Id.
+ * @param n_handlers Output location for the number of handlers.
+ *
+ * @returns Pointer to the first handler in the array of handlers.
+ */
+static inline struct kshark_event_proc_handler **
+kshark_dispatch_event(const struct kshark_event_dispatch *dispatch,
+		      int event_id, int *n_handlers)
+{
+	unsigned int i;
+
+	if (!dispatch) {
+		*n_handlers = 0;
+		return NULL;
+	}
+
+	i = (unsigned int) (event_id - dispatch->min_id);
+	if (i >= (unsigned int) dispatch->n_ids) {
+		*n_handlers = 0;
+		return NULL;
+	}
+
+	*n_handlers = dispatch->first[i + 1] - dispatch->first[i];
+
+	return &dispatch->handlers[dispatch->first[i]];
+}
+// END of change
+
 /** Plugin's drawing handler structure. */
 struct kshark_draw_handler {
 	/** Pointer to the next Plugin Event handler. */
@@ -0,0 +1,588 @@
+//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+/* Copyright (C) 2026, David Jaromír Šebánek <djsebofficial@gmail.com> */
+
+/**
+ *  @file    libkshark-postings.c
+ *  @brief   Posting lists of trace entries, used for incremental filtering.
+ */
+
+// C
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// KernelShark
+#include "libkshark.h"
+#include "libkshark-tepdata.h"
+#include "libkshark-postings.h"
+
+/*
+ * If more than 1 / POSTINGS_DELTA_DIV of the entries are affected by a change
+ * of the filters, a full pass over the entries is cheaper than refiltering
+ * the affected entries one by one.
+ */
+#define POSTINGS_DELTA_DIV	4
+
+/** The number of slots of a new table of lists. */
+#define POSTINGS_MIN_SLOTS	64
+
+static inline int64_t posting_key(int sd, int id)
+{
+	return ((int64_t) sd << 32) | (uint32_t) id;
+}
+
+static inline size_t posting_slot(int64_t key, size_t mask)
+{
+	uint64_t h = (uint64_t) key * 0x9E3779B97F4A7C15ULL;
+
+	return (h ^ (h >> 32)) & mask;
+}
+
+static inline int posting_id(const struct kshark_entry *entry,
+			     enum kshark_posting_type type)
+{
+	switch (type) {
+	case KS_POSTING_EVENT:
+		return entry->event_id;
+	case KS_POSTING_CPU:
+		return entry->cpu;
+	default:
+		return entry->pid;
+	}
+}
+
+static uint32_t lists_find(const struct kshark_posting_lists *lists,
+			   int64_t key)
+{
+	size_t i;
+
+	if (!lists->slots)
+		return KS_POSTING_NONE;
+
+	for (i = posting_slot(key, lists->mask);
+	     lists->slots[i] != KS_POSTING_NONE;
+	     i = (i + 1) & lists->mask)
+		if (lists->keys[lists->slots[i]] == key)
+			return lists->slots[i];
+
+	return KS_POSTING_NONE;
+}
+
+static void lists_insert_slot(struct kshark_posting_lists *lists, uint32_t l)
+{
+	size_t i = posting_slot(lists->keys[l], lists->mask);
+
+	while (lists->slots[i] != KS_POSTING_NONE)
+		i = (i + 1) & lists->mask;
+
+	lists->slots[i] = l;
+}
+
+/* Double the table of lists. The table is kept at most half full. */
+static int lists_grow(struct kshark_posting_lists *lists)
+{
+	size_t size = lists->slots ? 2 * (lists->mask + 1) : POSTINGS_MIN_SLOTS;
+	uint32_t *slots;
+	int64_t *keys;
+	size_t *start;
+	size_t l;
+
+	keys = realloc(lists->keys, size / 2 * sizeof(*keys));
+	if (!keys)
+		return -ENOMEM;
+
+	lists->keys = keys;
+	start = realloc(lists->start, (size / 2 + 1) * sizeof(*start));
+	if (!start)
+		return -ENOMEM;
+
+	lists->start = start;
+	slots = malloc(size * sizeof(*slots));
+	if (!slots)
+		return -ENOMEM;
+
+	free(lists->slots);
+	lists->slots = slots;
+	lists->mask = size - 1;
+	memset(slots, 0xFF, size * sizeof(*slots));
+	for (l = 0; l < lists->n_lists; ++l)
+		lists_insert_slot(lists, l);
+
+	return 0;
+}
+
+static void lists_free(struct kshark_posting_lists *lists)
+{
+	free(lists->keys);
+	free(lists->start);
+	free(lists->index);
+	free(lists->slots);
+	memset(lists, 0, sizeof(*lists));
+}
+
+/*
+ * Build the lists of one kind. "list_of" is a temporary array, holding the
+ * number of the list of each entry.
+ */
+static int lists_build(struct kshark_posting_lists *lists,
+		       enum kshark_posting_type type,
+		       struct kshark_entry **data, size_t n_entries,
+		       uint32_t *list_of)
+{
+	size_t i, l, total, count, *cursor;
+	int64_t key;
+
+	/* Find the list of each entry and count the entries of each list. */
+	for (i = 0; i < n_entries; ++i) {
+		key = posting_key(data[i]->stream_id,
+				  posting_id(data[i], type));
+
+		l = lists_find(lists, key);
+		if (l == KS_POSTING_NONE) {
+			if ((!lists->slots ||
+			     2 * (lists->n_lists + 1) > lists->mask + 1) &&
+			    lists_grow(lists) < 0)
+				return -ENOMEM;
+
+			l = lists->n_lists++;
+			lists->keys[l] = key;
+			lists->start[l] = 0;
+			lists_insert_slot(lists, l);
+		}
+
+		list_of[i] = l;
+		++lists->start[l];
+	}
+
+	/* Turn the counts into positions. */
+	for (total = l = 0; l < lists->n_lists; ++l) {
+		count = lists->start[l];
+		lists->start[l] = total;
+		total += count;
+	}
+
+	if (!lists->start && lists_grow(lists) < 0)
+		return -ENOMEM;
+
+	lists->start[lists->n_lists] = total;
+
+	lists->index = malloc(n_entries * sizeof(*lists->index));
+	cursor = malloc(lists->n_lists * sizeof(*cursor));
+	if ((n_entries && !lists->index) || (lists->n_lists && !cursor)) {
+		free(cursor);
+		return -ENOMEM;
+	}
+
+	/* The entries are visited in order, so each list gets sorted. */
+	memcpy(cursor, lists->start, lists->n_lists * sizeof(*cursor));
+	for (i = 0; i < n_entries; ++i)
+		lists->index[cursor[list_of[i]]++] = i;
+
+	free(cursor);
+
+	return 0;
+}
+
+/**
+ * @brief Initialize empty posting lists.
+ *
+ * @param postings: Input location for the posting lists.
+ */
+void kshark_postings_init(struct kshark_entry_postings *postings)
+{
+	memset(postings, 0, sizeof(*postings));
+}
+
+/**
+ * @brief Free all memory used by posting lists. The posting lists are left
+ *	  empty and can be built again.
+ *
+ * @param postings: Input location for the posting lists.
+ */
+void kshark_postings_free(struct kshark_entry_postings *postings)
+{
+	int i, sd;
+
+	for (i = 0; i < KS_N_POSTING_TYPES; ++i)
+		lists_free(&postings->lists[i]);
+
+	for (sd = 0; sd < postings->n_applied; ++sd)
+		for (i = 0; i < KS_N_ID_FILTERS; ++i)
+			kshark_id_set_free(&postings->applied[sd].sets[i]);
+
+	free(postings->applied);
+	kshark_postings_init(postings);
+}
+
+/**
+ * @brief Build the posting lists (per event, per CPU and per task) of an
+ *	  array of entries. The entries are assumed to be filtered by the
+ *	  current filters of the session, as they are after loading.
+ *
+ * @param kshark_ctx: Input location for the session context pointer.
+ * @param postings: Input location for the posting lists. Their previous
+ *		    content is released.
+ * @param data: Input location for the trace data. The array must not be
+ *		changed, while the posting lists are used.
+ * @param n_entries: The size of the inputted data.
+ *
+ * @returns Zero on success, or a negative error code on failure. The posting
+ *	    lists are empty on failure.
+ */
+int kshark_postings_build(struct kshark_context *kshark_ctx,
+			  struct kshark_entry_postings *postings,
+			  struct kshark_entry **data, size_t n_entries)
+{
+	uint32_t *list_of;
+	int i, ret;
+
+	kshark_postings_free(postings);
+	if (n_entries >= KS_POSTING_NONE)
+		return -EOVERFLOW;
+
+	list_of = malloc(n_entries * sizeof(*list_of));
+	if (n_entries && !list_of) {
+		ret = -ENOMEM;
+		goto fail;
+	}
+
+	for (i = 0; i < KS_N_POSTING_TYPES; ++i) {
+		ret = lists_build(&postings->lists[i], i, data, n_entries,
+				  list_of);
+		if (ret < 0)
+			goto fail;
+	}
+
+	free(list_of);
+	postings->data = data;
+	postings->size = n_entries;
+
+	return kshark_postings_sync(kshark_ctx, -1, postings);
+
+ fail:
+	fprintf(stderr, "Failed to build the posting lists.\n");
+	free(list_of);
+	kshark_postings_free(postings);
+
+	return ret;
+}
+
+/**
+ * @brief Get the posting list of the entries with a given Id.
+ *
+ * @param postings: Input location for the posting lists.
+ * @param type: The kind of the Id.
+ * @param sd: Data stream identifier.
+ * @param id: The Id (event Id, CPU or PID).
+ * @param n: Output location for the number of entries in the list.
+ *
+ * @returns The sorted indexes of the entries. NULL if there are no entries
+ *	    with this Id.
+ */
+const uint32_t *
+kshark_posting_list(const struct kshark_entry_postings *postings,
+		    enum kshark_posting_type type, int sd, int id, size_t *n)
+{
+	const struct kshark_posting_lists *lists = &postings->lists[type];
+	uint32_t l = lists_find(lists, posting_key(sd, id));
+
+	if (l == KS_POSTING_NONE) {
+		*n = 0;
+		return NULL;
+	}
+
+	*n = lists->start[l + 1] - lists->start[l];
+
+	return lists->index + lists->start[l];
+}
+
+static int postings_sync_stream(struct kshark_context *kshark_ctx,
+				struct kshark_entry_postings *postings,
+				struct kshark_data_stream *stream)
+{
+	struct kshark_posting_filters *applied;
+	int i, ret, sd = stream->stream_id;
+
+	if (sd >= postings->n_applied) {
+		applied = realloc(postings->applied,
+				  (sd + 1) * sizeof(*applied));
+		if (!applied)
+			return -ENOMEM;
+
+		memset(applied + postings->n_applied, 0,
+		       (sd + 1 - postings->n_applied) * sizeof(*applied));
+		postings->applied = applied;
+		postings->n_applied = sd + 1;
+	}
+
+	applied = &postings->applied[sd];
+	applied->valid = false;
+	for (i = 0; i < KS_N_ID_FILTERS; ++i) {
+		ret = kshark_id_set_build(&applied->sets[i],
+					  kshark_get_filter(stream, i));
+		if (ret < 0)
+			return ret;
+	}
+
+	applied->filter_mask = kshark_ctx->filter_mask;
+	applied->valid = true;
+
+	return 0;
+}
+
+/**
+ * @brief Record that the entries of a Data stream are filtered by the current
+ *	  filters of the session. Call this function after filtering all the
+ *	  entries (e.g. with kshark_filter_stream_entries()).
+ *
+ * @param kshark_ctx: Input location for the session context pointer.
+ * @param sd: Data stream identifier. Use a negative value for all streams.
+ * @param postings: Input location for the posting lists.
+ *
+ * @returns Zero on success, or a negative error code on failure. On failure,
+ *	    the next call of kshark_postings_filter() requires a full pass.
+ */
+int kshark_postings_sync(struct kshark_context *kshark_ctx, int sd,
+			 struct kshark_entry_postings *postings)
+{
+	struct kshark_data_stream *stream;
+	int *stream_ids, i, ret = 0;
+
+	if (sd >= 0) {
+		stream = kshark_get_data_stream(kshark_ctx, sd);
+		return stream ?
+		       postings_sync_stream(kshark_ctx, postings, stream) :
+		       -EFAULT;
+	}
+
+	stream_ids = kshark_all_streams(kshark_ctx);
+	if (!stream_ids)
+		return -ENOMEM;
+
+	for (i = 0; i < kshark_ctx->n_streams; ++i) {
+		stream = kshark_get_data_stream(kshark_ctx, stream_ids[i]);
+		if (stream &&
+		    postings_sync_stream(kshark_ctx, postings, stream) < 0)
+			ret = -ENOMEM;
+	}
+
+	free(stream_ids);
+
+	return ret;
+}
+
+/* Add to "changed" the Ids, which are only in one of "set" and "filter". */
+static void changed_ids(const struct kshark_id_set *set,
+			struct kshark_hash_id *filter,
+			struct kshark_hash_id *changed)
+{
+	size_t i, bit;
+	int *ids;
+
+	ids = kshark_hash_ids(filter);
+	for (i = 0; ids && i < filter->count; ++i)
+		if (!kshark_id_set_find(set, ids[i]))
+			kshark_hash_id_add(changed, ids[i]);
+
+	free(ids);
+
+	if (set->bits) {
+		for (bit = 0; bit < set->n_bits; ++bit)
+			if ((set->bits[bit / 64] >> (bit % 64)) & 1 &&
+			    !kshark_hash_id_find(filter, set->min + (int) bit))
+				kshark_hash_id_add(changed, set->min + (int) bit);
+	} else if (set->slots) {
+		for (i = 0; i <= set->mask; ++i)
+			if (set->slots[i] != KS_ID_SET_EMPTY &&
+			    !kshark_hash_id_find(filter, set->slots[i]))
+				kshark_hash_id_add(changed, set->slots[i]);
+	}
+}
+
+/* The filters of each kind of posting lists. */
+static const int posting_show_filter[KS_N_POSTING_TYPES] = {
+	[KS_POSTING_EVENT]	= KS_SHOW_EVENT_FILTER,
+	[KS_POSTING_CPU]	= KS_SHOW_CPU_FILTER,
+	[KS_POSTING_TASK]	= KS_SHOW_TASK_FILTER,
+};
+
+static const int posting_hide_filter[KS_N_POSTING_TYPES] = {
+	[KS_POSTING_EVENT]	= KS_HIDE_EVENT_FILTER,
+	[KS_POSTING_CPU]	= KS_HIDE_CPU_FILTER,
+	[KS_POSTING_TASK]	= KS_HIDE_TASK_FILTER,
+};
+
+/*
+ * Collect the entries, affected by the changes of the filters since they were
+ * last applied. Returns the number of entries, or -EAGAIN if a full pass is
+ * needed.
+ */
+static ssize_t collect_affected(struct kshark_entry_postings *postings,
+				struct kshark_data_stream *stream,
+				struct kshark_entry ***affected)
+{
+	const struct kshark_posting_filters *applied;
+	struct kshark_hash_id *changed = NULL;
+	struct kshark_entry **entries;
+	struct kshark_hash_id *show, *hide;
+	const uint32_t *list;
+	ssize_t n_affected = 0;
+	size_t i, n, j;
+	int t, *ids;
+
+	applied = &postings->applied[stream->stream_id];
+	*affected = NULL;
+
+	for (t = 0; t < KS_N_POSTING_TYPES; ++t) {
+		show = kshark_get_filter(stream, posting_show_filter[t]);
+		hide = kshark_get_filter(stream, posting_hide_filter[t]);
+
+		/*
+		 * If the show filter gets set or unset, the visibility of all
+		 * entries changes.
+		 */
+		if (!applied->sets[posting_show_filter[t]].count !=
+		    !kshark_this_filter_is_set(show))
+			goto full;
+
+		kshark_hash_id_free(changed);
+		changed = kshark_hash_id_alloc(KS_FILTER_HASH_NBITS);
+		if (!changed)
+			goto full;
+
+		changed_ids(&applied->sets[posting_show_filter[t]], show,
+			    changed);
+		changed_ids(&applied->sets[posting_hide_filter[t]], hide,
+			    changed);
+		if (!changed->count)
+			continue;
+
+		ids = kshark_hash_ids(changed);
+		if (!ids)
+			goto full;
+
+		for (i = 0; i < changed->count; ++i) {
+			list = kshark_posting_list(postings, t,
+						   stream->stream_id, ids[i],
+						   &n);
+			if (n_affected + n > postings->size / POSTINGS_DELTA_DIV) {
+				free(ids);
+				goto full;
+			}
+
+			if (!n)
+				continue;
+
+			entries = realloc(*affected, (n_affected + n) *
+						     sizeof(*entries));
+			if (!entries) {
+				free(ids);
+				goto full;
+			}
+
+			*affected = entries;
+
+			for (j = 0; j < n; ++j)
+				(*affected)[n_affected++] =
+					postings->data[list[j]];
+		}
+
+		free(ids);
+	}
+
+	kshark_hash_id_free(changed);
+
+	return n_affected;
+
+ full:
+	kshark_hash_id_free(changed);
+	free(*affected);
+	*affected = NULL;
+
+	return -EAGAIN;
+}
+
+/**
+ * @brief Refilter the entries of a Data stream, after a change of its Id
+ *	  filters. Only the entries with the Ids, added to or removed from
+ *	  the filters since they were last applied, are refiltered (together
+ *	  with the advanced filter, if set). If the change affects too many
+ *	  entries (e.g. a show filter gets set or unset), nothing is done and
+ *	  -EAGAIN is returned. The entries then have to be filtered in full,
+ *	  followed by kshark_postings_sync().
+ *
+ * @param kshark_ctx: Input location for the session context pointer.
+ * @param sd: Data stream identifier.
+ * @param postings: Input location for the posting lists.
+ * @param cpus: Output location for the CPUs, whose entries changed their
+ *		visibility in the graph. Can be NULL.
+ *
+ * @returns Zero if the entries were refiltered, -EAGAIN if a full pass is
+ *	    needed, or another negative error code on failure.
+ */
+int kshark_postings_filter(struct kshark_context *kshark_ctx, int sd,
+			   struct kshark_entry_postings *postings,
+			   struct kshark_hash_id *cpus)
+{
+	struct kshark_data_stream *stream;
+	struct kshark_entry **affected;
+	bool adv_filter_is_set;
+	uint8_t *graph_visible;
+	ssize_t n, i;
+
+	stream = kshark_get_data_stream(kshark_ctx, sd);
+	if (!stream)
+		return -EFAULT;
+
+	/* The posting lists are not built (or freed, as no longer valid). */
+	if (!postings->data)
+		return -EAGAIN;
+
+	if (sd >= postings->n_applied || !postings->applied[sd].valid ||
+	    postings->applied[sd].filter_mask != kshark_ctx->filter_mask)
+		return -EAGAIN;
+
+	n = collect_affected(postings, stream, &affected);
+	if (n < 0)
+		return n;
+
+	graph_visible = malloc(n);
+	if (n && !graph_visible) {
+		free(affected);
+		return -EAGAIN;
+	}
+
+	kshark_update_filter_sets(kshark_ctx, sd);
+	for (i = 0; i < n; ++i) {
+		graph_visible[i] = affected[i]->visible &
+				   KS_GRAPH_VIEW_FILTER_MASK;
+
+		/*
+		 * Start with an entry which is visible everywhere. Keep the
+		 * original value of the PLUGIN_UNTOUCHED bit flag.
+		 */
+		affected[i]->visible |= 0xFF & ~KS_PLUGIN_UNTOUCHED_MASK;
+		kshark_apply_filters(kshark_ctx, stream, affected[i]);
+	}
+
+	adv_filter_is_set = kshark_is_tep(stream) &&
+			    kshark_tep_filter_is_set(stream);
+	if (adv_filter_is_set)
+		kshark_tep_apply_adv_filter(kshark_ctx, stream, affected, n);
+
+	for (i = 0; cpus && i < n; ++i)
+		if ((affected[i]->visible & KS_GRAPH_VIEW_FILTER_MASK) !=
+		    graph_visible[i])
+			kshark_hash_id_add(cpus, affected[i]->cpu);
+
+	free(graph_visible);
+	free(affected);
+
+	stream->filter_is_applied = kshark_filter_is_set(kshark_ctx, sd) ||
+				    adv_filter_is_set;
+
+	return postings_sync_stream(kshark_ctx, postings, stream) < 0 ?
+	       -ENOMEM : 0;
+}
+// END of change
@@ -0,0 +1,126 @@
+//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+/* Copyright (C) 2026, David Jaromír Šebánek <djsebofficial@gmail.com> */
+
+/**
+ *  @file    libkshark-postings.h
+ *  @brief   Posting lists of trace entries, used for incremental filtering.
+ */
+
+#ifndef _LIB_KSHARK_POSTINGS_H
+#define _LIB_KSHARK_POSTINGS_H
+
+// KernelShark
+#include "libkshark.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of a list, used when there is no such list. */
+#define KS_POSTING_NONE		UINT32_MAX
+
+/** The kinds of posting lists. */
+enum kshark_posting_type {
+	/** Lists of the entries of each event. */
+	KS_POSTING_EVENT,
+
+	/** Lists of the entries of each CPU. */
+	KS_POSTING_CPU,
+
+	/** Lists of the entries of each task. */
+	KS_POSTING_TASK,
+
+	/** The number of kinds of posting lists. */
+	KS_N_POSTING_TYPES,
+};
+
+/**
+ * Posting lists of one kind. For each pair of Data stream and Id (e.g. PID),
+ * there is a sorted list of the indexes of the entries with this Id. All
+ * lists are stored one after another in a single array.
+ */
+struct kshark_posting_lists {
+	/**
+	 * The key of each list. The upper 32 bits are the Data stream
+	 * identifier and the lower 32 bits are the Id.
+	 */
+	int64_t		*keys;
+
+	/**
+	 * Position of the first index of each list in "index". There is one
+	 * extra element, holding the total number of indexes.
+	 */
+	size_t		*start;
+
+	/** Indexes of the entries, list after list. */
+	uint32_t	*index;
+
+	/** The number of lists. */
+	size_t		n_lists;
+
+	/** Open addressing table of the numbers of the lists. */
+	uint32_t	*slots;
+
+	/** The number of slots of the table minus one. */
+	size_t		mask;
+};
+
+/** Id filters of a Data stream, as last applied to the entries. */
+struct kshark_posting_filters {
+	/** True if the entries of the stream are filtered by these filters. */
+	bool			valid;
+
+	/** The filter mask of the session, used when filtering. */
+	uint8_t			filter_mask;
+
+	/** The Id filters. */
+	struct kshark_id_set	sets[KS_N_ID_FILTERS];
+};
+
+/**
+ * Posting lists of an array of entries, together with the filters last
+ * applied to these entries. The entries can be refiltered by touching only
+ * the entries with the Ids, added to or removed from the filters.
+ */
+struct kshark_entry_postings {
+	/** The entries. */
+	struct kshark_entry		**data;
+
+	/** The number of entries. */
+	size_t				size;
+
+	/** The posting lists of each kind. */
+	struct kshark_posting_lists	lists[KS_N_POSTING_TYPES];
+
+	/** Applied filters of each Data stream, indexed by its identifier. */
+	struct kshark_posting_filters	*applied;
+
+	/** The number of elements of "applied". */
+	int				n_applied;
+};
+
+void kshark_postings_init(struct kshark_entry_postings *postings);
+
+void kshark_postings_free(struct kshark_entry_postings *postings);
+
+int kshark_postings_build(struct kshark_context *kshark_ctx,
+			  struct kshark_entry_postings *postings,
+			  struct kshark_entry **data, size_t n_entries);
+
+const uint32_t *
+kshark_posting_list(const struct kshark_entry_postings *postings,
+		    enum kshark_posting_type type, int sd, int id, size_t *n);
+
+int kshark_postings_sync(struct kshark_context *kshark_ctx, int sd,
+			 struct kshark_entry_postings *postings);
+
+int kshark_postings_filter(struct kshark_context *kshark_ctx, int sd,
+			   struct kshark_entry_postings *postings,
+			   struct kshark_hash_id *cpus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _LIB_KSHARK_POSTINGS_H
+// END of change
@@ -0,0 +1,331 @@
+//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+/* Copyright (C) 2026, David Jaromír Šebánek <djsebofficial@gmail.com> */
+
+/**
+ *  @file    libkshark-record-cache.c
+ *  @brief   Bounded LRU cache of trace records, keyed by their file offsets.
+ */
+
+// C
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+// trace-cmd
+#include <trace-cmd.h>
+
+// KernelShark
+#include "libkshark-tepdata.h"
+
+/** Number of bits of the hash of the record cache. */
+#define KS_RECORD_CACHE_HASH_NBITS	13
+
+/** A copy of a record, kept in the record cache. */
+struct cached_record {
+	/** The record. Its data points to "data" below. */
+	struct tep_record	record;
+
+	/** Next record in the same hash bucket. */
+	struct cached_record	*hash_next;
+
+	/** Previous (more recently used) record. */
+	struct cached_record	*lru_prev;
+
+	/** Next (less recently used) record. */
+	struct cached_record	*lru_next;
+
+	/** The number of users of the record. */
+	int			ref;
+
+	/** Set if the record is evicted while still in use. */
+	bool			evicted;
+
+	/** The data of the record. */
+	char			data[];
+};
+
+/** Bounded LRU cache of records, read by their file offsets. */
+struct kshark_record_cache {
+	/** Hash buckets, keyed by the file offset of the record. */
+	struct cached_record	*hash[1 << KS_RECORD_CACHE_HASH_NBITS];
+
+	/** The most recently used record. */
+	struct cached_record	*lru_head;
+
+	/** The least recently used record. */
+	struct cached_record	*lru_tail;
+
+	/** The maximum number of records in the cache. */
+	size_t			capacity;
+
+	/** The number of records in the cache. */
+	size_t			count;
+
+	/** The number of reads served from the cache. */
+	size_t			n_hits;
+
+	/** The number of reads not found in the cache. */
+	size_t			n_misses;
+
+	/** Lock protecting the cache. */
+	pthread_mutex_t		lock;
+};
+
+static inline struct cached_record **
+record_cache_bucket(struct kshark_record_cache *cache, uint64_t offset)
+{
+	/* Fibonacci hashing spreads the (8-byte aligned) offsets. */
+	return &cache->hash[(offset * 0x9E3779B97F4A7C15ULL) >>
+			    (64 - KS_RECORD_CACHE_HASH_NBITS)];
+}
+
+static void record_cache_lru_unlink(struct kshark_record_cache *cache,
+				    struct cached_record *cr)
+{
+	if (cr->lru_prev)
+		cr->lru_prev->lru_next = cr->lru_next;
+	else
+		cache->lru_head = cr->lru_next;
+
+	if (cr->lru_next)
+		cr->lru_next->lru_prev = cr->lru_prev;
+	else
+		cache->lru_tail = cr->lru_prev;
+}
+
+static void record_cache_lru_push(struct kshark_record_cache *cache,
+				  struct cached_record *cr)
+{
+	cr->lru_prev = NULL;
+	cr->lru_next = cache->lru_head;
+	if (cache->lru_head)
+		cache->lru_head->lru_prev = cr;
+	else
+		cache->lru_tail = cr;
+
+	cache->lru_head = cr;
+}
+
+static struct cached_record *
+record_cache_find(struct kshark_record_cache *cache, uint64_t offset)
+{
+	struct cached_record *cr = *record_cache_bucket(cache, offset);
+
+	while (cr && cr->record.offset != offset)
+		cr = cr->hash_next;
+
+	return cr;
+}
+
+/* Remove the least recently used record. Call under the cache lock. */
+static void record_cache_evict(struct kshark_record_cache *cache)
+{
+	struct cached_record *cr = cache->lru_tail, **next;
+
+	record_cache_lru_unlink(cache, cr);
+
+	next = record_cache_bucket(cache, cr->record.offset);
+	while (*next != cr)
+		next = &(*next)->hash_next;
+
+	*next = cr->hash_next;
+	--cache->count;
+
+	/* A record still in use gets freed by its last user. */
+	if (cr->ref)
+		cr->evicted = true;
+	else
+		free(cr);
+}
+
+/* Copy a record read from the file into a new cached record. */
+static struct cached_record *cached_record_alloc(const struct tep_record *rec)
+{
+	struct cached_record *cr = calloc(1, sizeof(*cr) + rec->size);
+
+	if (!cr)
+		return NULL;
+
+	cr->record.ts = rec->ts;
+	cr->record.offset = rec->offset;
+	cr->record.missed_events = rec->missed_events;
+	cr->record.record_size = rec->record_size;
+	cr->record.size = rec->size;
+	cr->record.cpu = rec->cpu;
+	cr->record.data = cr->data;
+	memcpy(cr->data, rec->data, rec->size);
+
+	return cr;
+}
+
+/**
+ * @brief Create an empty record cache.
+ *
+ * @param capacity: The maximum number of records kept in the cache.
+ *
+ * @returns The cache, or NULL on failure. Free it with
+ *	    kshark_record_cache_free().
+ */
+struct kshark_record_cache *kshark_record_cache_alloc(size_t capacity)
+{
+	struct kshark_record_cache *cache;
+
+	if (!capacity)
+		return NULL;
+
+	cache = calloc(1, sizeof(*cache));
+	if (!cache)
+		return NULL;
+
+	if (pthread_mutex_init(&cache->lock, NULL) != 0) {
+		free(cache);
+		return NULL;
+	}
+
+	cache->capacity = capacity;
+
+	return cache;
+}
+
+/**
+ * @brief Free a record cache. All records, obtained from the cache, must be
+ *	  released before this.
+ *
+ * @param cache: Input location for the cache.
+ */
+void kshark_record_cache_free(struct kshark_record_cache *cache)
+{
+	if (!cache)
+		return;
+
+	while (cache->lru_tail)
+		record_cache_evict(cache);
+
+	pthread_mutex_destroy(&cache->lock);
+	free(cache);
+}
+
+/**
+ * @brief Get a record from the cache. A record found in the cache becomes
+ *	  the most recently used one.
+ *
+ * @param cache: Input location for the cache.
+ * @param offset: The offset of the record into the trace file.
+ *
+ * @returns The record, or NULL if it is not in the cache. Release a record,
+ *	    found in the cache, with kshark_record_cache_put().
+ */
+struct tep_record *kshark_record_cache_get(struct kshark_record_cache *cache,
+					   uint64_t offset)
+{
+	struct cached_record *cr;
+
+	pthread_mutex_lock(&cache->lock);
+
+	cr = record_cache_find(cache, offset);
+	if (!cr) {
+		++cache->n_misses;
+		pthread_mutex_unlock(&cache->lock);
+
+		return NULL;
+	}
+
+	++cache->n_hits;
+	++cr->ref;
+	record_cache_lru_unlink(cache, cr);
+	record_cache_lru_push(cache, cr);
+
+	pthread_mutex_unlock(&cache->lock);
+
+	return &cr->record;
+}
+
+/**
+ * @brief Add a copy of a record to the cache, as the most recently used
+ *	  record. If the cache is full, the least recently used record is
+ *	  evicted.
+ *
+ * @param cache: Input location for the cache.
+ * @param rec: Input location for the record. The cache keeps a copy, so the
+ *	       caller still owns the record.
+ *
+ * @returns The cached copy of the record, or NULL on failure. If another
+ *	    thread has added a record with the same offset in the meantime,
+ *	    this record is returned instead. Release the returned record with
+ *	    kshark_record_cache_put().
+ */
+struct tep_record *kshark_record_cache_add(struct kshark_record_cache *cache,
+					   const struct tep_record *rec)
+{
+	struct cached_record *cr, *found, **bucket;
+
+	cr = cached_record_alloc(rec);
+	if (!cr)
+		return NULL;
+
+	cr->ref = 1;
+
+	pthread_mutex_lock(&cache->lock);
+
+	found = record_cache_find(cache, rec->offset);
+	if (found) {
+		++found->ref;
+		pthread_mutex_unlock(&cache->lock);
+		free(cr);
+
+		return &found->record;
+	}
+
+	bucket = record_cache_bucket(cache, rec->offset);
+	cr->hash_next = *bucket;
+	*bucket = cr;
+	record_cache_lru_push(cache, cr);
+	if (++cache->count > cache->capacity)
+		record_cache_evict(cache);
+
+	pthread_mutex_unlock(&cache->lock);
+
+	return &cr->record;
+}
+
+/**
+ * @brief Release a record, obtained with kshark_record_cache_get() or
+ *	  kshark_record_cache_add(). A record, evicted while in use, is freed
+ *	  by its last user.
+ *
+ * @param cache: Input location for the cache.
+ * @param rec: Input location for the record.
+ */
+void kshark_record_cache_put(struct kshark_record_cache *cache,
+			     struct tep_record *rec)
+{
+	struct cached_record *cr = (struct cached_record *) rec;
+	bool evicted;
+
+	if (!rec)
+		return;
+
+	pthread_mutex_lock(&cache->lock);
+	evicted = (--cr->ref == 0) && cr->evicted;
+	pthread_mutex_unlock(&cache->lock);
+
+	if (evicted)
+		free(cr);
+}
+
+/**
+ * @brief Get the statistics of a record cache.
+ *
+ * @param cache: Input location for the cache.
+ * @param stats: Output location for the statistics.
+ */
+void kshark_record_cache_get_stats(struct kshark_record_cache *cache,
+				   struct kshark_tep_record_cache_stats *stats)
+{
+	pthread_mutex_lock(&cache->lock);
+	stats->n_hits = cache->n_hits;
+	stats->n_misses = cache->n_misses;
+	stats->n_records = cache->count;
+	pthread_mutex_unlock(&cache->lock);
+}
+// END of change
@@ -19,6 +19,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+#include <unistd.h>
+// END of change
 
 // trace-cmd
 #include <trace-cmd.h>
@@ -28,6 +31,9 @@
 #include "libkshark-plugin.h"
 #include "libkshark-tepdata.h"
 #include "libkshark-couplebreak.h"
+//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+#include "libkshark-compact.h"
+// END of change
 
 static __thread struct trace_seq seq;
 
@@ -39,6 +45,21 @@ static bool init_thread_seq(void)
 	return seq.buffer != NULL;
 }
 
+//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+/**
+ * @brief Release the trace sequence of the calling thread (if any). Call this
+ *	  before the exit of a thread that has been loading (or otherwise
+ *	  processing) FTRACE data.
+ */
+void kshark_tep_release_thread_seq(void)
+{
+	if (seq.buffer) {
+		trace_seq_destroy(&seq);
+		seq.buffer = NULL;
+	}
+}
+// END of change
+
 /** Structure for handling all unique attributes of the FTRACE data. */
 struct tepdata_handle {
 	/** Page event used to parse the page. */
@@ -61,6 +82,30 @@ struct tepdata_handle {
 
 	/** Pointer to the sched_switch_comm_field format descriptor. */
 	struct tep_format_field	*sched_switch_comm_field;
+
+	//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+	/** The unique Id of the sched_waking event. */
+	int sched_waking_event_id;
+
+	/** Pointer to the sched_waking "pid" field format descriptor. */
+	struct tep_format_field	*sched_waking_pid_field;
+
+	/** Pointer to the sched_waking "target_cpu" field format descriptor. */
+	struct tep_format_field	*sched_waking_target_cpu_field;
+	// END of change
+
+	//NOTE: Changed here. (READ INPUTS) (2026-10-17)
+	/**
+	 * Spare input handles, used to read single records. Protected by
+	 * the input mutex of the stream.
+	 */
+	struct read_input	*spare_inputs;
+	// END of change
+
+	//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+	/** Cache of the records read by their offsets. */
+	struct kshark_record_cache	*record_cache;
+	// END of change
 };
 
 static inline int get_tepdate_handle(struct kshark_data_stream *stream,
@@ -152,6 +197,20 @@ static struct tep_format_field *get_sched_comm(struct kshark_data_stream *stream
 	return tep_handle->sched_switch_comm_field;
 }
 
+//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+static int get_sched_waking_id(struct kshark_data_stream *stream)
+{
+	struct tepdata_handle *tep_handle;
+	int ret;
+
+	ret = get_tepdate_handle(stream, &tep_handle);
+	if (ret < 0)
+		return ret;
+
+	return tep_handle->sched_waking_event_id;
+}
+// END of change
+
 static void set_entry_values(struct kshark_data_stream *stream,
 			     struct tep_record *record,
 			     struct kshark_entry *entry)
@@ -266,8 +325,9 @@ enum rec_type {
 	REC_ENTRY,
 };
 
+//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
 static void free_rec_list(struct rec_list **rec_list, int n_cpus,
-			  enum rec_type type)
+			  enum rec_type type, struct kshark_mem_arena *arena)
 {
 	struct rec_list *temp_rec;
 	int cpu;
@@ -278,12 +338,181 @@ static void free_rec_list(struct rec_list **rec_list, int n_cpus,
 			rec_list[cpu] = temp_rec->next;
 			if (type == REC_RECORD)
 				tracecmd_free_record(temp_rec->rec);
-			free(temp_rec);
+
+			/* The nodes owned by an arena are released with it. */
+			if (!arena)
+				free(temp_rec);
 		}
 	}
 	free(rec_list);
 }
 
+static inline struct rec_list *alloc_rec(struct kshark_mem_arena *arena)
+{
+	if (arena)
+		return kshark_arena_malloc(arena, sizeof(struct rec_list));
+
+	return calloc(1, sizeof(struct rec_list));
+}
+// END of change
+
+//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+/**
+ * @brief Loading state of a single CPU buffer. The state is kept between the
+ * time windows the data stream is loaded in.
+ */
+struct cpu_load_state {
+	/**
+	 * Location for the next node of the per-CPU record list. NULL until
+	 * the loading of the CPU buffer starts.
+	 */
+	struct rec_list		**tail;
+
+	/** The first record beyond the time window loaded last. */
+	struct tep_record	*pending;
+
+	/** The number of nodes in the per-CPU record list. */
+	ssize_t			count;
+
+	/** File offset of the first record of the CPU buffer. */
+	uint64_t		first_offset;
+
+	/** File offset just past the last record of the CPU buffer. */
+	uint64_t		end_offset;
+
+	/** File offset of the last record read. */
+	uint64_t		offset;
+
+	/** The number of time windows loaded so far. */
+	int			n_windows;
+
+	/** Set once the whole CPU buffer is read. */
+	bool			done;
+
+	//NOTE: Changed here. (WINDOWED LOAD) (2026-10-17)
+	/**
+	 * File offset, at which the reading of the CPU buffer stops. The
+	 * record at this offset is not loaded. 0 if there is no such limit.
+	 */
+	uint64_t		stop_offset;
+	// END of change
+};
+// END of change
+
+//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+/**
+ * @brief State shared by all workers loading the CPU buffers of a data
+ * stream. If the loading is sequential, the only "worker" is the calling
+ * thread.
+ */
+struct records_loader {
+	/** KernelShark context. */
+	struct kshark_context		*kshark_ctx;
+
+	/** Data stream being loaded. */
+	struct kshark_data_stream	*stream;
+
+	/** The type of the record lists being created. */
+	enum rec_type			type;
+
+	/** Advanced event filter. Used only when loading entries. */
+	struct tep_event_filter		*adv_filter;
+
+	/** The unique Id of the sched_waking event. */
+	int				sched_waking_id;
+
+	/** Output array of per-CPU record lists. */
+	struct rec_list			**cpu_list;
+
+	/**
+	 * Lock serializing all modifications of the Page event object. NULL
+	 * if the loading is sequential. The plugin actions are serialized by
+	 * kshark_plugin_actions().
+	 */
+	pthread_mutex_t			*lock;
+
+	/** The next CPU buffer waiting to be picked by a worker. */
+	int				next_cpu;
+
+	/** Set when one of the workers fails. */
+	bool				failed;
+
+	//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+	/**
+	 * Memory arena owning the record list nodes. NULL if the nodes are
+	 * allocated individually.
+	 */
+	struct kshark_mem_arena		*arena;
+	// END of change
+
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	/** Loading state of each CPU buffer. */
+	struct cpu_load_state		*cpu_state;
+
+	/**
+	 * The number of consecutive time windows the stream is loaded in.
+	 * 1 if the progress of the loading is not reported.
+	 */
+	int				n_windows;
+
+	/** The number of workers, when loading in time windows. */
+	int				n_workers;
+
+	/** Set once all workers are started, when loading in time windows. */
+	bool				go;
+
+	/** Signaled (under "lock") when "go" gets set. */
+	pthread_cond_t			*go_cond;
+
+	/** The timestamp of the first record (not calibrated). */
+	int64_t				ts_first;
+
+	/** The timestamp of the last record (not calibrated). */
+	int64_t				ts_last;
+	// END of change
+
+	//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+	/**
+	 * Set if the entries do not outlive the loading. The plugin actions
+	 * are not run, because the plugins may keep pointers to the entries.
+	 */
+	bool				no_plugin_actions;
+	// END of change
+};
+
+/** A worker decoding CPU buffers, using its own trace data input handle. */
+struct records_worker {
+	/** Shared state of the loading. */
+	struct records_loader	*loader;
+
+	/** The thread of the worker. */
+	pthread_t		thread;
+
+	/** Input handle for the top buffer of the trace data file. */
+	struct tracecmd_input	*top_input;
+
+	/** Input handle for the buffer of the data stream being loaded. */
+	struct tracecmd_input	*input;
+
+	/** Hash of the PIDs found by this worker. */
+	struct kshark_hash_id	*tasks;
+
+	//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+	/** Memory arena of this worker. NULL if the loader has no arena. */
+	struct kshark_mem_arena	*arena;
+	// END of change
+
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	/**
+	 * Index of the worker. When loading in time windows, the worker
+	 * loads the CPU buffers "index", "index + n_workers", etc.
+	 */
+	int			index;
+	// END of change
+};
+// END of change
+
+
 //NOTE: Changed here. (COUPLEBREAK) (2025-03-29)
 /**
  * @brief Record a new couplebreak event type, if it was not yet
@@ -300,11 +529,18 @@ static void record_new_couplebreak_event_type(struct kshark_data_stream *stream,
 	// for this event type.
 
 	const int flag_pos = couplebreak_id_to_flag_pos(couplebreak_evt_id);
-	if (!(stream->couplebreak_evts_flags & (1 << flag_pos))) {
-		stream->n_couplebreak_evts++;
-		stream->couplebreak_evts_flags |= (1 << flag_pos);
-	}
-} 
+	//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+	// The CPU buffers may be decoded concurrently, hence test and set the
+	// flag atomically, so that every event type is counted exactly once.
+	const int flag = 1 << flag_pos;
+	if (__atomic_load_n(&stream->couplebreak_evts_flags, __ATOMIC_RELAXED) & flag)
+		return;
+
+	if (!(__atomic_fetch_or(&stream->couplebreak_evts_flags, flag,
+				__ATOMIC_RELAXED) & flag))
+		__atomic_fetch_add(&stream->n_couplebreak_evts, 1, __ATOMIC_RELAXED);
+	// END of change
+}
 // END of change
 
 //NOTE: Changed here. (COUPLEBREAK) (2025-03-21)
@@ -392,19 +628,23 @@ static struct kshark_entry *couplebreak_create_swt(struct kshark_data_stream *st
 
 	/* Make the owner pid the pid of the task to be woken up. */
 	// The approach below is used in plugins, so it is true and tested.
-	
-	struct tep_event *sched_waking_event = NULL;
-	define_wakeup_event(kshark_get_tep(stream), &sched_waking_event);
+
+	//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+	// The field descriptors are looked up once, when the stream is
+	// initialized, instead of doing it for every record.
+	struct tepdata_handle *tep_handle = NULL;
+	get_tepdate_handle(stream, &tep_handle);
 
 	unsigned long long waked_pid_val;
-	struct tep_format_field *sched_waking_pid_field = tep_find_any_field(sched_waking_event, "pid");
+	struct tep_format_field *sched_waking_pid_field = tep_handle->sched_waking_pid_field;
 	int pid_succs = tep_read_number_field(sched_waking_pid_field, record->data, &waked_pid_val);
 	// Set the target entry's PID to either the woken up task or, if that failed, to the
 	// PID of the origin entry. 
 	entry->pid = (pid_succs == 0) ? (int32_t)waked_pid_val : origin_entry->pid;
 
 	unsigned long long waked_cpu_val;
-	struct tep_format_field *sched_waking_target_cpu_field = tep_find_any_field(sched_waking_event, "target_cpu");
+	struct tep_format_field *sched_waking_target_cpu_field = tep_handle->sched_waking_target_cpu_field;
+	// END of change
 	int tcpu_succs = tep_read_number_field(sched_waking_target_cpu_field, record->data, &waked_cpu_val);
 	// This field should hopefully change to the actual CPU on which the task will run after
 	// all events have been loaded (and can be easily accessed by time).
@@ -435,6 +675,54 @@ typedef struct kshark_entry* (*custom_entry_creation_func)(
 	struct kshark_entry *origin_entry);
 // END of change
 
+//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+/**
+ * @brief Post-process the content of an entry during the loading of the
+ * data. The plugin actions are skipped, if the entries do not outlive the
+ * loading.
+ */
+static void load_postprocess_entry(const struct records_loader *loader,
+				   struct tep_record *rec,
+				   struct kshark_entry *entry)
+{
+	if (loader->no_plugin_actions)
+		kshark_calib_entry(loader->stream, entry);
+	else
+		kshark_postprocess_entry(loader->stream, rec, entry);
+}
+// END of change
+
+//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+/**
+ * @brief Check if a record is rejected by the advanced event filter during
+ * the loading of the data.
+ *
+ * @param adv_filter Advanced event filter.
+ * @param rec Trace event processing record with values from the trace.
+ * @param lock Loader lock. NULL if the loading is sequential.
+ * @return True if the filter is set and the record does not match it.
+ */
+static bool load_adv_filter_rejects(struct tep_event_filter *adv_filter,
+				    struct tep_record *rec,
+				    pthread_mutex_t *lock)
+{
+	bool rejected;
+
+	if (!adv_filter || !adv_filter->filters)
+		return false;
+
+	if (lock)
+		pthread_mutex_lock(lock);
+
+	rejected = tep_filter_match(adv_filter, rec) != FILTER_MATCH;
+
+	if (lock)
+		pthread_mutex_unlock(lock);
+
+	return rejected;
+}
+// END of change
+
 //NOTE: Changed here. ("COUPLEBREAK") (2025-03-21)
 /**
  * @brief Create a custom entry with a KernelShark context, data stream,
@@ -451,6 +739,7 @@ typedef struct kshark_entry* (*custom_entry_creation_func)(
  * @param adv_filter Advanced event filter.
  * @param count Count of current entries in the stream.
  * @param create_custom_func Function to create the custom entry.
+ * @param worker The worker loading the record.
  * @return 0 on successful creation of the custom entry, otherwise 1.
  * @note The function is currently used only to create custom entries for
  * couplebreak events.
@@ -463,7 +752,8 @@ static int create_custom_entry(struct kshark_context *kshark_ctx,
 							   struct rec_list * *temp_rec, // Need to update actual value
 							   struct tep_event_filter *adv_filter,
 							   ssize_t *count,
-							   custom_entry_creation_func create_custom_func)
+							   custom_entry_creation_func create_custom_func,
+							   struct records_worker *worker)
 {
 	const int FAIL = 1;
 
@@ -471,7 +761,9 @@ static int create_custom_entry(struct kshark_context *kshark_ctx,
 	*temp_next = &((*temp_rec)->next);
 
 	// Allocate a new rec_list node and continue.
-	*(*temp_next) = (*temp_rec) = calloc(1, sizeof(*(*temp_rec)));
+	//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+	*(*temp_next) = (*temp_rec) = alloc_rec(worker->arena);
+	// END of change
 	if (!(*temp_rec))
 		return FAIL;
 
@@ -482,8 +774,9 @@ static int create_custom_entry(struct kshark_context *kshark_ctx,
 	struct kshark_entry *target_entry = create_custom_func(stream,
 		*temp_rec, rec, entry);
 
+	//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
 	/* Apply time calibration. */
-	kshark_postprocess_entry(stream, rec, target_entry);
+	load_postprocess_entry(worker->loader, rec, target_entry);
 
 	target_entry->stream_id = stream->stream_id;
 
@@ -491,9 +784,9 @@ static int create_custom_entry(struct kshark_context *kshark_ctx,
 	kshark_apply_filters(kshark_ctx, stream, target_entry);
 	
 	/* Apply advanced event filtering. */
-	if (adv_filter && adv_filter->filters &&
-		tep_filter_match(adv_filter, rec) != FILTER_MATCH)
+	if (load_adv_filter_rejects(adv_filter, rec, worker->loader->lock))
 		unset_event_filter_flag(kshark_ctx, target_entry);
+	// END of change
 
 	*count = (*count) + 1;
 
@@ -505,37 +798,73 @@ static int create_custom_entry(struct kshark_context *kshark_ctx,
 // Change is just that this static function was moved, it is
 // originally a part of KernelShark, but there was a need to see it sooner
 // during compilation.
-static int pick_next_cpu(struct rec_list **rec_list, int n_cpus,
-	enum rec_type type)
+//NOTE: Changed here. (HEAP MERGE) (2026-10-17)
+static inline int64_t rec_ts(struct rec_list *rec, enum rec_type type)
+{
+	return (type == REC_RECORD) ? (int64_t) rec->rec->ts : rec->entry.ts;
+}
+
+/**
+ * @brief Initialize a merge heap of the per-CPU record lists.
+ *
+ * @param heap Output location for the merge heap.
+ * @param rec_list Array of per-CPU record lists.
+ * @param n_cpus The number of CPUs.
+ * @param type The type of the record lists.
+ * @return True on success, false on memory allocation fail.
+ */
+static bool init_cpu_heap(struct kshark_merge_heap *heap,
+			  struct rec_list **rec_list, int n_cpus,
+			  enum rec_type type)
 {
-	uint64_t ts = 0;
-	uint64_t rec_ts;
-	int next_cpu = -1;
 	int cpu;
 
-	for (cpu = 0; cpu < n_cpus; ++cpu) {
-		if (!rec_list[cpu])
-			continue;
+	if (!kshark_merge_heap_init(heap, n_cpus))
+		return false;
 
-		switch (type) {
-		case REC_RECORD:
-			rec_ts = rec_list[cpu]->rec->ts;
-			break;
-		case REC_ENTRY:
-			rec_ts = rec_list[cpu]->entry.ts;
-			break;
-		default:
-			return -1;
-		}
-		if (!ts || rec_ts < ts) {
-			ts = rec_ts;
-			next_cpu = cpu;
+	for (cpu = 0; cpu < n_cpus; ++cpu)
+		if (rec_list[cpu])
+			kshark_merge_heap_push(heap, cpu,
+					       rec_ts(rec_list[cpu], type));
+
+	return true;
+}
+
+/**
+ * @brief Get the CPU, the record list of which starts with the earliest
+ * record. The caller consumes this record by advancing the head of the
+ * list. The heap is updated accordingly on the next call, which makes
+ * the cost of each pick O(log n_cpus).
+ *
+ * @param heap Merge heap of the per-CPU record lists.
+ * @param rec_list Array of per-CPU record lists.
+ * @param type The type of the record lists.
+ * @return CPU Id, or -1 if all lists are empty.
+ */
+static int pick_next_cpu(struct kshark_merge_heap *heap,
+			 struct rec_list **rec_list,
+			 enum rec_type type)
+{
+	int64_t ts;
+	int cpu;
+
+	while ((cpu = kshark_merge_heap_top(heap)) >= 0) {
+		if (!rec_list[cpu]) {
+			kshark_merge_heap_pop(heap);
+			continue;
 		}
+
+		ts = rec_ts(rec_list[cpu], type);
+		if (ts == heap->nodes[0].ts)
+			return cpu;
+
+		kshark_merge_heap_replace_top(heap, ts);
 	}
 
-	return next_cpu;
+	return -1;
 }
 // END of change
+// END of change
 
 //NOTE: Changed here. (COUPLEBREAK) (2025-03-21)
 /**
@@ -550,123 +879,192 @@ static int pick_next_cpu(struct rec_list **rec_list, int n_cpus,
  * @param sorted_entries Output array of pointers to kshark_entry objects,
  * which will be filled with the entries from the rec_list and sorted by time.
  * @param total Total number of entries to be sorted.
+ * @return 0 on success, -ENOMEM on memory allocation fail.
  */
-static inline void fill_sorted_entries(struct kshark_data_stream *stream,
+static inline int fill_sorted_entries(struct kshark_data_stream *stream,
 	struct rec_list **rec_list, struct kshark_entry **sorted_entries, ssize_t total)
 {
 	enum rec_type type = REC_ENTRY;
+	//NOTE: Changed here. (HEAP MERGE) (2026-10-17)
+	struct kshark_merge_heap heap;
+
+	if (!init_cpu_heap(&heap, rec_list, stream->n_cpus, type))
+		return -ENOMEM;
+	// END of change
 
 	for (int count = 0; count < total; count++) {
 		int next_cpu;
 
-		next_cpu = pick_next_cpu(rec_list, stream->n_cpus, type);
+		next_cpu = pick_next_cpu(&heap, rec_list, type);
 
 		if (next_cpu >= 0) {
 			sorted_entries[count] = &rec_list[next_cpu]->entry;
 			rec_list[next_cpu] = rec_list[next_cpu]->next;
 		}
 	}
+
+	//NOTE: Changed here. (HEAP MERGE) (2026-10-17)
+	kshark_merge_heap_free(&heap);
+
+	return 0;
+	// END of change
 }
 // END of change
 
-//NOTE: Changed here. (COUPLEBREAK) (2025-03-29)
-/**
- * @brief Correct CPUs of "couplebreak/sched_waking[target]" entries
- * to reflect where the task will run after being awoken and switched.
- * 
- * @param sorted_entries Output array of pointers to kshark_entry objects,
- * which will be filled with the entries from the rec_list and sorted by time. 
- * @param total Total number of entries to be possibly corrected.
- * 
- * @note This might mess the plots a little bit as it will look like the target CPU was working.
- */
-static void correct_couplebreak_cpus_inner(struct kshark_entry **sorted_entries,
-	ssize_t total)
+//NOTE: Changed here. (COUPLEBREAK LINEAR) (2026-10-17)
+/** Open addressing hash map from a PID to a CPU. */
+struct pid_cpu_map {
+	/** Array of buckets. */
+	struct pid_cpu_bucket {
+		/** PID of the task (the key). */
+		int32_t	pid;
+
+		/** CPU of the task (the value). */
+		int16_t	cpu;
+
+		/** True if the bucket holds a key-value pair. */
+		bool	used;
+	} *buckets;
+
+	/** The number of buckets (always a power of 2). */
+	size_t size;
+
+	/** The number of used buckets. */
+	size_t count;
+};
+
+/** Initial number of buckets of the PID to CPU map. */
+#define PID_CPU_MAP_INIT_SIZE	1024
+
+static inline size_t pid_cpu_map_slot(const struct pid_cpu_map *map,
+				      int32_t pid)
 {
-	for (ssize_t i = 0 ; i < total ; i++) {
-		struct kshark_entry *curr_event = sorted_entries[i];
+	/* Fibonacci hashing spreads the (mostly consecutive) PIDs. */
+	return ((uint32_t) pid * 2654435769U) & (map->size - 1);
+}
 
-		// The event Id MUST be unchanged
-		int16_t curr_event_id = curr_event->event_id;
-		
-		if (curr_event_id != COUPLEBREAK_SWT_ID) {
-			// No need to correct the cpu of an event that is not sched_waking[target].
-			continue;
-		}
+static struct pid_cpu_bucket *pid_cpu_map_find(const struct pid_cpu_map *map,
+					       int32_t pid)
+{
+	size_t i = pid_cpu_map_slot(map, pid);
 
-		int32_t curr_event_pid = (curr_event->visible & KS_PLUGIN_UNTOUCHED_MASK) ?
-			curr_event->pid : kshark_get_pid(curr_event);
+	while (map->buckets[i].used && map->buckets[i].pid != pid)
+		i = (i + 1) & (map->size - 1);
 
-		// Search in the rest of the array for a switch target of this task onto some CPU
-		// an adjust that field if necessary.
-		for (ssize_t j = i ; j < total ; j++) {
-			const struct kshark_entry *next_event = sorted_entries[j];
-			
-			// The event Id MUST be unchanged
-			int16_t next_event_id = next_event->event_id;
-			
-			int32_t next_event_pid = (next_event->visible & KS_PLUGIN_UNTOUCHED_MASK) ?
-				next_event->pid : kshark_get_pid(next_event);
+	return &map->buckets[i];
+}
 
-			if (next_event_id == COUPLEBREAK_SST_ID && // Correct event
-				next_event_pid == curr_event_pid) { // Of the same task
-				
-				curr_event->cpu = next_event->cpu;
-				break;
-			}
+static bool pid_cpu_map_init(struct pid_cpu_map *map, size_t size)
+{
+	map->buckets = calloc(size, sizeof(*map->buckets));
+	map->size = size;
+	map->count = 0;
+
+	return map->buckets != NULL;
+}
+
+static int pid_cpu_map_set(struct pid_cpu_map *map, int32_t pid, int16_t cpu)
+{
+	struct pid_cpu_bucket *bucket;
+
+	/* Keep the load factor below 1/2. */
+	if (2 * (map->count + 1) > map->size) {
+		struct pid_cpu_map grown;
+
+		if (!pid_cpu_map_init(&grown, 2 * map->size))
+			return -ENOMEM;
+
+		for (size_t i = 0; i < map->size; ++i) {
+			if (!map->buckets[i].used)
+				continue;
+
+			bucket = pid_cpu_map_find(&grown, map->buckets[i].pid);
+			*bucket = map->buckets[i];
+			grown.count++;
 		}
+
+		free(map->buckets);
+		*map = grown;
+	}
+
+	bucket = pid_cpu_map_find(map, pid);
+	if (!bucket->used) {
+		bucket->used = true;
+		bucket->pid = pid;
+		map->count++;
 	}
+
+	bucket->cpu = cpu;
+
+	return 0;
+}
+
+static inline int32_t couplebreak_entry_pid(const struct kshark_entry *entry)
+{
+	return (entry->visible & KS_PLUGIN_UNTOUCHED_MASK) ?
+		entry->pid : kshark_get_pid(entry);
 }
-// END of change
 
-//NOTE: Changed here. (COUPLEBREAK) (2025-03-21)
 // Possible extension - this function and all that it entails could be refactored to a plugin,
 // where this correction is also possible. There was no strong reason to split couplebreak
 // and how it should work from its main working environment though, hence this implementation.
 /**
  * @brief Correct CPUs of "couplebreak/sched_waking[target]" entries
- * to reflect where the task will run after being awoken and switched. This
- * function prepares a copy of the record list, sorts that copy by time into an
- * array and calls the function that does the correction.
- * 
- * @param stream Data stream pointer to which events belong.
- * @param rec_list List of all events to sort - this linked list will be copied,
- * so that this one's nodes aren't changed for any possible future use.
+ * to reflect where the task will run after being awoken and switched, i.e.
+ * the CPU of the first following "couplebreak/sched_switch[target]" entry
+ * of the same task.
+ *
+ * The array is walked once, backwards in time, while a hash map keeps the CPU
+ * of the nearest upcoming switch of each task. This way every wakeup still
+ * pending its switch gets resolved with a single lookup.
+ *
+ * @param sorted_entries Array of pointers to kshark_entry objects, sorted
+ * by time.
  * @param total Total number of entries to be possibly corrected.
- * @return Return code of the function, 0 on success, -ENOMEM on
- * memory allocation fail.
+ * @param ts_limit Switches at or after this time are ignored, because the
+ * entries may be missing some of them. INT64_MAX if all entries are present.
+ * @return 0 on success, -ENOMEM on memory allocation fail.
+ *
+ * @note This might mess the plots a little bit as it will look like the target CPU was working.
  */
-static int correct_couplebreak_cpus(struct kshark_data_stream *stream,
-	struct rec_list **rec_list, ssize_t total)
+//NOTE: Changed here. (WINDOWED LOAD) (2026-10-17)
+static int correct_couplebreak_cpus(struct kshark_entry **sorted_entries,
+				    ssize_t total, int64_t ts_limit)
+// END of change
 {
-	struct rec_list **temp_list = calloc(total, sizeof(*temp_list));
-	if (!temp_list) {
-		goto fail;
-	}
-	// Copy the rec_list to a temporary list.
-	for (ssize_t i = 0; i < total; i++) {
-		temp_list[i] = rec_list[i];
-	}
+	struct pid_cpu_bucket *bucket;
+	struct kshark_entry *entry;
+	struct pid_cpu_map map;
+	ssize_t i;
 
-	// Create a sorted array of kshark_events from the rec_list.
-	struct kshark_entry **sorted_entries = calloc(total, sizeof(*sorted_entries));
-	if (!sorted_entries) {
-		free(temp_list);
+	if (!pid_cpu_map_init(&map, PID_CPU_MAP_INIT_SIZE))
 		goto fail;
-	}
 
-	fill_sorted_entries(stream, temp_list, sorted_entries, total);
+	for (i = total - 1; i >= 0; --i) {
+		entry = sorted_entries[i];
+
+		//NOTE: Changed here. (WINDOWED LOAD) (2026-10-17)
+		if (entry->event_id == COUPLEBREAK_SST_ID &&
+		    entry->ts >= ts_limit)
+			continue;
+		// END of change
 
-	correct_couplebreak_cpus_inner(sorted_entries, total);
+		// The event Id MUST be unchanged
+		if (entry->event_id == COUPLEBREAK_SST_ID) {
+			if (pid_cpu_map_set(&map, couplebreak_entry_pid(entry),
+					    entry->cpu) < 0) {
+				free(map.buckets);
+				goto fail;
+			}
+		} else if (entry->event_id == COUPLEBREAK_SWT_ID) {
+			bucket = pid_cpu_map_find(&map,
+						  couplebreak_entry_pid(entry));
+			if (bucket->used)
+				entry->cpu = bucket->cpu;
+		}
+	}
 
-	// While it may look a little reckless to just allocate memory like this,
-	// the sorted_entries' space will actually be needed later in the load functions
-	// which called the get_records function - so this space won't be really wasted.
-	// This does pose a possible extension, where if couplebreak is enabled, the
-	// sorted_entries array could be used later instead of freed, to skip the double
-	// time sorting this currently creates.
-	free(temp_list);
-	free(sorted_entries);
+	free(map.buckets);
 
 	return 0;
 
@@ -675,247 +1073,2402 @@ static int correct_couplebreak_cpus(struct kshark_data_stream *stream,
 		"Failed to allocate memory during couplebreak's CPU corrections.\n");
 	return -ENOMEM;
 }
-// END of change
 
-static ssize_t get_records(struct kshark_context *kshark_ctx,
-			   struct kshark_data_stream *stream,
-			   struct rec_list ***rec_list,
-			   enum rec_type type)
+//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+static int32_t compact_couplebreak_pid(struct kshark_compact_data *data,
+				       size_t index)
 {
-	struct tep_event_filter *adv_filter = NULL;
-	struct tracecmd_input *input;
-	struct rec_list **temp_next;
-	struct rec_list **cpu_list;
-	struct rec_list *temp_rec;
-	struct tep_record *rec;
-	ssize_t count, total = 0;
-	int pid, next_pid, cpu;
+	struct kshark_entry **view;
+	int32_t pid;
 
-	//NOTE: Changed here. (COUPLEBREAK) (2025-03-21)
-	// Resets couplebreak state on each load of a stream.
-	stream->couplebreak_evts_flags = 0;
-	stream->n_couplebreak_evts = 0;
-	// END of change
+	if (data->entries[index].visible & KS_PLUGIN_UNTOUCHED_MASK)
+		return data->entries[index].pid;
 
-	input = kshark_get_tep_input(stream);
-	if (!input)
-		return -EFAULT;
-
-	cpu_list = calloc(stream->n_cpus, sizeof(*cpu_list));
-	if (!cpu_list)
+	/* Getting the PID requires the origin of the entry. */
+	if (kshark_compact_materialize(data, index, 1, &view) != 1)
 		return -ENOMEM;
 
-	if (type == REC_ENTRY)
-		adv_filter = get_adv_filter(stream);
+	pid = kshark_get_pid(view[0]);
+	kshark_compact_free_rows(view);
 
-	for (cpu = 0; cpu < stream->n_cpus; ++cpu) {
-		count = 0;
-		cpu_list[cpu] = NULL;
-		temp_next = &cpu_list[cpu];
-		rec = tracecmd_read_cpu_first(kshark_get_tep_input(stream), cpu);
-		while (rec) {
-			*temp_next = temp_rec = calloc(1, sizeof(*temp_rec));
-			if (!temp_rec)
+	return pid;
+}
+
+/**
+ * @brief Same as correct_couplebreak_cpus(), but for the entries of a compact
+ * data set.
+ *
+ * @param data Compact data set.
+ * @param first Index of the first entry to be possibly corrected.
+ * @return 0 on success, -ENOMEM on memory allocation fail.
+ */
+int kshark_tep_compact_couplebreak_cpus(struct kshark_compact_data *data,
+					size_t first)
+{
+	struct kshark_compact_entry *entry;
+	struct pid_cpu_bucket *bucket;
+	struct pid_cpu_map map;
+	size_t i;
+
+	if (!pid_cpu_map_init(&map, PID_CPU_MAP_INIT_SIZE))
+		goto fail;
+
+	for (i = data->size; i-- > first;) {
+		entry = &data->entries[i];
+
+		if (entry->event_id == COUPLEBREAK_SST_ID) {
+			if (pid_cpu_map_set(&map,
+					    compact_couplebreak_pid(data, i),
+					    entry->cpu) < 0) {
+				free(map.buckets);
 				goto fail;
+			}
+		} else if (entry->event_id == COUPLEBREAK_SWT_ID) {
+			bucket = pid_cpu_map_find(&map,
+						  compact_couplebreak_pid(data, i));
+			if (bucket->used)
+				entry->cpu = bucket->cpu;
+		}
+	}
 
-			temp_rec->next = NULL;
+	free(map.buckets);
 
-			switch (type) {
-			case REC_RECORD:
-				temp_rec->rec = rec;
-				pid = tep_data_pid(kshark_get_tep(stream), rec);
-				break;
-			case REC_ENTRY: {
-				struct kshark_entry *entry;
+	return 0;
 
-				//NOTE: Changed here. ("COUPLEBREAK") (2025-03-21)
-				// Just a note where to put events if we want to add more and have
-				// them appear before the event which triggers this addition.
-				// Insert events BEFORE
-				// END of change
+ fail:
+	fprintf(stderr,
+		"Failed to allocate memory during couplebreak's CPU corrections.\n");
+	return -ENOMEM;
+}
+// END of change
+
+/**
+ * @brief Merge the per-CPU record lists into a single array of entries,
+ * sorted by time. If couplebreak is enabled, the CPUs of its entries are
+ * corrected using the sorted array, so that no second merge is needed.
+ *
+ * @param stream Data stream pointer to which events belong.
+ * @param rec_list Per-CPU lists of entries. The lists get consumed.
+ * @param total Total number of entries in the lists.
+ * @param arena Memory arena owning the list nodes, or NULL.
+ * @return Array of sorted entries on success, NULL on memory allocation
+ * fail. In such a case, the entries moved out of the lists are released.
+ */
+static struct kshark_entry **get_sorted_entries(struct kshark_data_stream *stream,
+						struct rec_list **rec_list,
+						ssize_t total,
+						struct kshark_mem_arena *arena)
+{
+	struct kshark_entry **rows;
 
-				if (rec->missed_events) {
-					/*
-					 * Insert a custom "missed_events" entry just
-					 * before this record.
-					 */
-					entry = &temp_rec->entry;
-					missed_events_action(stream, rec, entry);
+	rows = calloc(total, sizeof(*rows));
+	if (!rows)
+		return NULL;
 
-					/* Apply time calibration. */
-					kshark_postprocess_entry(stream, rec, entry);
+	if (fill_sorted_entries(stream, rec_list, rows, total) < 0) {
+		free(rows);
+		return NULL;
+	}
 
-					entry->stream_id = stream->stream_id;
+	//NOTE: Changed here. (WINDOWED LOAD) (2026-10-17)
+	if (stream->couplebreak_on &&
+	    correct_couplebreak_cpus(rows, total, INT64_MAX) < 0) {
+		if (!arena)
+			for (ssize_t i = 0; i < total; ++i)
+				free(rows[i]);
 
-					temp_next = &temp_rec->next;
-					++count;
+		free(rows);
+		return NULL;
+	}
+	// END of change
 
-					/* Now allocate a new rec_list node and continue. */
-					*temp_next = temp_rec = calloc(1, sizeof(*temp_rec));
-					if (!temp_rec)
-						goto fail;
-				}
+	return rows;
+}
+// END of change
 
-				entry = &temp_rec->entry;
-				set_entry_values(stream, rec, entry);
-
-				if (entry->event_id == get_sched_switch_id(stream)) {
-					next_pid = get_next_pid(stream, rec);
-					if (next_pid >= 0)
-						register_command(stream, rec, next_pid);
-					
-					//NOTE: Changed here. (COUPLEBREAK) (2025-03-21)
-					if (stream->couplebreak_on) {
-						int retcode = create_custom_entry(kshark_ctx, stream, rec, entry,
-							&temp_next, &temp_rec, adv_filter, &count, couplebreak_create_sst);
-						if (retcode == 1) goto fail;
-					}
-					// END of change
-				}
+//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+static int64_t calib_ts(struct kshark_data_stream *stream, int64_t ts);
 
-				entry->stream_id = stream->stream_id;
-				//NOTE: Changed here. (COUPLEBREAK) (2025-03-30)
-				// Store the event Id before any plugins can touch it.
-				int16_t origin_event_id = entry->event_id;
-				// END of change
+/** Check if any load options restrict the records to be loaded. */
+static bool load_options_set(const struct kshark_data_stream *stream)
+{
+	return stream->load_events ||
+	       stream->load_ts_min != INT64_MIN ||
+	       stream->load_ts_max != INT64_MAX;
+}
+
+/**
+ * @brief Check a record against the load options of the stream.
+ *
+ * @return 0 if the record is to be loaded, a negative value if the record is
+ * to be skipped, or a positive value if the record (and all records after it
+ * in the same CPU buffer) is beyond the loaded time range.
+ */
+static int load_options_check(struct kshark_data_stream *stream,
+			      struct tep_record *rec)
+{
+	int64_t ts;
+
+	if (stream->load_ts_min != INT64_MIN ||
+	    stream->load_ts_max != INT64_MAX) {
+		ts = calib_ts(stream, rec->ts);
+		if (ts > stream->load_ts_max)
+			return 1;
+
+		if (ts < stream->load_ts_min)
+			return -1;
+	}
+
+	if (stream->load_events &&
+	    !kshark_hash_id_find(stream->load_events,
+				 tep_data_type(kshark_get_tep(stream), rec)))
+		return -1;
+
+	return 0;
+}
+
+/**
+ * @brief Read the first record of a CPU buffer to be loaded. If the time
+ * range of the loading has a lower edge, the pages before it are not read at
+ * all. This is possible only without time calibration, because the seeking
+ * uses the timestamps from the file.
+ */
+static struct tep_record *load_first_record(struct kshark_data_stream *stream,
+					    struct tracecmd_input *input,
+					    int cpu)
+{
+	if (stream->load_ts_min > 0 &&
+	    !(stream->calib && stream->calib_array) &&
+	    tracecmd_set_cpu_to_timestamp(input, cpu,
+					  stream->load_ts_min) == 0)
+		return tracecmd_read_data(input, cpu);
+
+	return tracecmd_read_cpu_first(input, cpu);
+}
+// END of change
+
+//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+/**
+ * @brief Read all records of a given CPU buffer and append them to the
+ * per-CPU record list of the loader.
+ *
+ * @param worker The worker loading the records.
+ * @param cpu CPU Id.
+ * @return The number of records (entries) loaded, or -ENOMEM on memory
+ * allocation fail.
+ */
+static ssize_t load_cpu_records(struct records_worker *worker, int cpu,
+				int64_t ts_limit)
+{
+	struct records_loader *loader = worker->loader;
+	struct tracecmd_input *input = worker->input;
+	struct tep_event_filter *adv_filter = loader->adv_filter;
+	struct kshark_context *kshark_ctx = loader->kshark_ctx;
+	struct kshark_data_stream *stream = loader->stream;
+	pthread_mutex_t *lock = loader->lock;
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	struct cpu_load_state *state = &loader->cpu_state[cpu];
+	// END of change
+	struct rec_list **temp_next;
+	struct rec_list *temp_rec;
+	struct tep_record *rec;
+	int pid, next_pid;
+	ssize_t count = 0;
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	int skip;
+	// END of change
+
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	if (state->done)
+		return 0;
+
+	if (state->tail) {
+		/* Continue from where the previous time window ended. */
+		temp_next = state->tail;
+		rec = state->pending;
+		state->pending = NULL;
+	} else {
+		loader->cpu_list[cpu] = NULL;
+		temp_next = &loader->cpu_list[cpu];
+		//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+		rec = load_first_record(stream, input, cpu);
+		// END of change
+	}
+
+	while (rec) {
+		//NOTE: Changed here. (WINDOWED LOAD) (2026-10-17)
+		if ((int64_t) rec->ts >= ts_limit ||
+		    (state->stop_offset && rec->offset >= state->stop_offset)) {
+		// END of change
+			state->pending = rec;
+			break;
+		}
+
+		state->offset = rec->offset;
+		// END of change
+
+		//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+		skip = load_options_check(stream, rec);
+		if (skip) {
+			tracecmd_free_record(rec);
+			rec = (skip > 0) ? NULL : tracecmd_read_data(input, cpu);
+			continue;
+		}
+		// END of change
+
+		*temp_next = temp_rec = alloc_rec(worker->arena);
+		if (!temp_rec)
+			goto fail;
+
+		temp_rec->next = NULL;
+
+		switch (loader->type) {
+		case REC_RECORD:
+			temp_rec->rec = rec;
+			pid = tep_data_pid(kshark_get_tep(stream), rec);
+			break;
+		case REC_ENTRY: {
+			struct kshark_entry *entry;
+
+			//NOTE: Changed here. ("COUPLEBREAK") (2025-03-21)
+			// Just a note where to put events if we want to add more and have
+			// them appear before the event which triggers this addition.
+			// Insert events BEFORE
+			// END of change
 
+			if (rec->missed_events) {
 				/*
-				 * Post-process the content of the entry. This includes
-				 * time calibration and event-specific plugin actions.
+				 * Insert a custom "missed_events" entry just
+				 * before this record.
 				 */
-				kshark_postprocess_entry(stream, rec, entry);
-
-				pid = entry->pid;
-
-				/* Apply Id filtering. */
-				kshark_apply_filters(kshark_ctx, stream, entry);
-
-				/* Apply advanced event filtering. */
-				if (adv_filter && adv_filter->filters &&
-				    tep_filter_match(adv_filter, rec) != FILTER_MATCH)
-					unset_event_filter_flag(kshark_ctx, entry);
-				
-				//NOTE: Changed here. ("COUPLEBREAK") (2025-03-21)
-				// Just a note where to put events if we want to add more and have
-				// them appear after the event which triggers this addition.
-				// Insert events AFTER
-				// END of change
-				
+				entry = &temp_rec->entry;
+				missed_events_action(stream, rec, entry);
+
+				/* Apply time calibration. */
+				load_postprocess_entry(loader, rec, entry);
+
+				entry->stream_id = stream->stream_id;
+
+				temp_next = &temp_rec->next;
+				++count;
+
+				/* Now allocate a new rec_list node and continue. */
+				*temp_next = temp_rec = alloc_rec(worker->arena);
+				if (!temp_rec)
+					goto fail;
+			}
+
+			entry = &temp_rec->entry;
+			set_entry_values(stream, rec, entry);
+
+			if (entry->event_id == get_sched_switch_id(stream)) {
+				next_pid = get_next_pid(stream, rec);
+				if (next_pid >= 0) {
+					if (lock)
+						pthread_mutex_lock(lock);
+
+					register_command(stream, rec, next_pid);
+
+					if (lock)
+						pthread_mutex_unlock(lock);
+				}
+
 				//NOTE: Changed here. (COUPLEBREAK) (2025-03-21)
-				const int sch_waking_id = kshark_find_event_id(stream, "sched/sched_waking");
-				
-				if (origin_event_id == (int16_t)sch_waking_id) {
-					if (stream->couplebreak_on) {
-						int retcode = create_custom_entry(kshark_ctx, stream, rec, entry,
-							&temp_next, &temp_rec, adv_filter, &count, couplebreak_create_swt);
-						if (retcode == 1) goto fail;
-					}
+				if (stream->couplebreak_on) {
+					int retcode = create_custom_entry(kshark_ctx, stream, rec, entry,
+						&temp_next, &temp_rec, adv_filter, &count, couplebreak_create_sst,
+						worker);
+					if (retcode == 1) goto fail;
 				}
 				// END of change
+			}
 
-				tracecmd_free_record(rec);
-				break;
-			} /* REC_ENTRY */
+			entry->stream_id = stream->stream_id;
+			//NOTE: Changed here. (COUPLEBREAK) (2025-03-30)
+			// Store the event Id before any plugins can touch it.
+			int16_t origin_event_id = entry->event_id;
+			// END of change
+
+			/*
+			 * Post-process the content of the entry. This includes
+			 * time calibration and event-specific plugin actions.
+			 */
+			load_postprocess_entry(loader, rec, entry);
+
+			pid = entry->pid;
+
+			/* Apply Id filtering. */
+			kshark_apply_filters(kshark_ctx, stream, entry);
+
+			/* Apply advanced event filtering. */
+			if (load_adv_filter_rejects(adv_filter, rec, lock))
+				unset_event_filter_flag(kshark_ctx, entry);
+
+			//NOTE: Changed here. ("COUPLEBREAK") (2025-03-21)
+			// Just a note where to put events if we want to add more and have
+			// them appear after the event which triggers this addition.
+			// Insert events AFTER
+			// END of change
+
+			//NOTE: Changed here. (COUPLEBREAK) (2025-03-21)
+			if (origin_event_id == loader->sched_waking_id) {
+				if (stream->couplebreak_on) {
+					int retcode = create_custom_entry(kshark_ctx, stream, rec, entry,
+						&temp_next, &temp_rec, adv_filter, &count, couplebreak_create_swt,
+						worker);
+					if (retcode == 1) goto fail;
+				}
 			}
+			// END of change
 
-			kshark_hash_id_add(stream->tasks, pid);
+			tracecmd_free_record(rec);
+			break;
+		} /* REC_ENTRY */
+		}
 
-			temp_next = &temp_rec->next;
+		kshark_hash_id_add(worker->tasks, pid);
 
-			++count;
-			rec = tracecmd_read_data(kshark_get_tep_input(stream), cpu);
-		}
+		temp_next = &temp_rec->next;
 
-		if (!count)
-			kshark_hash_id_add(stream->idle_cpus, cpu);
-		else
-			total += count;
+		++count;
+		rec = tracecmd_read_data(input, cpu);
 	}
 
-	*rec_list = cpu_list;
-
-	//NOTE: Changed here. (COUPLEBREAK) (2025-03-21)
-	if (stream->couplebreak_on) {
-		// Use the newest data to correct the cpu field of couplebreak events.
-		// The rec_list is not changed.
-		int op_result = correct_couplebreak_cpus(stream, *rec_list, total);
-		if (op_result == -ENOMEM) {
-			return -ENOMEM;
-		}
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	if (!rec) {
+		state->done = true;
+		if (state->end_offset)
+			state->offset = state->end_offset;
 	}
+
+	state->tail = temp_next;
+	state->count += count;
 	// END of change
 
-	return total;
+	return count;
 
  fail:
-	free_rec_list(cpu_list, stream->n_cpus, type);
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	tracecmd_free_record(rec);
+	// END of change
 	return -ENOMEM;
 }
 
+/**
+ * @brief Get the number of threads to be used when loading a data stream.
+ *
+ * @param stream Data stream pointer.
+ * @return Number of threads, never bigger than the number of CPU buffers.
+ */
+static int get_load_threads(struct kshark_data_stream *stream)
+{
+	long n_threads = stream->n_load_threads;
+
+	if (n_threads == KS_LOAD_THREADS_AUTO)
+		n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if (n_threads > stream->n_cpus)
+		n_threads = stream->n_cpus;
+
+	return (n_threads < 1) ? 1 : n_threads;
+}
 
+//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
 /**
- * @brief Load the content of the trace data file asociated with a given
- *	  Data stream into an array of kshark_entries. This function
- *	  provides an abstraction of the entries from the raw data
- *	  that is read, however the "latency" and the "info" fields can be
- *	  accessed only via the offset into the file. This makes the access
- *	  to these two fields much slower.
- *	  If one or more filters are set, the "visible" fields of each entry
- *	  is updated according to the criteria provided by the filters. The
- *	  field "filter_mask" of the session's context is used to control the
- *	  level of visibility/invisibility of the filtered entries.
+ * @brief Reserve threads to load a data stream. While several data streams
+ * are loaded concurrently, the additional threads are taken from the budget
+ * shared by the streams (see kshark_context::load_threads_left).
  *
- * @param stream: Input location for the FTRACE data stream pointer.
- * @param kshark_ctx: Input location for context pointer.
- * @param data_rows: Output location for the trace data. The user is
- *		     responsible for freeing the elements of the outputted
- *		     array.
+ * @param kshark_ctx KernelShark context.
+ * @param n_threads The number of threads wanted, the calling thread included.
+ * @return The number of threads reserved, at least one (the calling thread).
+ * Release them with release_load_threads().
+ */
+static int reserve_load_threads(struct kshark_context *kshark_ctx,
+				int n_threads)
+{
+	int *left = kshark_ctx->load_threads_left;
+	int avail, extra;
+
+	if (!left || n_threads <= 1)
+		return n_threads;
+
+	avail = __atomic_load_n(left, __ATOMIC_RELAXED);
+	do {
+		extra = (n_threads - 1 < avail) ? n_threads - 1 : avail;
+		if (extra <= 0)
+			return 1;
+	} while (!__atomic_compare_exchange_n(left, &avail, avail - extra,
+					      false, __ATOMIC_RELAXED,
+					      __ATOMIC_RELAXED));
+
+	return extra + 1;
+}
+
+/** Return the threads, reserved with reserve_load_threads(), to the budget. */
+static void release_load_threads(struct kshark_context *kshark_ctx,
+				 int n_threads)
+{
+	if (kshark_ctx->load_threads_left && n_threads > 1)
+		__atomic_add_fetch(kshark_ctx->load_threads_left,
+				   n_threads - 1, __ATOMIC_RELAXED);
+}
+// END of change
+
+/**
+ * @brief Open a new, independent input handle for the buffer of the trace
+ * data file, associated with a given data stream.
  *
- * @returns The size of the outputted data in the case of success, or a
- *	    negative error code on failure.
+ * @param stream Data stream pointer.
+ * @param top_input Output location for the input handle of the top buffer.
+ * The user is responsible for closing it with tracecmd_close().
+ * @return Input handle for the buffer of the stream, or NULL on failure.
+ * If the stream is the top buffer, this is the same handle as "top_input".
+ */
+static struct tracecmd_input *
+open_worker_input(struct kshark_data_stream *stream,
+		  struct tracecmd_input **top_input)
+{
+	struct tracecmd_input *input = NULL;
+	int i, n_buffers;
+
+	/*
+	 * The records are parsed using the Page event object of the stream,
+	 * hence there is no need to load the plugins once again.
+	 */
+	*top_input = tracecmd_open_head(stream->file,
+					TRACECMD_FL_LOAD_NO_PLUGINS);
+	if (!*top_input)
+		return NULL;
+
+	if (tracecmd_init_data(*top_input) < 0)
+		goto fail;
+
+	if (kshark_tep_is_top_stream(stream))
+		return *top_input;
+
+	n_buffers = tracecmd_buffer_instances(*top_input);
+	for (i = 0; i < n_buffers; ++i) {
+		if (strcmp(stream->name,
+			   tracecmd_buffer_instance_name(*top_input, i)) == 0) {
+			input = tracecmd_buffer_instance_handle(*top_input, i);
+			break;
+		}
+	}
+
+	if (input)
+		return input;
+
+ fail:
+	tracecmd_close(*top_input);
+	*top_input = NULL;
+	return NULL;
+}
+
+static void close_worker_input(struct records_worker *worker)
+{
+	if (worker->input && worker->input != worker->top_input)
+		tracecmd_close(worker->input);
+
+	if (worker->top_input)
+		tracecmd_close(worker->top_input);
+
+	worker->input = worker->top_input = NULL;
+}
+
+//NOTE: Changed here. (READ INPUTS) (2026-10-17)
+/**
+ * @brief Input handle used to read single records of a data stream. Every
+ * thread reading records at the same time gets its own handle, so that the
+ * reading is not serialized. The handles are kept for reuse.
+ */
+struct read_input {
+	/** Input handle for the top buffer of the trace data file. */
+	struct tracecmd_input	*top_input;
+
+	/** Input handle for the buffer of the data stream. */
+	struct tracecmd_input	*input;
+
+	/** The next spare handle. */
+	struct read_input	*next;
+};
+
+/**
+ * @brief Get an input handle for reading single records. Release it with
+ * read_input_put() when done with the records read.
+ *
+ * @param stream Data stream pointer.
+ * @param ri Output location for the handle owner, to be passed to
+ * read_input_put(). NULL if no own handle can be opened. The shared input of
+ * the stream is then used, and the input mutex is held till read_input_put().
+ * @return The input handle.
+ */
+static struct tracecmd_input *read_input_get(struct kshark_data_stream *stream,
+					     struct read_input **ri)
+{
+	struct tepdata_handle *tep_handle;
+
+	if (get_tepdate_handle(stream, &tep_handle) < 0 || !tep_handle)
+		goto shared;
+
+	pthread_mutex_lock(&stream->input_mutex);
+
+	*ri = tep_handle->spare_inputs;
+	if (*ri)
+		tep_handle->spare_inputs = (*ri)->next;
+
+	pthread_mutex_unlock(&stream->input_mutex);
+
+	if (*ri)
+		return (*ri)->input;
+
+	*ri = calloc(1, sizeof(**ri));
+	if (!*ri)
+		goto shared;
+
+	(*ri)->input = open_worker_input(stream, &(*ri)->top_input);
+	if ((*ri)->input)
+		return (*ri)->input;
+
+	free(*ri);
+
+ shared:
+	*ri = NULL;
+	pthread_mutex_lock(&stream->input_mutex);
+
+	return kshark_get_tep_input(stream);
+}
+
+/** Give back an input handle, obtained with read_input_get(). */
+static void read_input_put(struct kshark_data_stream *stream,
+			   struct read_input *ri)
+{
+	struct tepdata_handle *tep_handle;
+
+	if (!ri) {
+		pthread_mutex_unlock(&stream->input_mutex);
+		return;
+	}
+
+	get_tepdate_handle(stream, &tep_handle);
+
+	pthread_mutex_lock(&stream->input_mutex);
+
+	ri->next = tep_handle->spare_inputs;
+	tep_handle->spare_inputs = ri;
+
+	pthread_mutex_unlock(&stream->input_mutex);
+}
+
+static void read_inputs_free(struct read_input *ri)
+{
+	struct read_input *next;
+
+	for (; ri; ri = next) {
+		next = ri->next;
+		if (ri->input != ri->top_input)
+			tracecmd_close(ri->input);
+
+		tracecmd_close(ri->top_input);
+		free(ri);
+	}
+}
+// END of change
+
+//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+/** The maximum number of records kept in the record cache of a stream. */
+#define KS_RECORD_CACHE_SIZE		4096
+
+/**
+ * @brief Read a record of a data stream by its offset into the trace file.
+ * The recently read records are served from the record cache of the stream.
+ * Release the record with release_record(). Do not use tracecmd_free_record().
+ *
+ * @param stream Data stream pointer.
+ * @param offset The offset of the record into the trace file.
+ * @return The record, or NULL on failure.
+ */
+static struct tep_record *read_record(struct kshark_data_stream *stream,
+				      uint64_t offset)
+{
+	struct tepdata_handle *tep_handle;
+	struct tracecmd_input *input;
+	struct tep_record *rec, *cached;
+	struct read_input *ri;
+
+	if (get_tepdate_handle(stream, &tep_handle) < 0 || !tep_handle ||
+	    !tep_handle->record_cache)
+		return NULL;
+
+	cached = kshark_record_cache_get(tep_handle->record_cache, offset);
+	if (cached)
+		return cached;
+
+	/* The file gets read without holding the cache lock. */
+	input = read_input_get(stream, &ri);
+	rec = tracecmd_read_at(input, offset, NULL);
+	cached = rec ? kshark_record_cache_add(tep_handle->record_cache, rec) :
+		       NULL;
+
+	tracecmd_free_record(rec);
+	read_input_put(stream, ri);
+
+	return cached;
+}
+
+/** Release a record, obtained with read_record(). */
+static void release_record(struct kshark_data_stream *stream,
+			   struct tep_record *rec)
+{
+	struct tepdata_handle *tep_handle;
+
+	if (!rec || get_tepdate_handle(stream, &tep_handle) < 0)
+		return;
+
+	kshark_record_cache_put(tep_handle->record_cache, rec);
+}
+
+/**
+ * @brief Get the statistics of the record cache of a Data stream. The cache
+ *	  holds copies of the records, recently read by their file offsets
+ *	  (for example, to get the info of an entry).
+ *
+ * @param stream: Input location for a Trace data stream pointer.
+ * @param stats: Output location for the statistics.
+ *
+ * @returns Zero on success, or a negative error code if the stream has no
+ *	    record cache.
+ */
+int kshark_tep_get_record_cache_stats(struct kshark_data_stream *stream,
+				      struct kshark_tep_record_cache_stats *stats)
+{
+	struct tepdata_handle *tep_handle;
+
+	if (get_tepdate_handle(stream, &tep_handle) < 0 || !tep_handle ||
+	    !tep_handle->record_cache)
+		return -EFAULT;
+
+	kshark_record_cache_get_stats(tep_handle->record_cache, stats);
+
+	return 0;
+}
+// END of change
+
+//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+/** Page size, used if the page size of the trace data is unknown. */
+#define KS_LOAD_DEFAULT_PAGE	4096
+
+/*
+ * Check if a CPU buffer has a record ending after a given file offset.
+ * tracecmd_read_at() loads only the page holding the offset.
+ */
+static bool cpu_has_data_after(struct tracecmd_input *input, int cpu,
+			       uint64_t offset)
+{
+	struct tep_record *rec;
+	int rec_cpu = -1;
+	bool ret;
+
+	rec = tracecmd_read_at(input, offset, &rec_cpu);
+	ret = rec && rec_cpu == cpu;
+	tracecmd_free_record(rec);
+
+	return ret;
+}
+
+/**
+ * @brief Read the last record of a CPU buffer, using only the public page
+ * access of libtracecmd. The last page holding records is found by probing
+ * pages with a growing stride and then by bisection, hence only a logarithmic
+ * number of pages is read.
+ *
+ * @param stream Data stream pointer.
+ * @param input Input handle of the data stream.
+ * @param cpu CPU Id.
+ * @param first_offset File offset of the first record of the CPU buffer.
+ * @return The last record or NULL on failure. The user is responsible for
+ * freeing it with tracecmd_free_record().
+ */
+static struct tep_record *read_cpu_last(struct kshark_data_stream *stream,
+					struct tracecmd_input *input, int cpu,
+					uint64_t first_offset)
+{
+	struct tep_record *rec, *last = NULL;
+	uint64_t page_size, lo, hi, mid, stride;
+
+	page_size = tep_get_page_size(kshark_get_tep(stream));
+	if ((int64_t) page_size <= 0)
+		page_size = KS_LOAD_DEFAULT_PAGE;
+
+	/* The page of the first record holds data. */
+	lo = first_offset - first_offset % page_size;
+	for (stride = page_size; ; stride *= 2) {
+		if (__builtin_add_overflow(lo, stride, &hi)) {
+			hi = UINT64_MAX;
+			break;
+		}
+
+		if (!cpu_has_data_after(input, cpu, hi))
+			break;
+
+		lo = hi;
+	}
+
+	/* "lo" has data after it, "hi" does not. */
+	while (hi - lo > page_size) {
+		mid = lo + (hi - lo) / page_size / 2 * page_size;
+		if (cpu_has_data_after(input, cpu, mid))
+			lo = mid;
+		else
+			hi = mid;
+	}
+
+	rec = tracecmd_read_at(input, lo, NULL);
+	while (rec) {
+		tracecmd_free_record(last);
+		last = rec;
+		rec = tracecmd_read_data(input, cpu);
+	}
+
+	return last;
+}
+
+/**
+ * @brief Prepare the loading of a data stream in consecutive time windows.
+ * The size of each CPU buffer and the time span of the data are determined
+ * using the first and the last record of each buffer.
+ *
+ * @param loader Shared state of the loading.
+ * @param input Input handle of the data stream.
+ * @param n_windows The number of time windows.
+ */
+static void init_load_windows(struct records_loader *loader,
+			      struct tracecmd_input *input, int n_windows)
+{
+	/* The failure is reported only once. */
+	static bool read_last_failed;
+
+	struct cpu_load_state *state;
+	struct tep_record *rec;
+	int cpu;
+
+	loader->ts_first = INT64_MAX;
+	loader->ts_last = INT64_MIN;
+
+	for (cpu = 0; cpu < loader->stream->n_cpus; ++cpu) {
+		state = &loader->cpu_state[cpu];
+
+		rec = tracecmd_read_cpu_first(input, cpu);
+		if (!rec)
+			continue;
+
+		state->first_offset = state->offset = rec->offset;
+		if ((int64_t) rec->ts < loader->ts_first)
+			loader->ts_first = rec->ts;
+
+		tracecmd_free_record(rec);
+
+		rec = read_cpu_last(loader->stream, input, cpu,
+				    state->first_offset);
+		if (!rec) {
+			if (!__atomic_exchange_n(&read_last_failed, true,
+						 __ATOMIC_RELAXED))
+				fprintf(stderr,
+					"Failed to find the end of a CPU buffer. The data is loaded in a single window.\n");
+
+			return;
+		}
+
+		state->end_offset = rec->offset + rec->record_size;
+		if ((int64_t) rec->ts > loader->ts_last)
+			loader->ts_last = rec->ts;
+
+		tracecmd_free_record(rec);
+	}
+
+	/*
+	 * The windows cover only the time range of the load options. The
+	 * limits of the windows are compared with the timestamps from the
+	 * file, hence this is possible only without time calibration.
+	 */
+	if (!(loader->stream->calib && loader->stream->calib_array)) {
+		if (loader->stream->load_ts_min > loader->ts_first)
+			loader->ts_first = loader->stream->load_ts_min;
+
+		if (loader->stream->load_ts_max < loader->ts_last)
+			loader->ts_last = loader->stream->load_ts_max;
+	}
+
+	if (loader->ts_first > loader->ts_last)
+		return;
+
+	loader->n_windows = n_windows;
+}
+
+/** Get the upper limit (not included) of the timestamps of a time window. */
+static int64_t load_window_limit(const struct records_loader *loader,
+				 int window)
+{
+	if (window >= loader->n_windows - 1)
+		return INT64_MAX;
+
+	return loader->ts_first +
+	       (loader->ts_last - loader->ts_first) / loader->n_windows *
+	       (window + 1);
+}
+
+static int64_t calib_ts(struct kshark_data_stream *stream, int64_t ts)
+{
+	if (stream->calib && stream->calib_array)
+		stream->calib(&ts, stream->calib_array);
+
+	return ts;
+}
+
+/**
+ * @brief Get the progress of the loading of a data stream. If the loading is
+ * parallel, call this function under the loader lock.
+ */
+static void get_load_progress(const struct records_loader *loader,
+			      struct kshark_load_progress *progress)
+{
+	struct kshark_data_stream *stream = loader->stream;
+	const struct cpu_load_state *state;
+	int cpu, n_windows = loader->n_windows;
+
+	if (loader->n_windows == 1) {
+		/* Loaded in a single window. The time span is unknown. */
+		progress->bytes_done = progress->bytes_total = 1;
+		progress->ts_first = progress->ts_loaded = progress->ts_last = 0;
+		return;
+	}
+
+	progress->bytes_done = progress->bytes_total = 0;
+	for (cpu = 0; cpu < stream->n_cpus; ++cpu) {
+		state = &loader->cpu_state[cpu];
+		if (state->n_windows < n_windows)
+			n_windows = state->n_windows;
+
+		/* The size of the CPU buffer is unknown. */
+		if (state->end_offset <= state->first_offset)
+			continue;
+
+		progress->bytes_done += state->offset - state->first_offset;
+		progress->bytes_total += state->end_offset - state->first_offset;
+	}
+
+	/* All CPU buffers are loaded up to the end of the slowest one. */
+	if (n_windows == loader->n_windows)
+		progress->ts_loaded = loader->ts_last;
+	else if (n_windows == 0)
+		progress->ts_loaded = loader->ts_first - 1;
+	else
+		progress->ts_loaded = load_window_limit(loader,
+							n_windows - 1) - 1;
+
+	progress->ts_first = calib_ts(stream, loader->ts_first);
+	progress->ts_last = calib_ts(stream, loader->ts_last);
+	progress->ts_loaded = calib_ts(stream, progress->ts_loaded);
+}
+
+/**
+ * @brief Mark a time window of a CPU buffer as loaded and report the
+ * progress of the loading (if requested).
+ */
+static void finish_load_window(struct records_loader *loader, int cpu,
+			       int window)
+{
+	struct kshark_context *kshark_ctx = loader->kshark_ctx;
+	struct kshark_load_progress progress;
+
+	if (loader->lock)
+		pthread_mutex_lock(loader->lock);
+
+	loader->cpu_state[cpu].n_windows = window + 1;
+
+	if (kshark_ctx->load_progress_func) {
+		get_load_progress(loader, &progress);
+		kshark_ctx->load_progress_func(loader->stream, &progress,
+					       kshark_ctx->load_progress_data);
+	}
+
+	if (loader->lock)
+		pthread_mutex_unlock(loader->lock);
+}
+
+/*
+ * Each worker loads its own subset of the CPU buffers, one time window after
+ * another. A CPU buffer is always read with the same input handle, hence its
+ * loading can continue in the next time window.
+ */
+static void load_windows_func(struct records_worker *worker)
+{
+	struct records_loader *loader = worker->loader;
+	int cpu, window;
+
+	if (loader->lock) {
+		pthread_mutex_lock(loader->lock);
+		while (!loader->go)
+			pthread_cond_wait(loader->go_cond, loader->lock);
+		pthread_mutex_unlock(loader->lock);
+	}
+
+	for (window = 0; window < loader->n_windows; ++window) {
+		for (cpu = worker->index; cpu < loader->stream->n_cpus;
+		     cpu += loader->n_workers) {
+			if (__atomic_load_n(&loader->failed, __ATOMIC_RELAXED))
+				return;
+
+			if (load_cpu_records(worker, cpu,
+					     load_window_limit(loader, window)) < 0) {
+				__atomic_store_n(&loader->failed, true,
+						 __ATOMIC_RELAXED);
+				return;
+			}
+
+			finish_load_window(loader, cpu, window);
+		}
+	}
+}
+// END of change
+
+static void records_worker_func(struct records_worker *worker)
+{
+	struct records_loader *loader = worker->loader;
+	ssize_t count;
+	int cpu;
+
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	if (loader->n_windows > 1) {
+		load_windows_func(worker);
+		return;
+	}
+	// END of change
+
+	while (!__atomic_load_n(&loader->failed, __ATOMIC_RELAXED)) {
+		cpu = __atomic_fetch_add(&loader->next_cpu, 1, __ATOMIC_RELAXED);
+		if (cpu >= loader->stream->n_cpus)
+			break;
+
+		//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+		count = load_cpu_records(worker, cpu, INT64_MAX);
+		// END of change
+		if (count < 0) {
+			__atomic_store_n(&loader->failed, true, __ATOMIC_RELAXED);
+			break;
+		}
+	}
+}
+
+static void *records_worker_thread(void *data)
+{
+	records_worker_func(data);
+
+	/* The plugins may have used the trace sequence of this thread. */
+	kshark_tep_release_thread_seq();
+
+	return NULL;
+}
+
+/*
+ * Some fields of the Page event object are initialized on first use. Make
+ * sure this happens before the workers start.
+ */
+static void tep_init_parsers(struct kshark_data_stream *stream,
+			     struct tracecmd_input *input)
+{
+	struct tep_handle *tep = kshark_get_tep(stream);
+	struct tep_record *rec;
+	int cpu;
+
+	for (cpu = 0; cpu < stream->n_cpus; ++cpu) {
+		rec = tracecmd_read_cpu_first(input, cpu);
+		if (rec) {
+			tep_data_type(tep, rec);
+			tep_data_pid(tep, rec);
+			tracecmd_free_record(rec);
+			break;
+		}
+	}
+}
+
+static void merge_tasks(struct kshark_hash_id *tasks,
+			struct kshark_hash_id *worker_tasks)
+{
+	struct kshark_hash_id_item *item;
+	size_t i;
+
+	for (i = 0; i < (1UL << worker_tasks->n_bits); ++i)
+		for (item = worker_tasks->hash[i]; item; item = item->next)
+			kshark_hash_id_add(tasks, item->id);
+}
+
+/**
+ * @brief Load the CPU buffers of a data stream in parallel. Each worker
+ * opens its own input handle for the trace data file and the CPU buffers
+ * are distributed dynamically between the workers. The resulting per-CPU
+ * record lists are identical to the ones of the sequential loading.
+ *
+ * @param loader Shared state of the loading.
+ * @param input Input handle of the data stream.
+ * @param n_threads Number of workers to use.
+ * @return 0 on success, -EAGAIN if the additional input handles cannot be
+ * opened (the caller should fall back to sequential loading), or -ENOMEM
+ * on memory allocation fail.
+ */
+static int load_records_parallel(struct records_loader *loader,
+				 struct tracecmd_input *input,
+				 int n_threads)
+{
+	struct kshark_data_stream *stream = loader->stream;
+	struct records_worker *workers;
+	int i, n_workers, ret = -EAGAIN;
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	pthread_cond_t go_cond;
+	// END of change
+	pthread_mutex_t lock;
+	bool *started;
+
+	workers = calloc(n_threads, sizeof(*workers));
+	started = calloc(n_threads, sizeof(*started));
+	if (!workers || !started) {
+		ret = -ENOMEM;
+		goto end;
+	}
+
+	for (n_workers = 0; n_workers < n_threads; ++n_workers) {
+		struct records_worker *worker = &workers[n_workers];
+
+		worker->loader = loader;
+		worker->tasks = kshark_hash_id_alloc(KS_TASK_HASH_NBITS);
+		if (!worker->tasks)
+			break;
+
+		worker->input = open_worker_input(stream, &worker->top_input);
+		if (!worker->input) {
+			kshark_hash_id_free(worker->tasks);
+			worker->tasks = NULL;
+			break;
+		}
+
+		//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+		if (loader->arena) {
+			worker->arena = kshark_arena_alloc(loader->arena->chunk_size);
+			if (!worker->arena) {
+				close_worker_input(worker);
+				kshark_hash_id_free(worker->tasks);
+				worker->tasks = NULL;
+				break;
+			}
+		}
+		// END of change
+	}
+
+	if (n_workers < 2)
+		goto close;
+
+	if (pthread_mutex_init(&lock, NULL) != 0)
+		goto close;
+
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	if (pthread_cond_init(&go_cond, NULL) != 0) {
+		pthread_mutex_destroy(&lock);
+		goto close;
+	}
+	// END of change
+
+	tep_init_parsers(stream, input);
+
+	loader->lock = &lock;
+	loader->next_cpu = 0;
+	loader->failed = false;
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	loader->go_cond = &go_cond;
+	loader->go = false;
+	// END of change
+
+	/* The calling thread acts as the first worker. */
+	for (i = 1; i < n_workers; ++i)
+		started[i] = pthread_create(&workers[i].thread, NULL,
+					    records_worker_thread,
+					    &workers[i]) == 0;
+
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	/*
+	 * When loading in time windows, the CPU buffers are distributed
+	 * statically between the workers that have actually started.
+	 */
+	pthread_mutex_lock(&lock);
+	loader->n_workers = 1;
+	for (i = 1; i < n_workers; ++i)
+		if (started[i])
+			workers[i].index = loader->n_workers++;
+
+	loader->go = true;
+	pthread_cond_broadcast(&go_cond);
+	pthread_mutex_unlock(&lock);
+	// END of change
+
+	records_worker_func(&workers[0]);
+
+	for (i = 1; i < n_workers; ++i)
+		if (started[i])
+			pthread_join(workers[i].thread, NULL);
+
+	loader->lock = NULL;
+	pthread_mutex_destroy(&lock);
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	loader->go_cond = NULL;
+	pthread_cond_destroy(&go_cond);
+	// END of change
+
+	for (i = 0; i < n_workers; ++i) {
+		merge_tasks(stream->tasks, workers[i].tasks);
+
+		//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+		/* The nodes of the per-CPU lists are now owned by the loader. */
+		if (workers[i].arena)
+			kshark_arena_merge(loader->arena, workers[i].arena);
+		// END of change
+	}
+
+	ret = loader->failed ? -ENOMEM : 0;
+
+ close:
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	/*
+	 * After a failure, some CPU buffers have a pending record, read using
+	 * the input handle of a worker. It must be freed before the handle.
+	 */
+	for (i = 0; i < stream->n_cpus; ++i) {
+		tracecmd_free_record(loader->cpu_state[i].pending);
+		loader->cpu_state[i].pending = NULL;
+	}
+	// END of change
+
+	for (i = 0; i < n_workers; ++i) {
+		close_worker_input(&workers[i]);
+		kshark_hash_id_free(workers[i].tasks);
+		//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+		kshark_arena_free(workers[i].arena);
+		// END of change
+	}
+
+ end:
+	free(workers);
+	free(started);
+
+	return ret;
+}
+// END of change
+
+//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+static int records_loader_init(struct records_loader *loader,
+			       struct kshark_context *kshark_ctx,
+			       struct kshark_data_stream *stream,
+			       enum rec_type type,
+			       struct kshark_mem_arena *arena)
+{
+	//NOTE: Changed here. (COUPLEBREAK) (2025-03-21)
+	// Resets couplebreak state on each load of a stream.
+	stream->couplebreak_evts_flags = 0;
+	stream->n_couplebreak_evts = 0;
+	// END of change
+
+	memset(loader, 0, sizeof(*loader));
+	loader->kshark_ctx = kshark_ctx;
+	loader->stream = stream;
+	loader->type = type;
+	loader->sched_waking_id = get_sched_waking_id(stream);
+	loader->arena = arena;
+	loader->n_windows = 1;
+
+	if (type == REC_ENTRY) {
+		loader->adv_filter = get_adv_filter(stream);
+
+		//NOTE: Changed here. (ADV FILTER REFRESH) (2026-10-17)
+		/* The loaded entries will be filtered. */
+		stream->filter_is_applied =
+			kshark_filter_is_set(kshark_ctx, stream->stream_id) ||
+			kshark_tep_filter_is_set(stream);
+		// END of change
+	}
+
+	//NOTE: Changed here. (ID SETS) (2026-10-17)
+	/* The workers only read the Id filters. Failure is not fatal. */
+	kshark_update_filter_sets(kshark_ctx, stream->stream_id);
+	// END of change
+
+	loader->cpu_list = calloc(stream->n_cpus, sizeof(*loader->cpu_list));
+	loader->cpu_state = calloc(stream->n_cpus, sizeof(*loader->cpu_state));
+	if (!loader->cpu_list || !loader->cpu_state) {
+		free(loader->cpu_list);
+		free(loader->cpu_state);
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Release the loading state. If "failed" is set, the per-CPU record
+ * lists are released as well.
+ */
+static void records_loader_free(struct records_loader *loader, bool failed)
+{
+	int cpu;
+
+	for (cpu = 0; cpu < loader->stream->n_cpus; ++cpu)
+		tracecmd_free_record(loader->cpu_state[cpu].pending);
+
+	free(loader->cpu_state);
+	loader->cpu_state = NULL;
+
+	if (failed) {
+		free_rec_list(loader->cpu_list, loader->stream->n_cpus,
+			      loader->type, loader->arena);
+		loader->cpu_list = NULL;
+	}
+}
+
+/** Sum the number of records loaded and register the idle CPUs. */
+static ssize_t records_loader_total(struct records_loader *loader)
+{
+	struct kshark_data_stream *stream = loader->stream;
+	ssize_t total = 0;
+	int cpu;
+
+	for (cpu = 0; cpu < stream->n_cpus; ++cpu) {
+		if (!loader->cpu_state[cpu].count)
+			kshark_hash_id_add(stream->idle_cpus, cpu);
+		else
+			total += loader->cpu_state[cpu].count;
+	}
+
+	return total;
+}
+// END of change
+
+//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+/**
+ * @brief Read all records of a data stream into per-CPU record lists.
+ *
+ * @param kshark_ctx KernelShark context.
+ * @param stream Data stream pointer.
+ * @param rec_list Output location for the array of per-CPU record lists.
+ * @param type The type of the record lists.
+ * @param arena Memory arena to allocate the list nodes from. If NULL, each
+ * node is allocated individually.
+ * @return The total number of records (entries), or a negative error code
+ * on failure.
+ */
+static ssize_t get_records(struct kshark_context *kshark_ctx,
+			   struct kshark_data_stream *stream,
+			   struct rec_list ***rec_list,
+			   enum rec_type type,
+			   struct kshark_mem_arena *arena)
+// END of change
+{
+	//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+	struct records_loader loader;
+	struct records_worker worker = {};
+	struct tracecmd_input *input;
+	ssize_t total;
+	int ret;
+	//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+	int n_threads;
+	// END of change
+
+	input = kshark_get_tep_input(stream);
+	if (!input)
+		return -EFAULT;
+
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	if (records_loader_init(&loader, kshark_ctx, stream, type, arena) < 0)
+		return -ENOMEM;
+
+	/*
+	 * If the progress of the loading is reported, the stream is loaded
+	 * in consecutive time windows, so that the reported progress has a
+	 * meaning in terms of both the data read and the time covered.
+	 */
+	if (type == REC_ENTRY && kshark_ctx->load_progress_func)
+		init_load_windows(&loader, input, KS_LOAD_PROGRESS_STEPS);
+	// END of change
+
+	/*
+	 * The raw records (REC_RECORD) are owned by the input handle used to
+	 * read them. They outlive the loading, hence they can only be read
+	 * using the input handle of the stream.
+	 */
+	ret = -EAGAIN;
+	//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+	if (type == REC_ENTRY) {
+		n_threads = reserve_load_threads(kshark_ctx,
+						 get_load_threads(stream));
+		if (n_threads > 1)
+			ret = load_records_parallel(&loader, input, n_threads);
+
+		release_load_threads(kshark_ctx, n_threads);
+	}
+	// END of change
+
+	if (ret == -EAGAIN) {
+		/* Sequential loading, using the input handle of the stream. */
+		worker.loader = &loader;
+		worker.input = input;
+		worker.tasks = stream->tasks;
+		worker.arena = arena;
+
+		//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+		loader.n_workers = 1;
+		records_worker_func(&worker);
+		if (loader.failed)
+			goto fail;
+		// END of change
+	} else if (ret < 0) {
+		goto fail;
+	}
+
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	total = records_loader_total(&loader);
+	records_loader_free(&loader, false);
+	// END of change
+	*rec_list = loader.cpu_list;
+	// END of change
+
+	//NOTE: Changed here. (COUPLEBREAK LINEAR) (2026-10-17)
+	/*
+	 * The CPUs of couplebreak events get corrected once the entries are
+	 * merged in time, see get_sorted_entries().
+	 */
+	// END of change
+
+	return total;
+
+ fail:
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	records_loader_free(&loader, true);
+	// END of change
+	return -ENOMEM;
+}
+
+//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+/**
+ * @brief Load the entries of a data stream from its entry cache (if any).
+ *
+ * @return The number of entries, or a negative error code if the entries
+ * have to be decoded from the records.
+ */
+static ssize_t load_cached_entries(struct kshark_context *kshark_ctx,
+				   struct kshark_data_stream *stream,
+				   struct kshark_entry ***data_rows)
+{
+	ssize_t total;
+
+	/* The cache always holds all entries of the stream. */
+	if (!stream->entry_cache || load_options_set(stream))
+		return -ENOENT;
+
+	total = kshark_tep_cache_load(kshark_ctx, stream, data_rows);
+	if (total < 0) {
+		/* Missing or stale cache. Decode the records. */
+		kshark_arena_clear(stream->entry_arena);
+	}
+
+	return total;
+}
+
+/** Save all (decoded) entries of a data stream into its entry cache. */
+static void save_cached_entries(struct kshark_context *kshark_ctx,
+				struct kshark_data_stream *stream,
+				struct kshark_entry **rows, ssize_t total)
+{
+	if (stream->entry_cache && !load_options_set(stream) &&
+	    kshark_tep_cache_save(kshark_ctx, stream, rows, total) < 0)
+		fprintf(stderr, "Failed to write the entry cache of %s.\n",
+			stream->file);
+}
+// END of change
+
+/**
+ * @brief Load the content of the trace data file asociated with a given
+ *	  Data stream into an array of kshark_entries. This function
+ *	  provides an abstraction of the entries from the raw data
+ *	  that is read, however the "latency" and the "info" fields can be
+ *	  accessed only via the offset into the file. This makes the access
+ *	  to these two fields much slower.
+ *	  If one or more filters are set, the "visible" fields of each entry
+ *	  is updated according to the criteria provided by the filters. The
+ *	  field "filter_mask" of the session's context is used to control the
+ *	  level of visibility/invisibility of the filtered entries.
+ *
+ * @param stream: Input location for the FTRACE data stream pointer.
+ * @param kshark_ctx: Input location for context pointer.
+ * @param data_rows: Output location for the trace data. The user is
+ *		     responsible for freeing the elements of the outputted
+ *		     array.
+ *
+ * @returns The size of the outputted data in the case of success, or a
+ *	    negative error code on failure.
+ */
+ssize_t tepdata_load_entries(struct kshark_data_stream *stream,
+				struct kshark_context *kshark_ctx,
+				struct kshark_entry ***data_rows)
+{
+	enum rec_type type = REC_ENTRY;
+	struct kshark_entry **rows;
+	struct rec_list **rec_list;
+	ssize_t total = 0;
+
+	//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+	/*
+	 * The entries are owned by the arena of the stream (if any). The
+	 * entries from the previous loading of the stream get released.
+	 */
+	kshark_arena_clear(stream->entry_arena);
+	// END of change
+
+	//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+	total = load_cached_entries(kshark_ctx, stream, data_rows);
+	if (total >= 0)
+		return total;
+	// END of change
+
+	//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+	total = get_records(kshark_ctx, stream, &rec_list, type,
+			    stream->entry_arena);
+	// END of change
+	if (total < 0)
+		goto fail;
+
+	//NOTE: Changed here. (COUPLEBREAK LINEAR) (2026-10-17)
+	rows = get_sorted_entries(stream, rec_list, total, stream->entry_arena);
+	if (!rows)
+		goto fail_free;
+	// END of change
+
+	/* There should be no entries left in rec_list. */
+	free_rec_list(rec_list, stream->n_cpus, type, stream->entry_arena);
+	*data_rows = rows;
+
+	//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+	save_cached_entries(kshark_ctx, stream, rows, total);
+	// END of change
+
+	return total;
+
+ fail_free:
+	free_rec_list(rec_list, stream->n_cpus, type, stream->entry_arena);
+
+ fail:
+	fprintf(stderr, "Failed to allocate memory during data loading.\n");
+	return -ENOMEM;
+}
+
+//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+/**
+ * @brief Load one time window of all CPU buffers and merge the new entries
+ * into the output array.
+ *
+ * @return The number of new entries, or -ENOMEM on memory allocation fail.
+ */
+static ssize_t load_window_entries(struct records_worker *worker, int window,
+				   struct kshark_entry ***rows, ssize_t total)
+{
+	struct records_loader *loader = worker->loader;
+	int cpu, n_cpus = loader->stream->n_cpus;
+	struct kshark_entry **new_rows;
+	struct rec_list *segment[n_cpus];
+	struct rec_list **tail;
+	ssize_t count, n_new = 0;
+
+	for (cpu = 0; cpu < n_cpus; ++cpu) {
+		tail = loader->cpu_state[cpu].tail;
+		count = load_cpu_records(worker, cpu,
+					 load_window_limit(loader, window));
+		if (count < 0)
+			return -ENOMEM;
+
+		/* The first node appended in this time window. */
+		segment[cpu] = tail ? *tail : loader->cpu_list[cpu];
+		n_new += count;
+
+		finish_load_window(loader, cpu, window);
+	}
+
+	if (!n_new)
+		return 0;
+
+	new_rows = realloc(*rows, (total + n_new) * sizeof(*new_rows));
+	if (!new_rows)
+		return -ENOMEM;
+
+	*rows = new_rows;
+	if (fill_sorted_entries(loader->stream, segment,
+				new_rows + total, n_new) < 0)
+		return -ENOMEM;
+
+	return n_new;
+}
+
+/**
+ * @brief Load the entries of an FTRACE data stream in consecutive time
+ *	  windows, delivering the entries of each window as a batch.
+ *
+ * @param stream: Input location for the FTRACE data stream pointer.
+ * @param kshark_ctx: Input location for context pointer.
+ * @param batch_func: Function receiving the batches of entries. Can be NULL.
+ * @param data: User data passed to the batch function.
+ * @param data_rows: Output location for the trace data. The user is
+ *		     responsible for freeing the elements of the outputted
+ *		     array. If NULL, the entries of each batch are released
+ *		     as soon as the batch function returns.
+ *
+ * @returns The size of the outputted data (or the total number of
+ *	    delivered entries, if "data_rows" is NULL) in the case of success,
+ *	    or a negative error code on failure.
+ *
+ * @note The load options of the stream apply, as for tepdata_load_entries().
+ *	 If "data_rows" is set, so does the entry cache of the stream. The
+ *	 entries found in the cache are delivered as a single batch. If
+ *	 "data_rows" is NULL, the event-specific plugin actions are not run,
+ *	 because the plugins may keep pointers to the released entries.
+ */
+ssize_t kshark_tep_load_entries_progressive(struct kshark_data_stream *stream,
+					    struct kshark_context *kshark_ctx,
+					    kshark_load_batch_func batch_func,
+					    void *data,
+					    struct kshark_entry ***data_rows)
+{
+	struct kshark_load_progress progress;
+	struct records_worker worker = {};
+	struct kshark_entry **rows = NULL;
+	struct records_loader loader;
+	struct tracecmd_input *input;
+	ssize_t n_new, total = 0;
+	int window;
+	//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+	struct kshark_mem_arena *arena = stream->entry_arena;
+	ssize_t n_delivered = 0;
+	int cpu;
+	// END of change
+
+	input = kshark_get_tep_input(stream);
+	if (!input)
+		return -EFAULT;
+
+	//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+	if (!data_rows) {
+		/*
+		 * The entries do not outlive their batch. They are allocated
+		 * from a temporary arena, which is cleared after each window.
+		 */
+		arena = kshark_arena_alloc(0);
+		if (!arena)
+			goto fail;
+	} else {
+		/*
+		 * The entries from the previous loading of the stream get
+		 * released.
+		 */
+		kshark_arena_clear(stream->entry_arena);
+
+		/* Entries from the entry cache are delivered as one batch. */
+		total = load_cached_entries(kshark_ctx, stream, data_rows);
+		if (total >= 0) {
+			if (total && batch_func) {
+				rows = *data_rows;
+				progress.bytes_done = progress.bytes_total = 1;
+				progress.ts_first = rows[0]->ts;
+				progress.ts_loaded = progress.ts_last =
+					rows[total - 1]->ts;
+
+				batch_func(stream, rows, total, &progress,
+					   data);
+			}
+
+			return total;
+		}
+
+		total = 0;
+	}
+
+	if (records_loader_init(&loader, kshark_ctx, stream, REC_ENTRY,
+				arena) < 0)
+		goto fail_arena;
+
+	/*
+	 * The entries of each window are released once delivered, hence no
+	 * plugin may keep pointers to them.
+	 */
+	loader.no_plugin_actions = !data_rows;
+	// END of change
+
+	init_load_windows(&loader, input, KS_LOAD_PROGRESS_STEPS);
+
+	/*
+	 * The batches are delivered by the calling thread, hence the CPU
+	 * buffers are read sequentially, using the input handle of the stream.
+	 */
+	worker.loader = &loader;
+	worker.input = input;
+	worker.tasks = stream->tasks;
+	//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+	worker.arena = arena;
+	// END of change
+	loader.n_workers = 1;
+
+	for (window = 0; window < loader.n_windows; ++window) {
+		n_new = load_window_entries(&worker, window, &rows, total);
+		if (n_new < 0)
+			goto fail_free;
+
+		if (n_new && batch_func) {
+			get_load_progress(&loader, &progress);
+			batch_func(stream, rows + total, n_new, &progress, data);
+		}
+
+		//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+		if (data_rows) {
+			total += n_new;
+			continue;
+		}
+
+		/*
+		 * Release the entries of the window. The loading of each CPU
+		 * buffer continues in a new (empty) record list.
+		 */
+		n_delivered += n_new;
+		kshark_arena_clear(arena);
+		for (cpu = 0; cpu < stream->n_cpus; ++cpu) {
+			loader.cpu_list[cpu] = NULL;
+			if (loader.cpu_state[cpu].tail)
+				loader.cpu_state[cpu].tail =
+					&loader.cpu_list[cpu];
+		}
+		// END of change
+	}
+
+	/* Register the idle CPUs. */
+	records_loader_total(&loader);
+	records_loader_free(&loader, false);
+
+	//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+	if (!data_rows) {
+		free(loader.cpu_list);
+		free(rows);
+		kshark_arena_free(arena);
+
+		return n_delivered;
+	}
+	// END of change
+
+	//NOTE: Changed here. (WINDOWED LOAD) (2026-10-17)
+	if (stream->couplebreak_on &&
+	    correct_couplebreak_cpus(rows, total, INT64_MAX) < 0)
+		goto fail_lists;
+	// END of change
+
+	/* The list nodes are now owned by the output array. */
+	free(loader.cpu_list);
+	*data_rows = rows;
+
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	save_cached_entries(kshark_ctx, stream, rows, total);
+	// END of change
+
+	return total;
+
+ fail_free:
+	records_loader_free(&loader, false);
+
+ fail_lists:
+	/* The per-CPU lists are intact. They own all loaded entries. */
+	//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+	free_rec_list(loader.cpu_list, stream->n_cpus, REC_ENTRY, arena);
+	free(rows);
+
+ fail_arena:
+	if (!data_rows)
+		kshark_arena_free(arena);
+	// END of change
+
+ fail:
+	fprintf(stderr, "Failed to allocate memory during data loading.\n");
+	return -ENOMEM;
+}
+// END of change
+
+//NOTE: Changed here. (WINDOWED LOAD) (2026-10-17)
+/** The number of trace data pages, indexed together as one block. */
+#define KS_WINDOW_BLOCK_PAGES	64
+
+/** Page size, used if the page size of the trace data is unknown. */
+#define KS_WINDOW_DEFAULT_PAGE	4096
+
+/**
+ * @brief Block of consecutive pages of a CPU buffer. The records of the block
+ * are decoded together, when the block overlaps the requested time window.
+ */
+struct window_block {
+	/** File offset of the first record of the block. */
+	uint64_t		offset;
+
+	/** The (calibrated) timestamp of the first record of the block. */
+	int64_t			ts_first;
+
+	/** The (calibrated) timestamp of the last record of the block. */
+	int64_t			ts_last;
+
+	/**
+	 * Memory arena owning the decoded entries of the block. NULL if the
+	 * block is not decoded.
+	 */
+	struct kshark_mem_arena	*arena;
+
+	/** The first decoded entry of the block. */
+	struct rec_list		*first;
+
+	/** The last decoded entry of the block. */
+	struct rec_list		*last;
+
+	/** The number of decoded entries. */
+	ssize_t			n_entries;
+
+	/** Previous (more recently used) decoded block. */
+	struct window_block	*lru_prev;
+
+	/** Next (less recently used) decoded block. */
+	struct window_block	*lru_next;
+
+	/** The last load of a time window, which requested the block. */
+	unsigned int		generation;
+
+	/** CPU Id. */
+	int			cpu;
+};
+
+/** Index of the blocks of a CPU buffer. */
+struct window_cpu {
+	/** Array of blocks, sorted in time. */
+	struct window_block	*blocks;
+
+	/** The number of blocks. */
+	size_t			n_blocks;
+
+	/** The first block overlapping the current time window. */
+	size_t			first;
+
+	/** The block just after the last one overlapping the time window. */
+	size_t			end;
+};
+
+/** Windowed access to the trace data of a Data stream. */
+struct kshark_tep_window {
+	/** Data stream. */
+	struct kshark_data_stream	*stream;
+
+	/** Loading state, used when decoding the blocks. */
+	struct records_loader		loader;
+
+	/** The only worker decoding the blocks. */
+	struct records_worker		worker;
+
+	/** Index of the blocks of each CPU buffer. */
+	struct window_cpu		*cpus;
+
+	/** The most recently used decoded block. */
+	struct window_block		*lru_head;
+
+	/** The least recently used decoded block. */
+	struct window_block		*lru_tail;
+
+	/** The memory budget of the decoded blocks in bytes. */
+	size_t				max_bytes;
+
+	/** Output array of entries of the current time window. */
+	struct kshark_entry		**rows;
+
+	/** The number of loads of a time window. */
+	unsigned int			generation;
+
+	/** Statistics. */
+	struct kshark_tep_window_stats	stats;
+};
+
+/** Append a new block, starting at a given record, to the index of a CPU. */
+static struct window_block *window_add_block(struct kshark_tep_window *win,
+					     int cpu, struct tep_record *rec,
+					     size_t *capacity)
+{
+	struct window_cpu *wcpu = &win->cpus[cpu];
+	struct window_block *block, *blocks;
+
+	if (wcpu->n_blocks == *capacity) {
+		*capacity = *capacity ? *capacity * 2 : 64;
+		blocks = realloc(wcpu->blocks, *capacity * sizeof(*blocks));
+		if (!blocks)
+			return NULL;
+
+		wcpu->blocks = blocks;
+	}
+
+	block = &wcpu->blocks[wcpu->n_blocks++];
+	memset(block, 0, sizeof(*block));
+	block->offset = rec->offset;
+	block->ts_first = block->ts_last = calib_ts(win->stream, rec->ts);
+	block->cpu = cpu;
+
+	return block;
+}
+
+/**
+ * @brief Index the CPU buffer in blocks of pages. Only the first record of
+ * each block is read. tracecmd_read_at() loads just the page holding a given
+ * offset, hence a single page per block is read from the file. The last
+ * record of a block is not known, so the timestamp of the first record of the
+ * next block is used as an upper bound of the block.
+ */
+static int window_index_cpu(struct kshark_tep_window *win, int cpu,
+			    uint64_t block_size)
+{
+	struct tracecmd_input *input = win->worker.input;
+	struct kshark_data_stream *stream = win->stream;
+	struct window_cpu *wcpu = &win->cpus[cpu];
+	struct window_block *block = NULL;
+	uint64_t probe, next_probe;
+	struct tep_record *rec;
+	size_t capacity = 0;
+	int rec_cpu;
+	int64_t ts;
+
+	rec = tracecmd_read_cpu_first(input, cpu);
+	if (!rec) {
+		kshark_hash_id_add(stream->idle_cpus, cpu);
+		return 0;
+	}
+
+	probe = 0;
+	while (rec) {
+		ts = calib_ts(stream, rec->ts);
+		if (block)
+			block->ts_last = ts;
+
+		block = window_add_block(win, cpu, rec, &capacity);
+		tracecmd_free_record(rec);
+		if (!block)
+			return -ENOMEM;
+
+		/* Probe the first page of the next block. */
+		next_probe = (block->offset / block_size + 1) * block_size;
+		probe = (next_probe > probe) ? next_probe : probe + block_size;
+
+		/*
+		 * Past the last page of the buffer, the offset belongs to
+		 * another CPU or to no CPU at all.
+		 */
+		rec = tracecmd_read_at(input, probe, &rec_cpu);
+		if (rec && (rec_cpu != cpu || rec->offset <= block->offset)) {
+			tracecmd_free_record(rec);
+			rec = NULL;
+		}
+	}
+
+	/* Get the upper bound of the last block. */
+	rec = read_cpu_last(stream, input, cpu, wcpu->blocks[0].offset);
+	if (rec) {
+		block->ts_last = calib_ts(stream, rec->ts);
+		tracecmd_free_record(rec);
+	} else {
+		/* Read the headers of the records of the last block. */
+		rec = tracecmd_read_at(input, block->offset, NULL);
+		while (rec) {
+			ts = calib_ts(stream, rec->ts);
+			if (ts > block->ts_last)
+				block->ts_last = ts;
+
+			tracecmd_free_record(rec);
+			rec = tracecmd_read_data(input, cpu);
+		}
+	}
+
+	return 0;
+}
+
+static void window_lru_unlink(struct kshark_tep_window *win,
+			      struct window_block *block)
+{
+	if (block->lru_prev)
+		block->lru_prev->lru_next = block->lru_next;
+	else
+		win->lru_head = block->lru_next;
+
+	if (block->lru_next)
+		block->lru_next->lru_prev = block->lru_prev;
+	else
+		win->lru_tail = block->lru_prev;
+
+	block->lru_prev = block->lru_next = NULL;
+}
+
+static void window_lru_push(struct kshark_tep_window *win,
+			    struct window_block *block)
+{
+	block->lru_prev = NULL;
+	block->lru_next = win->lru_head;
+	if (win->lru_head)
+		win->lru_head->lru_prev = block;
+	else
+		win->lru_tail = block;
+
+	win->lru_head = block;
+}
+
+static void window_evict_block(struct kshark_tep_window *win,
+			       struct window_block *block)
+{
+	window_lru_unlink(win, block);
+
+	win->stats.n_bytes -= block->arena->n_bytes;
+	--win->stats.n_blocks;
+	++win->stats.n_evicted;
+
+	kshark_arena_free(block->arena);
+	block->arena = NULL;
+	block->first = block->last = NULL;
+	block->n_entries = 0;
+}
+
+/**
+ * @brief Evict the least recently used blocks, until the decoded data fits
+ * the memory budget. The blocks of the current time window are never evicted.
+ */
+static void window_shrink(struct kshark_tep_window *win)
+{
+	struct window_block *block;
+
+	while (win->stats.n_bytes > win->max_bytes) {
+		block = win->lru_tail;
+		if (!block || block->generation == win->generation)
+			break;
+
+		window_evict_block(win, block);
+	}
+}
+
+static int window_decode_block(struct kshark_tep_window *win,
+			       struct window_block *block)
+{
+	struct cpu_load_state *state = &win->loader.cpu_state[block->cpu];
+	struct kshark_data_stream *stream = win->stream;
+	struct window_cpu *wcpu = &win->cpus[block->cpu];
+	size_t next = block - wcpu->blocks + 1;
+	struct tep_record *rec;
+	ssize_t count;
+
+	block->arena = kshark_arena_alloc(0);
+	if (!block->arena)
+		return -ENOMEM;
+
+	pthread_mutex_lock(&stream->input_mutex);
+
+	/*
+	 * Position the CPU buffer at the first record of the block. The
+	 * records get read till the first record of the next block.
+	 */
+	rec = tracecmd_read_at(win->worker.input, block->offset, NULL);
+	if (!rec) {
+		pthread_mutex_unlock(&stream->input_mutex);
+		kshark_arena_free(block->arena);
+		block->arena = NULL;
+		return -EFAULT;
+	}
+
+	memset(state, 0, sizeof(*state));
+	block->first = NULL;
+	state->tail = &block->first;
+	state->pending = rec;
+	if (next < wcpu->n_blocks)
+		state->stop_offset = wcpu->blocks[next].offset;
+
+	win->worker.arena = block->arena;
+	count = load_cpu_records(&win->worker, block->cpu, INT64_MAX);
+
+	tracecmd_free_record(state->pending);
+	state->pending = NULL;
+
+	pthread_mutex_unlock(&stream->input_mutex);
+
+	if (count < 0) {
+		kshark_arena_free(block->arena);
+		block->arena = NULL;
+		return count;
+	}
+
+	/* "next" is the first member of the node, hence the tail is the node. */
+	block->last = count ? (struct rec_list *) state->tail : NULL;
+	block->n_entries = count;
+
+	win->stats.n_bytes += block->arena->n_bytes;
+	++win->stats.n_blocks;
+
+	return 0;
+}
+
+/** Find the blocks of a CPU buffer, overlapping a given time interval. */
+static void window_cpu_range(struct window_cpu *wcpu, int64_t min, int64_t max)
+{
+	size_t l = 0, h = wcpu->n_blocks, mid;
+
+	/* The first block, ending not earlier than "min". */
+	while (l < h) {
+		mid = l + (h - l) / 2;
+		if (wcpu->blocks[mid].ts_last < min)
+			l = mid + 1;
+		else
+			h = mid;
+	}
+
+	wcpu->first = wcpu->end = l;
+	while (wcpu->end < wcpu->n_blocks &&
+	       wcpu->blocks[wcpu->end].ts_first <= max)
+		++wcpu->end;
+}
+
+/** Find the first of time-sorted entries, not earlier than a given time. */
+static ssize_t window_rows_from(struct kshark_entry **rows, ssize_t n,
+			       int64_t ts)
+{
+	ssize_t l = 0, h = n, mid;
+
+	while (l < h) {
+		mid = l + (h - l) / 2;
+		if (rows[mid]->ts < ts)
+			l = mid + 1;
+		else
+			h = mid;
+	}
+
+	return l;
+}
+
+/**
+ * @brief Open windowed access to the trace data of a Data stream. The CPU
+ *	  buffers get indexed in blocks of pages, reading a single page per
+ *	  block and without loading the entries. The entries are decoded
+ *	  later, only for the blocks overlapping the requested time window.
+ *
+ * @note The event-specific plugin actions are not run on the decoded
+ *	 entries, because the plugins may keep pointers to the entries of
+ *	 evicted blocks.
+ *
+ * @param kshark_ctx: Input location for context pointer.
+ * @param sd: Data stream identifier.
+ * @param max_bytes: Memory budget of the decoded entries in bytes. The least
+ *		     recently used blocks get evicted, if the budget is
+ *		     exceeded.
+ *
+ * @returns Windowed access object on success, or NULL on failure. The user
+ *	    is responsible for closing it with kshark_tep_window_close().
+ */
+struct kshark_tep_window *
+kshark_tep_window_open(struct kshark_context *kshark_ctx, int sd,
+		       size_t max_bytes)
+{
+	struct kshark_data_stream *stream;
+	struct kshark_tep_window *win;
+	uint64_t block_size;
+	int cpu, page_size;
+
+	stream = kshark_get_data_stream(kshark_ctx, sd);
+	if (!stream || !kshark_is_tep(stream))
+		return NULL;
+
+	win = calloc(1, sizeof(*win));
+	if (!win)
+		goto fail;
+
+	win->stream = stream;
+	win->max_bytes = max_bytes;
+	win->cpus = calloc(stream->n_cpus, sizeof(*win->cpus));
+	if (!win->cpus) {
+		free(win);
+		goto fail;
+	}
+
+	if (records_loader_init(&win->loader, kshark_ctx, stream, REC_ENTRY,
+				NULL) < 0) {
+		free(win->cpus);
+		free(win);
+		goto fail;
+	}
+
+	/*
+	 * The decoded blocks get evicted and possibly decoded again, hence
+	 * no plugin may keep pointers to their entries.
+	 */
+	win->loader.no_plugin_actions = true;
+	win->loader.n_workers = 1;
+	win->worker.loader = &win->loader;
+	win->worker.input = kshark_get_tep_input(stream);
+	win->worker.tasks = stream->tasks;
+
+	page_size = tep_get_page_size(kshark_get_tep(stream));
+	if (page_size <= 0)
+		page_size = KS_WINDOW_DEFAULT_PAGE;
+
+	block_size = (uint64_t) page_size * KS_WINDOW_BLOCK_PAGES;
+
+	pthread_mutex_lock(&stream->input_mutex);
+
+	for (cpu = 0; cpu < stream->n_cpus; ++cpu) {
+		if (window_index_cpu(win, cpu, block_size) < 0) {
+			pthread_mutex_unlock(&stream->input_mutex);
+			kshark_tep_window_close(win);
+			goto fail;
+		}
+	}
+
+	pthread_mutex_unlock(&stream->input_mutex);
+
+	return win;
+
+ fail:
+	fprintf(stderr, "Failed to allocate memory during data indexing.\n");
+	return NULL;
+}
+
+/**
+ * @brief Close windowed access to the trace data. All decoded entries get
+ *	  released.
+ *
+ * @param win: Windowed access object.
+ */
+void kshark_tep_window_close(struct kshark_tep_window *win)
+{
+	struct window_cpu *wcpu;
+	size_t i;
+	int cpu;
+
+	if (!win)
+		return;
+
+	for (cpu = 0; cpu < win->stream->n_cpus; ++cpu) {
+		wcpu = &win->cpus[cpu];
+		for (i = 0; i < wcpu->n_blocks; ++i)
+			kshark_arena_free(wcpu->blocks[i].arena);
+
+		free(wcpu->blocks);
+	}
+
+	records_loader_free(&win->loader, false);
+	free(win->loader.cpu_list);
+	free(win->cpus);
+	free(win->rows);
+	free(win);
+}
+
+/**
+ * @brief Get the time span of the trace data.
+ *
+ * @param win: Windowed access object.
+ * @param first: Output location for the timestamp of the first record.
+ * @param last: Output location for the timestamp of the last record.
+ *
+ * @returns True on success, or false if the trace data is empty.
+ */
+bool kshark_tep_window_span(const struct kshark_tep_window *win,
+			    int64_t *first, int64_t *last)
+{
+	const struct window_cpu *wcpu;
+	bool found = false;
+	int cpu;
+
+	*first = INT64_MAX;
+	*last = INT64_MIN;
+	for (cpu = 0; cpu < win->stream->n_cpus; ++cpu) {
+		wcpu = &win->cpus[cpu];
+		if (!wcpu->n_blocks)
+			continue;
+
+		if (wcpu->blocks[0].ts_first < *first)
+			*first = wcpu->blocks[0].ts_first;
+
+		if (wcpu->blocks[wcpu->n_blocks - 1].ts_last > *last)
+			*last = wcpu->blocks[wcpu->n_blocks - 1].ts_last;
+
+		found = true;
+	}
+
+	return found;
+}
+
+/**
+ * @brief Load the entries of a time window. Besides the blocks of pages
+ *	  overlapping the window, the blocks within a margin of half of the
+ *	  window size at each side get decoded as well, so that the entries
+ *	  are ready when the window gets shifted. Only the entries inside the
+ *	  window are outputted.
+ *
+ * @param win: Windowed access object.
+ * @param min: Lower edge of the time window (included).
+ * @param max: Upper edge of the time window (included).
+ * @param data_rows: Output location for the time-sorted array of the
+ *		     entries between "min" and "max". The array and the
+ *		     entries are owned by "win". They stay valid till the next
+ *		     call of this function or till "win" is closed.
+ *
+ * @returns The size of the outputted data in the case of success, or a
+ *	    negative error code on failure.
+ *
+ * @note If couplebreak is enabled, the CPUs of its wakeup entries are
+ *	 corrected using the switches of the decoded blocks. A wakeup,
+ *	 switched in after the decoded blocks, keeps its CPU.
  */
-ssize_t tepdata_load_entries(struct kshark_data_stream *stream,
-				struct kshark_context *kshark_ctx,
-				struct kshark_entry ***data_rows)
+ssize_t kshark_tep_window_load(struct kshark_tep_window *win,
+			       int64_t min, int64_t max,
+			       struct kshark_entry ***data_rows)
 {
-	enum rec_type type = REC_ENTRY;
+	struct kshark_data_stream *stream = win->stream;
+	struct rec_list **heads, *last;
+	struct window_block *block;
 	struct kshark_entry **rows;
-	struct rec_list **rec_list;
-	ssize_t count, total = 0;
+	struct window_cpu *wcpu;
+	int64_t margin, lo, hi, horizon;
+	ssize_t total = 0, first, end;
+	size_t i;
+	int cpu, ret;
 
-	total = get_records(kshark_ctx, stream, &rec_list, type);
-	if (total < 0)
-		goto fail;
+	if (max < min)
+		return -EINVAL;
 
-	rows = calloc(total, sizeof(struct kshark_entry *));
-	if (!rows)
-		goto fail_free;
+	margin = (max - min) / 2;
+	if (__builtin_sub_overflow(min, margin, &lo))
+		lo = INT64_MIN;
 
-	for (count = 0; count < total; count++) {
-		int next_cpu;
+	if (__builtin_add_overflow(max, margin, &hi))
+		hi = INT64_MAX;
 
-		next_cpu = pick_next_cpu(rec_list, stream->n_cpus, type);
+	++win->generation;
 
-		if (next_cpu >= 0) {
-			rows[count] = &rec_list[next_cpu]->entry;
-			rec_list[next_cpu] = rec_list[next_cpu]->next;
+	/* Pin the cached blocks of the window, before evicting any blocks. */
+	for (cpu = 0; cpu < stream->n_cpus; ++cpu) {
+		wcpu = &win->cpus[cpu];
+		window_cpu_range(wcpu, lo, hi);
+		for (i = wcpu->first; i < wcpu->end; ++i) {
+			block = &wcpu->blocks[i];
+			block->generation = win->generation;
+			if (!block->arena)
+				continue;
+
+			++win->stats.n_hits;
+			window_lru_unlink(win, block);
+			window_lru_push(win, block);
 		}
 	}
 
-	/* There should be no entries left in rec_list. */
-	free_rec_list(rec_list, stream->n_cpus, type);
-	*data_rows = rows;
+	for (cpu = 0; cpu < stream->n_cpus; ++cpu) {
+		wcpu = &win->cpus[cpu];
+		for (i = wcpu->first; i < wcpu->end; ++i) {
+			block = &wcpu->blocks[i];
+			if (!block->arena) {
+				++win->stats.n_misses;
+				ret = window_decode_block(win, block);
+				if (ret < 0)
+					return ret;
 
-	return total;
+				window_lru_push(win, block);
 
- fail_free:
-	free_rec_list(rec_list, stream->n_cpus, type);
+				/*
+				 * Make room for the decoded block. Only the
+				 * blocks of the previous windows get evicted.
+				 */
+				window_shrink(win);
+			}
 
- fail:
-	fprintf(stderr, "Failed to allocate memory during data loading.\n");
-	return -ENOMEM;
+			total += block->n_entries;
+		}
+	}
+
+	heads = calloc(stream->n_cpus, sizeof(*heads));
+	rows = total ? realloc(win->rows, total * sizeof(*rows)) : win->rows;
+	if (!heads || (total && !rows)) {
+		free(heads);
+		return -ENOMEM;
+	}
+
+	win->rows = rows;
+
+	/* Chain the consecutive blocks of each CPU into one list. */
+	for (cpu = 0; cpu < stream->n_cpus; ++cpu) {
+		wcpu = &win->cpus[cpu];
+		last = NULL;
+		for (i = wcpu->first; i < wcpu->end; ++i) {
+			block = &wcpu->blocks[i];
+			if (!block->n_entries)
+				continue;
+
+			if (last)
+				last->next = block->first;
+			else
+				heads[cpu] = block->first;
+
+			last = block->last;
+		}
+
+		if (last)
+			last->next = NULL;
+	}
+
+	ret = fill_sorted_entries(stream, heads, rows, total);
+	free(heads);
+	if (ret < 0)
+		return ret;
+
+	/*
+	 * All switches before the first block, which is not decoded on any
+	 * of the CPUs, are known. A wakeup waiting for a later switch keeps
+	 * its CPU.
+	 */
+	if (stream->couplebreak_on) {
+		horizon = INT64_MAX;
+		for (cpu = 0; cpu < stream->n_cpus; ++cpu) {
+			wcpu = &win->cpus[cpu];
+			if (wcpu->end < wcpu->n_blocks &&
+			    wcpu->blocks[wcpu->end].ts_first < horizon)
+				horizon = wcpu->blocks[wcpu->end].ts_first;
+		}
+
+		ret = correct_couplebreak_cpus(rows, total, horizon);
+		if (ret < 0)
+			return ret;
+	}
+
+	/* Leave out the entries of the margins. */
+	first = window_rows_from(rows, total, min);
+	end = window_rows_from(rows + first, total - first, max) + first;
+	while (end < total && rows[end]->ts == max)
+		++end;
+
+	*data_rows = rows + first;
+
+	return end - first;
 }
 
+/**
+ * @brief Get the statistics of the windowed access to the trace data.
+ *
+ * @param win: Windowed access object.
+ * @param stats: Output location for the statistics.
+ */
+void kshark_tep_window_get_stats(const struct kshark_tep_window *win,
+				 struct kshark_tep_window_stats *stats)
+{
+	*stats = win->stats;
+}
+// END of change
+
 static ssize_t tepdata_load_matrix(struct kshark_data_stream *stream,
 				   struct kshark_context *kshark_ctx,
 				   int16_t **event_array,
@@ -925,11 +3478,23 @@ static ssize_t tepdata_load_matrix(struct kshark_data_stream *stream,
 				   int64_t **ts_array)
 {
 	enum rec_type type = REC_ENTRY;
+	//NOTE: Changed here. (COUPLEBREAK LINEAR) (2026-10-17)
+	struct kshark_entry **rows;
+	// END of change
+	struct kshark_mem_arena *arena;
 	struct rec_list **rec_list;
 	ssize_t count, total = 0;
 	bool status;
 
-	total = get_records(kshark_ctx, stream, &rec_list, type);
+	//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+	/*
+	 * The list nodes are needed only until the matrix is filled. If the
+	 * arena cannot be allocated, the nodes are allocated individually.
+	 */
+	arena = kshark_arena_alloc(KS_ARENA_CHUNK_SIZE);
+
+	total = get_records(kshark_ctx, stream, &rec_list, type, arena);
+	// END of change
 	if (total < 0)
 		goto fail;
 
@@ -941,44 +3506,63 @@ static ssize_t tepdata_load_matrix(struct kshark_data_stream *stream,
 	if (!status)
 		goto fail_free;
 
-	for (count = 0; count < total; count++) {
-		int next_cpu;
-
-		next_cpu = pick_next_cpu(rec_list, stream->n_cpus, type);
-		if (next_cpu >= 0) {
-			struct rec_list *rec = rec_list[next_cpu];
-			struct kshark_entry *e = &rec->entry;
+	//NOTE: Changed here. (COUPLEBREAK LINEAR) (2026-10-17)
+	rows = get_sorted_entries(stream, rec_list, total, arena);
+	if (!rows) {
+		void **columns[] = {(void **) event_array, (void **) cpu_array,
+				    (void **) pid_array, (void **) offset_array,
+				    (void **) ts_array};
 
-			if (offset_array)
-				(*offset_array)[count] = e->offset;
+		for (size_t i = 0; i < sizeof(columns) / sizeof(*columns); ++i)
+			if (columns[i])
+				free(*columns[i]);
 
-			if (cpu_array)
-				(*cpu_array)[count] = e->cpu;
+		goto fail_free;
+	}
 
-			if (ts_array) {
-				kshark_calib_entry(stream, e);
-				(*ts_array)[count] = e->ts;
-			}
+	for (count = 0; count < total; count++) {
+		struct kshark_entry *e = rows[count];
+	// END of change
 
-			if (pid_array)
-				(*pid_array)[count] = e->pid;
+		if (offset_array)
+			(*offset_array)[count] = e->offset;
 
-			if (event_array)
-				(*event_array)[count] = e->event_id;
+		if (cpu_array)
+			(*cpu_array)[count] = e->cpu;
 
-			rec_list[next_cpu] = rec_list[next_cpu]->next;
-			free(rec);
+		if (ts_array) {
+			kshark_calib_entry(stream, e);
+			(*ts_array)[count] = e->ts;
 		}
+
+		if (pid_array)
+			(*pid_array)[count] = e->pid;
+
+		if (event_array)
+			(*event_array)[count] = e->event_id;
+
+		//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+		if (!arena)
+			free(e);
+		// END of change
 	}
 
+	//NOTE: Changed here. (COUPLEBREAK LINEAR) (2026-10-17)
+	free(rows);
+	// END of change
+
+	//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
 	/* There should be no entries left in rec_list. */
-	free_rec_list(rec_list, stream->n_cpus, type);
+	free_rec_list(rec_list, stream->n_cpus, type, arena);
+	kshark_arena_free(arena);
 	return total;
 
  fail_free:
-	free_rec_list(rec_list, stream->n_cpus, type);
+	free_rec_list(rec_list, stream->n_cpus, type, arena);
 
  fail:
+	kshark_arena_free(arena);
+	// END of change
 	fprintf(stderr, "Failed to allocate memory during data loading.\n");
 	return -ENOMEM;
 }
@@ -1001,6 +3585,10 @@ ssize_t kshark_load_tep_records(struct kshark_context *kshark_ctx, int sd,
 {
 	struct kshark_data_stream *stream;
 	enum rec_type type = REC_RECORD;
+	//NOTE: Changed here. (HEAP MERGE) (2026-10-17)
+	struct kshark_merge_heap heap;
+	// END of change
+	struct kshark_mem_arena *arena;
 	struct rec_list **rec_list;
 	struct rec_list *temp_rec;
 	struct tep_record **rows;
@@ -1014,7 +3602,12 @@ ssize_t kshark_load_tep_records(struct kshark_context *kshark_ctx, int sd,
 	if (!stream)
 		return -EBADF;
 
-	total = get_records(kshark_ctx, stream, &rec_list, type);
+	//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+	/* The list nodes are needed only until the array is filled. */
+	arena = kshark_arena_alloc(KS_ARENA_CHUNK_SIZE);
+
+	total = get_records(kshark_ctx, stream, &rec_list, type, arena);
+	// END of change
 	if (total < 0)
 		goto fail;
 
@@ -1022,10 +3615,17 @@ ssize_t kshark_load_tep_records(struct kshark_context *kshark_ctx, int sd,
 	if (!rows)
 		goto fail_free;
 
+	//NOTE: Changed here. (HEAP MERGE) (2026-10-17)
+	if (!init_cpu_heap(&heap, rec_list, stream->n_cpus, type)) {
+		free(rows);
+		goto fail_free;
+	}
+	// END of change
+
 	for (count = 0; count < total; count++) {
 		int next_cpu;
 
-		next_cpu = pick_next_cpu(rec_list, stream->n_cpus, type);
+		next_cpu = pick_next_cpu(&heap, rec_list, type);
 
 		if (next_cpu >= 0) {
 			rec = rec_list[next_cpu]->rec;
@@ -1033,21 +3633,32 @@ ssize_t kshark_load_tep_records(struct kshark_context *kshark_ctx, int sd,
 
 			temp_rec = rec_list[next_cpu];
 			rec_list[next_cpu] = rec_list[next_cpu]->next;
-			free(temp_rec);
+			//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+			if (!arena)
+				free(temp_rec);
+			// END of change
 			/* The record is still referenced in rows */
 		}
 	}
 
+	//NOTE: Changed here. (HEAP MERGE) (2026-10-17)
+	kshark_merge_heap_free(&heap);
+	// END of change
+
+	//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
 	/* There should be no records left in rec_list. */
-	free_rec_list(rec_list, stream->n_cpus, type);
+	free_rec_list(rec_list, stream->n_cpus, type, arena);
+	kshark_arena_free(arena);
 	*data_rows = rows;
 
 	return total;
 
  fail_free:
-	free_rec_list(rec_list, stream->n_cpus, type);
+	free_rec_list(rec_list, stream->n_cpus, type, arena);
 
  fail:
+	kshark_arena_free(arena);
+	// END of change
 	fprintf(stderr, "Failed to allocate memory during data loading.\n");
 	return -ENOMEM;
 }
@@ -1076,21 +3687,15 @@ static int tepdata_get_event_id(struct kshark_data_stream *stream,
 		 * The entry has been touched by a plugin callback function.
 		 * Because of this we do not trust the value of
 		 * "entry->event_id".
-		 *
-		 * Currently the data reading operations are not thread-safe.
-		 * Use a mutex to protect the access.
 		 */
-		pthread_mutex_lock(&stream->input_mutex);
-
-		record = tracecmd_read_at(kshark_get_tep_input(stream),
-					  entry->offset, NULL);
+		//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+		record = read_record(stream, entry->offset);
 
 		if (record)
 			event_id = tep_data_type(kshark_get_tep(stream), record);
 
-		tracecmd_free_record(record);
-
-		pthread_mutex_unlock(&stream->input_mutex);
+		release_record(stream, record);
+		// END of change
 	}
 
 	return (event_id == -1)? -EFAULT : event_id;
@@ -1182,10 +3787,10 @@ static int get_couplebreak_pid(struct kshark_data_stream *stream,
 	struct tep_record *record;
 	int pid = KS_EMPTY_BIN;
 
-	// Just like in the tepdata_get_pid function, we need to guard against parallel access
-	pthread_mutex_lock(&stream->input_mutex);
-	record = tracecmd_read_at(kshark_get_tep_input(stream),
-		origin_entry->offset, NULL);
+	//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+	// Just like in the tepdata_get_pid function, the record may come from the cache
+	record = read_record(stream, origin_entry->offset);
+	// END of change
 	if (record) {
 		if (entry->event_id == COUPLEBREAK_SST_ID) {
 			// Reconstruct how the PID was obtained for a switch
@@ -1203,8 +3808,9 @@ static int get_couplebreak_pid(struct kshark_data_stream *stream,
 			pid = (pid_succs == 0) ? (int32_t)waked_pid_val : origin_entry->pid;
 		}
 	}
-	tracecmd_free_record(record);
-	pthread_mutex_unlock(&stream->input_mutex);
+	//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+	release_record(stream, record);
+	// END of change
 
 	return pid;
 }
@@ -1229,21 +3835,15 @@ static int tepdata_get_pid(struct kshark_data_stream *stream,
 		/*
 		 * The entry has been touched by a plugin callback function.
 		 * Because of this we do not trust the value of "entry->pid".
-		 *
-		 * Currently the data reading operations are not thread-safe.
-		 * Use a mutex to protect the access.
 		 */
-		pthread_mutex_lock(&stream->input_mutex);
-
-		record = tracecmd_read_at(kshark_get_tep_input(stream),
-					  entry->offset, NULL);
+		//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+		record = read_record(stream, entry->offset);
 
 		if (record)
 			pid = tep_data_pid(kshark_get_tep(stream), record);
 
-		tracecmd_free_record(record);
-
-		pthread_mutex_unlock(&stream->input_mutex);
+		release_record(stream, record);
+		// END of change
 	}
 
 	return pid;
@@ -1287,26 +3887,28 @@ static char *tepdata_get_latency(struct kshark_data_stream *stream,
 	if (entry->event_id < 0)
 		return NULL;
 
-	/*
-	 * Currently the data reading operations are not thread-safe.
-	 * Use a mutex to protect the access.
-	 */
-	pthread_mutex_lock(&stream->input_mutex);
-	
-	record = tracecmd_read_at(kshark_get_tep_input(stream), entry->offset, NULL);
+	//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+	record = read_record(stream, entry->offset);
 
-	if (!record) {
-		pthread_mutex_unlock(&stream->input_mutex);
+	if (!record)
 		return NULL;
-	}
 
 	trace_seq_reset(&seq);
+
+	//NOTE: Changed here. (READ INPUTS) (2026-10-17)
+	/*
+	 * The printing of libtraceevent is not documented as reentrant (the
+	 * print handlers of the plugins keep state in the tep handle). Only
+	 * the reading of the record is done without the input mutex.
+	 */
+	pthread_mutex_lock(&stream->input_mutex);
 	tep_print_event(kshark_get_tep(stream), &seq, record,
 			"%s", TEP_PRINT_LATENCY);
-
-	tracecmd_free_record(record);
-
 	pthread_mutex_unlock(&stream->input_mutex);
+	// END of change
+
+	release_record(stream, record);
+	// END of change
 
 	if (asprintf(&buffer, "%s", seq.buffer)  <= 0)
 		return NULL;
@@ -1324,8 +3926,14 @@ static char *get_info_str(struct kshark_data_stream *stream,
 		return NULL;
 
 	trace_seq_reset(&seq);
+
+	//NOTE: Changed here. (READ INPUTS) (2026-10-17)
+	/* The shared tep handle is used for printing. See tepdata_get_latency(). */
+	pthread_mutex_lock(&stream->input_mutex);
 	tep_print_event(kshark_get_tep(stream), &seq, record,
 			"%s", TEP_PRINT_INFO);
+	pthread_mutex_unlock(&stream->input_mutex);
+	// END of change
 
 	if (!seq.len)
 		return NULL;
@@ -1367,17 +3975,10 @@ static char *tepdata_get_info(struct kshark_data_stream *stream,
 		}
 	}
 
-	/*
-	 * Currently the data reading operations are not thread-safe.
-	 * Use a mutex to protect the access.
-	 */
-	pthread_mutex_lock(&stream->input_mutex);
-
-	record = tracecmd_read_at(kshark_get_tep_input(stream), entry->offset, NULL);
-	if (!record) {
-		pthread_mutex_unlock(&stream->input_mutex);
+	//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+	record = read_record(stream, entry->offset);
+	if (!record)
 		return NULL;
-	}
 
 	event_id = tep_data_type(kshark_get_tep(stream), record);
 	event = tep_find_event(kshark_get_tep(stream), event_id);
@@ -1385,9 +3986,8 @@ static char *tepdata_get_info(struct kshark_data_stream *stream,
 	if (event)
 		info = get_info_str(stream, record, event);
 
-	tracecmd_free_record(record);
-
-	pthread_mutex_unlock(&stream->input_mutex);
+	release_record(stream, record);
+	// END of change
 
 	return info;
 }
@@ -1863,14 +4463,15 @@ int tepdata_read_event_field(struct kshark_data_stream *stream,
 	if (!evt_field)
 		return -EINVAL;
 
-	record = tracecmd_read_at(kshark_get_tep_input(stream),
-		entry->offset, NULL);
+	//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+	record = read_record(stream, entry->offset);
 	if (!record)
 		return -EFAULT;
 
 	ret = tep_read_number_field(evt_field, record->data,
 				    (unsigned long long *) val);
-	tracecmd_free_record(record);
+	release_record(stream, record);
+	// END of change
 
 	return ret;
 }
@@ -1995,6 +4596,13 @@ static int kshark_tep_stream_init(struct kshark_data_stream *stream,
 	if (!tep_handle->tep)
 		goto fail;
 
+	//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+	tep_handle->record_cache =
+		kshark_record_cache_alloc(KS_RECORD_CACHE_SIZE);
+	if (!tep_handle->record_cache)
+		goto fail;
+	// END of change
+
 	tep_handle->sched_switch_event_id = -EINVAL;
 	event = tep_find_event_by_name(tep_handle->tep,
 				       "sched", "sched_switch");
@@ -2008,6 +4616,21 @@ static int kshark_tep_stream_init(struct kshark_data_stream *stream,
 			tep_find_field(event, "next_comm");
 	}
 
+	//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+	tep_handle->sched_waking_event_id = -EINVAL;
+	event = tep_find_event_by_name(tep_handle->tep,
+				       "sched", "sched_waking");
+	if (event) {
+		tep_handle->sched_waking_event_id = event->id;
+
+		tep_handle->sched_waking_pid_field =
+			tep_find_any_field(event, "pid");
+
+		tep_handle->sched_waking_target_cpu_field =
+			tep_find_any_field(event, "target_cpu");
+	}
+	// END of change
+
 	stream->n_cpus = tep_get_cpus(tep_handle->tep);
 	stream->n_events = tep_get_events_count(tep_handle->tep);
 	stream->idle_pid = LINUX_IDLE_TASK_PID;
@@ -2027,6 +4650,10 @@ static int kshark_tep_stream_init(struct kshark_data_stream *stream,
 	return 0;
 
  fail:
+	//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+	if (tep_handle)
+		kshark_record_cache_free(tep_handle->record_cache);
+	// END of change
 	free(tep_handle);
 	free(interface);
 	stream->interface = NULL;
@@ -2371,6 +4998,14 @@ int kshark_tep_close_interface(struct kshark_data_stream *stream)
 	if (tep_handle->input)
 		tracecmd_close(tep_handle->input);
 
+	//NOTE: Changed here. (READ INPUTS) (2026-10-17)
+	read_inputs_free(tep_handle->spare_inputs);
+	// END of change
+
+	//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+	kshark_record_cache_free(tep_handle->record_cache);
+	// END of change
+
 	free(tep_handle);
 	interface->handle = NULL;
 
@@ -2456,6 +5091,286 @@ void kshark_tep_filter_reset(struct kshark_data_stream *stream)
 	return tep_filter_reset(get_adv_filter(stream));
 }
 
+//NOTE: Changed here. (ADV FILTER REFRESH) (2026-10-17)
+/**
+ * The smallest number of records read by a thread, when applying the advanced
+ * event filter to loaded entries.
+ */
+#define ADV_FILTER_BATCH	4096
+
+/** Records of loaded entries, matched against the advanced filter by a thread. */
+struct adv_filter_job {
+	/** Session context. */
+	struct kshark_context		*kshark_ctx;
+
+	/** Data stream of the entries. */
+	struct kshark_data_stream	*stream;
+
+	/** The advanced event filter. */
+	struct tep_event_filter		*adv_filter;
+
+	/** Lock protecting the matching of the records. */
+	pthread_mutex_t			*lock;
+
+	/** The entries, whose records have to be matched. */
+	struct kshark_entry		**entries;
+
+	/** The number of entries. */
+	size_t				n_entries;
+
+	/** The number of entries, rejected by the filter. */
+	size_t				n_rejected;
+
+	/** The thread matching the records. */
+	pthread_t			thread;
+
+	/** True if the records are matched by a thread of its own. */
+	bool				started;
+};
+
+/*
+ * The entry, whose record decides if an entry passes the advanced filter.
+ * Couplebreak entries have no records of their own. At loading, they are
+ * filtered with the records of their origins.
+ */
+static const struct kshark_entry *
+adv_filter_source(const struct kshark_entry *entry)
+{
+	if (entry->event_id == COUPLEBREAK_SST_ID ||
+	    entry->event_id == COUPLEBREAK_SWT_ID)
+		return couplebreak_get_origin(entry);
+
+	return entry;
+}
+
+/*
+ * Sort the event types of the advanced filter into types, whose every record
+ * passes ("pass") and types, whose records have to be matched ("match").
+ * Records of all other event types do not match the filter.
+ */
+static int adv_filter_sets(struct tep_event_filter *adv_filter,
+			   struct kshark_id_set *pass,
+			   struct kshark_id_set *match)
+{
+	struct kshark_hash_id *pass_ids, *match_ids;
+	struct tep_filter_arg *arg;
+	int i, ret = -ENOMEM;
+
+	pass_ids = kshark_hash_id_alloc(KS_FILTER_HASH_NBITS);
+	match_ids = kshark_hash_id_alloc(KS_FILTER_HASH_NBITS);
+	if (!pass_ids || !match_ids)
+		goto out;
+
+	for (i = 0; i < adv_filter->filters; ++i) {
+		arg = adv_filter->event_filters[i].filter;
+		if (arg && arg->type == TEP_FILTER_ARG_BOOLEAN) {
+			if (arg->boolean.value == TEP_FILTER_TRUE)
+				kshark_hash_id_add(pass_ids,
+						   adv_filter->event_filters[i].event_id);
+		} else {
+			kshark_hash_id_add(match_ids,
+					   adv_filter->event_filters[i].event_id);
+		}
+	}
+
+	ret = kshark_id_set_build(pass, pass_ids);
+	if (ret == 0)
+		ret = kshark_id_set_build(match, match_ids);
+
+ out:
+	kshark_hash_id_free(pass_ids);
+	kshark_hash_id_free(match_ids);
+
+	return ret;
+}
+
+static void *adv_filter_thread(void *arg)
+{
+	struct adv_filter_job *job = arg;
+	const struct kshark_entry *source;
+	struct tracecmd_input *input;
+	struct read_input *ri;
+	struct tep_record *rec;
+	bool match;
+	size_t i;
+
+	input = read_input_get(job->stream, &ri);
+	for (i = 0; i < job->n_entries; ++i) {
+		source = adv_filter_source(job->entries[i]);
+		rec = tracecmd_read_at(input, source->offset, NULL);
+		if (!rec)
+			continue;
+
+		pthread_mutex_lock(job->lock);
+		match = tep_filter_match(job->adv_filter, rec) == FILTER_MATCH;
+		pthread_mutex_unlock(job->lock);
+
+		tracecmd_free_record(rec);
+		if (!match) {
+			unset_event_filter_flag(job->kshark_ctx,
+						job->entries[i]);
+			++job->n_rejected;
+		}
+	}
+
+	read_input_put(job->stream, ri);
+
+	return NULL;
+}
+
+/*
+ * Check the entries of the stream against the event types of the filter.
+ * Entries, whose records have to be matched, are stored in "entries" (if not
+ * NULL). Returns the number of such entries.
+ */
+static size_t adv_filter_sort(struct adv_filter_job *job,
+			      struct kshark_entry **data, size_t n_entries,
+			      const struct kshark_id_set *pass,
+			      const struct kshark_id_set *match,
+			      struct kshark_entry **entries)
+{
+	const struct kshark_entry *source;
+	size_t i, n = 0;
+
+	for (i = 0; i < n_entries; ++i) {
+		if (data[i]->stream_id != job->stream->stream_id)
+			continue;
+
+		source = adv_filter_source(data[i]);
+		if (!source || kshark_id_set_find(pass, source->event_id))
+			continue;
+
+		if (kshark_id_set_find(match, source->event_id)) {
+			if (entries)
+				entries[n] = data[i];
+
+			++n;
+		} else if (!entries) {
+			/* No record of this event type matches the filter. */
+			unset_event_filter_flag(job->kshark_ctx, data[i]);
+			++job->n_rejected;
+		}
+	}
+
+	return n;
+}
+
+/**
+ * @brief Apply the advanced event filter of a Data stream to loaded entries,
+ *	  without reloading the data. Only the records of the entries of event
+ *	  types with a filter, which depends on the content of the event, are
+ *	  read. They are read by many threads (see
+ *	  kshark_set_filter_threads()). The entries, rejected by the filter,
+ *	  get their event filter flags unset. No other visibility flags are
+ *	  changed, so apply the Id filters first.
+ *
+ * @param kshark_ctx: Input location for the session context pointer.
+ * @param stream: Input location for the FTRACE data stream pointer.
+ * @param data: Input location for the trace data.
+ * @param n_entries: The size of the inputted data.
+ *
+ * @returns The number of entries rejected by the filter, or a negative error
+ *	    code on failure.
+ */
+ssize_t kshark_tep_apply_adv_filter(struct kshark_context *kshark_ctx,
+				    struct kshark_data_stream *stream,
+				    struct kshark_entry **data,
+				    size_t n_entries)
+{
+	struct kshark_id_set pass = {}, match = {};
+	struct adv_filter_job single, *jobs;
+	struct kshark_entry **entries;
+	size_t n_matched, n_rejected;
+	pthread_mutex_t lock;
+	long i, n_threads;
+	int ret;
+
+	if (!kshark_is_tep(stream) || !kshark_tep_filter_is_set(stream))
+		return 0;
+
+	memset(&single, 0, sizeof(single));
+	single.kshark_ctx = kshark_ctx;
+	single.stream = stream;
+	single.adv_filter = get_adv_filter(stream);
+	single.lock = &lock;
+
+	ret = adv_filter_sets(single.adv_filter, &pass, &match);
+	if (ret < 0)
+		goto out;
+
+	n_matched = adv_filter_sort(&single, data, n_entries, &pass, &match,
+				    NULL);
+
+	entries = malloc(n_matched * sizeof(*entries));
+	if (n_matched && !entries) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	adv_filter_sort(&single, data, n_entries, &pass, &match, entries);
+	n_rejected = single.n_rejected;
+
+	n_threads = kshark_ctx->n_filter_threads;
+	if (n_threads == KS_LOAD_THREADS_AUTO)
+		n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if ((size_t) n_threads > n_matched / ADV_FILTER_BATCH)
+		n_threads = n_matched / ADV_FILTER_BATCH;
+
+	jobs = (n_threads > 1) ? calloc(n_threads, sizeof(*jobs)) : NULL;
+	if (!jobs) {
+		n_threads = 1;
+		jobs = &single;
+	}
+
+	pthread_mutex_init(&lock, NULL);
+	for (i = 0; i < n_threads; ++i) {
+		jobs[i] = single;
+		jobs[i].entries = entries + n_matched * i / n_threads;
+		jobs[i].n_entries = n_matched * (i + 1) / n_threads -
+				    n_matched * i / n_threads;
+		jobs[i].n_rejected = 0;
+	}
+
+	/* If a thread fails to start, its entries are matched by this thread. */
+	for (i = 1; i < n_threads; ++i)
+		jobs[i].started = pthread_create(&jobs[i].thread, NULL,
+						 adv_filter_thread,
+						 &jobs[i]) == 0;
+
+	for (i = 0; i < n_threads; ++i)
+		if (!jobs[i].started)
+			adv_filter_thread(&jobs[i]);
+
+	for (i = 0; i < n_threads; ++i) {
+		if (jobs[i].started)
+			pthread_join(jobs[i].thread, NULL);
+
+		n_rejected += jobs[i].n_rejected;
+	}
+
+	pthread_mutex_destroy(&lock);
+	if (jobs != &single)
+		free(jobs);
+
+	free(entries);
+	ret = 0;
+
+ out:
+	kshark_id_set_free(&pass);
+	kshark_id_set_free(&match);
+
+	if (ret < 0) {
+		fprintf(stderr,
+			"Failed to apply the advanced filter (sd = %i)!\n",
+			stream->stream_id);
+		return ret;
+	}
+
+	return n_rejected;
+}
+// END of change
+
 /** Get an array of available tracer plugins. */
 char **kshark_tracecmd_local_plugins()
 {
@@ -49,6 +49,13 @@ int kshark_tep_filter_remove_event(struct kshark_data_stream *stream,
 
 void kshark_tep_filter_reset(struct kshark_data_stream *stream);
 
+//NOTE: Changed here. (ADV FILTER REFRESH) (2026-10-17)
+ssize_t kshark_tep_apply_adv_filter(struct kshark_context *kshark_ctx,
+				    struct kshark_data_stream *stream,
+				    struct kshark_entry **data,
+				    size_t n_entries);
+// END of change
+
 char **kshark_tracecmd_local_plugins();
 
 void kshark_tracecmd_plugin_list_free(char **list);
@@ -107,6 +114,108 @@ int kshark_tep_find_top_stream(struct kshark_context *kshark_ctx,
 
 bool kshark_tep_is_top_stream(struct kshark_data_stream *stream);
 
+//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+void kshark_tep_release_thread_seq(void);
+// END of change
+
+//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+ssize_t kshark_tep_load_entries_progressive(struct kshark_data_stream *stream,
+					    struct kshark_context *kshark_ctx,
+					    kshark_load_batch_func batch_func,
+					    void *data,
+					    struct kshark_entry ***data_rows);
+// END of change
+
+//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+ssize_t kshark_tep_cache_load(struct kshark_context *kshark_ctx,
+			      struct kshark_data_stream *stream,
+			      struct kshark_entry ***data_rows);
+
+int kshark_tep_cache_save(struct kshark_context *kshark_ctx,
+			  struct kshark_data_stream *stream,
+			  struct kshark_entry **rows, ssize_t n_rows);
+// END of change
+
+//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+struct kshark_compact_data;
+
+int kshark_tep_compact_couplebreak_cpus(struct kshark_compact_data *data,
+					size_t first);
+// END of change
+
+//NOTE: Changed here. (WINDOWED LOAD) (2026-10-17)
+/** Statistics of the windowed access to the trace data. */
+struct kshark_tep_window_stats {
+	/** The number of requested blocks, found decoded. */
+	size_t	n_hits;
+
+	/** The number of requested blocks, which had to be decoded. */
+	size_t	n_misses;
+
+	/** The number of decoded blocks, evicted so far. */
+	size_t	n_evicted;
+
+	/** The number of decoded blocks, currently held. */
+	size_t	n_blocks;
+
+	/** The memory used by the decoded blocks in bytes. */
+	size_t	n_bytes;
+};
+
+struct kshark_tep_window;
+
+struct kshark_tep_window *
+kshark_tep_window_open(struct kshark_context *kshark_ctx, int sd,
+		       size_t max_bytes);
+
+void kshark_tep_window_close(struct kshark_tep_window *win);
+
+bool kshark_tep_window_span(const struct kshark_tep_window *win,
+			    int64_t *first, int64_t *last);
+
+ssize_t kshark_tep_window_load(struct kshark_tep_window *win,
+			       int64_t min, int64_t max,
+			       struct kshark_entry ***data_rows);
+
+void kshark_tep_window_get_stats(const struct kshark_tep_window *win,
+				 struct kshark_tep_window_stats *stats);
+// END of change
+
+//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+/** Statistics of the record cache of a Data stream. */
+struct kshark_tep_record_cache_stats {
+	/** The number of reads served from the cache. */
+	size_t	n_hits;
+
+	/** The number of reads from the trace file. */
+	size_t	n_misses;
+
+	/** The number of records in the cache. */
+	size_t	n_records;
+};
+
+int kshark_tep_get_record_cache_stats(struct kshark_data_stream *stream,
+				      struct kshark_tep_record_cache_stats *stats);
+
+struct kshark_record_cache;
+
+struct kshark_record_cache *kshark_record_cache_alloc(size_t capacity);
+
+void kshark_record_cache_free(struct kshark_record_cache *cache);
+
+struct tep_record *kshark_record_cache_get(struct kshark_record_cache *cache,
+					   uint64_t offset);
+
+struct tep_record *kshark_record_cache_add(struct kshark_record_cache *cache,
+					   const struct tep_record *rec);
+
+void kshark_record_cache_put(struct kshark_record_cache *cache,
+			     struct tep_record *rec);
+
+void kshark_record_cache_get_stats(struct kshark_record_cache *cache,
+				   struct kshark_tep_record_cache_stats *stats);
+// END of change
+
 struct tep_event;
 
 struct tep_format_field;
@@ -19,6 +19,10 @@
 #include <stdio.h>
 #include <assert.h>
 #include <string.h>
+//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+#include <pthread.h>
+#include <unistd.h>
+// END of change
 
 // KernelShark
 #include "libkshark.h"
@@ -116,6 +120,22 @@ int kshark_open(struct kshark_context *kshark_ctx, const char *file)
 	return sd;
 }
 
+//NOTE: Changed here. (ID SETS) (2026-10-17)
+static void filter_sets_free(struct kshark_data_stream *stream)
+{
+	int i;
+
+	if (!stream->filter_sets)
+		return;
+
+	for (i = 0; i < KS_N_ID_FILTERS; ++i)
+		kshark_id_set_free(&stream->filter_sets->sets[i]);
+
+	free(stream->filter_sets);
+	stream->filter_sets = NULL;
+}
+// END of change
+
 static void kshark_stream_free(struct kshark_data_stream *stream)
 {
 	if (!stream)
@@ -134,6 +154,28 @@ static void kshark_stream_free(struct kshark_data_stream *stream)
 
 	kshark_hash_id_free(stream->tasks);
 
+	//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+	kshark_arena_free(stream->entry_arena);
+	// END of change
+
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	kshark_hash_id_free(stream->load_events);
+	// END of change
+
+	//NOTE: Changed here. (ID SETS) (2026-10-17)
+	filter_sets_free(stream);
+	// END of change
+
+	//NOTE: Changed here. (EVENT DISPATCH) (2026-10-17)
+	/*
+	 * The Event handlers and their table are normally freed when the
+	 * plugins get closed. Streams freed without this (e.g. with handlers
+	 * registered directly) still own them.
+	 */
+	kshark_free_event_handler_list(stream->event_handlers);
+	kshark_free_event_dispatch(stream->event_dispatch);
+	// END of change
+
 	free(stream->calib_array);
 	free(stream->file);
 	free(stream->name);
@@ -177,6 +219,15 @@ static struct kshark_data_stream *kshark_stream_alloc()
 	stream->couplebreak_evts_flags = 0;
 	// END of change
 
+	//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+	stream->n_load_threads = 1;
+	// END of change
+
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	stream->load_ts_min = INT64_MIN;
+	stream->load_ts_max = INT64_MAX;
+	// END of change
+
 	kshark_set_data_format(stream->data_format, KS_INVALID_DATA);
 	stream->name = strdup(KS_UNNAMED);
 
@@ -482,6 +533,11 @@ int kshark_close(struct kshark_context *kshark_ctx, int sd)
 	if (stream->plugins) {
 		kshark_handle_all_dpis(stream, KSHARK_PLUGIN_CLOSE);
 		kshark_free_event_handler_list(stream->event_handlers);
+		//NOTE: Changed here. (EVENT DISPATCH) (2026-10-17)
+		stream->event_handlers = NULL;
+		kshark_free_event_dispatch(stream->event_dispatch);
+		stream->event_dispatch = NULL;
+		// END of change
 		kshark_free_dpi_list(stream->plugins);
 	}
 
@@ -1004,6 +1060,10 @@ void kshark_print_entry(const struct kshark_entry *entry)
  *
  * @returns The size of the outputted data in the case of success, or a
  *	    negative error code on failure.
+ *
+ * @note The CPU buffers of the stream are decoded in parallel if more than
+ *	 one loading thread is set via kshark_set_load_threads(). The output
+ *	 is the same as in the case of sequential loading.
  */
 ssize_t kshark_load_entries(struct kshark_context *kshark_ctx, int sd,
 			    struct kshark_entry ***data_rows)
@@ -1023,6 +1083,462 @@ ssize_t kshark_load_entries(struct kshark_context *kshark_ctx, int sd,
 	return -EFAULT;
 }
 
+//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+/**
+ * @brief Set the number of threads used to decode the CPU buffers of a
+ *	  given Data stream, when loading its entries.
+ *
+ * @param kshark_ctx: Input location for context pointer.
+ * @param sd: Data stream identifier.
+ * @param n_threads: The number of threads. Use 1 for sequential loading
+ *		     or KS_LOAD_THREADS_AUTO for one thread per online
+ *		     processor.
+ *
+ * @returns Zero on success, or a negative error code on failure.
+ */
+int kshark_set_load_threads(struct kshark_context *kshark_ctx, int sd,
+			    int n_threads)
+{
+	struct kshark_data_stream *stream =
+		kshark_get_data_stream(kshark_ctx, sd);
+
+	if (!stream)
+		return -EFAULT;
+
+	if (n_threads < 0)
+		return -EINVAL;
+
+	stream->n_load_threads = n_threads;
+
+	return 0;
+}
+// END of change
+
+//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+/**
+ * @brief Make the entries of a given Data stream be allocated from a memory
+ *	  arena, owned by the stream. This way loading the data takes only a
+ *	  handful of large allocations, and all entries are released at once
+ *	  when the stream is closed, or when its data is loaded again.
+ *	  The entries of such a stream must not be freed individually. Use
+ *	  kshark_free_entries() instead.
+ *
+ * @param kshark_ctx: Input location for context pointer.
+ * @param sd: Data stream identifier.
+ * @param on: Enable or disable the arena. Disabling it releases all entries
+ *	      of the stream, loaded so far.
+ *
+ * @returns Zero on success, or a negative error code on failure. Only FTRACE
+ *	    (trace-cmd) data streams support the arena.
+ */
+int kshark_set_entry_arena(struct kshark_context *kshark_ctx, int sd,
+			   bool on)
+{
+	struct kshark_data_stream *stream =
+		kshark_get_data_stream(kshark_ctx, sd);
+
+	if (!stream)
+		return -EFAULT;
+
+	if (!on) {
+		kshark_arena_free(stream->entry_arena);
+		stream->entry_arena = NULL;
+		return 0;
+	}
+
+	if (!kshark_is_tep(stream))
+		return -ENOTSUP;
+
+	if (!stream->entry_arena)
+		stream->entry_arena = kshark_arena_alloc(KS_ARENA_CHUNK_SIZE);
+
+	return stream->entry_arena ? 0 : -ENOMEM;
+}
+
+//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+/**
+ * @brief Make the entries of a given Data stream be stored in a sidecar
+ *	  cache file ("<trace file>[.<buffer name>].ksidx") once loaded. When
+ *	  the stream is loaded again, the entries are restored from the cache
+ *	  file, instead of decoding all records. The cache file is discarded
+ *	  (rewritten) if the trace data file, the plugins, couplebreak or the
+ *	  time calibration of the stream have changed.
+ *
+ * @param kshark_ctx: Input location for context pointer.
+ * @param sd: Data stream identifier.
+ * @param on: Enable or disable the cache.
+ *
+ * @returns Zero on success, or a negative error code on failure. Only FTRACE
+ *	    (trace-cmd) data streams support the cache.
+ */
+int kshark_set_entry_cache(struct kshark_context *kshark_ctx, int sd,
+			   bool on)
+{
+	struct kshark_data_stream *stream =
+		kshark_get_data_stream(kshark_ctx, sd);
+
+	if (!stream)
+		return -EFAULT;
+
+	if (on && !kshark_is_tep(stream))
+		return -ENOTSUP;
+
+	stream->entry_cache = on;
+
+	return 0;
+}
+// END of change
+
+//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+/**
+ * @brief Load only the records of a given Data stream, which are inside a
+ *	  time range. The records outside of the range are skipped before
+ *	  any entry gets allocated for them and before any plugin action.
+ *
+ * @param kshark_ctx: Input location for context pointer.
+ * @param sd: Data stream identifier.
+ * @param min: Lower edge of the time range (calibrated timestamp). Use
+ *	       INT64_MIN for no lower edge.
+ * @param max: Upper edge of the time range (calibrated timestamp). Use
+ *	       INT64_MAX for no upper edge.
+ *
+ * @returns Zero on success, or a negative error code on failure. Only FTRACE
+ *	    (trace-cmd) data streams support load options.
+ */
+int kshark_set_load_time_range(struct kshark_context *kshark_ctx, int sd,
+			       int64_t min, int64_t max)
+{
+	struct kshark_data_stream *stream =
+		kshark_get_data_stream(kshark_ctx, sd);
+
+	if (!stream)
+		return -EFAULT;
+
+	if (!kshark_is_tep(stream))
+		return -ENOTSUP;
+
+	if (max < min)
+		return -EINVAL;
+
+	stream->load_ts_min = min;
+	stream->load_ts_max = max;
+
+	return 0;
+}
+
+/**
+ * @brief Load only the records of the given events. The records of all
+ *	  other events are skipped before any entry gets allocated for them
+ *	  and before any plugin action.
+ *
+ * @param kshark_ctx: Input location for context pointer.
+ * @param sd: Data stream identifier.
+ * @param event_ids: Array of event Ids.
+ * @param n_events: The size of the array. Use 0 to load all events.
+ *
+ * @returns Zero on success, or a negative error code on failure. Only FTRACE
+ *	    (trace-cmd) data streams support load options.
+ */
+int kshark_set_load_events(struct kshark_context *kshark_ctx, int sd,
+			   const int *event_ids, int n_events)
+{
+	struct kshark_data_stream *stream =
+		kshark_get_data_stream(kshark_ctx, sd);
+	struct kshark_hash_id *events;
+	int i;
+
+	if (!stream)
+		return -EFAULT;
+
+	if (n_events > 0 && !kshark_is_tep(stream))
+		return -ENOTSUP;
+
+	kshark_hash_id_free(stream->load_events);
+	stream->load_events = NULL;
+
+	if (n_events <= 0)
+		return 0;
+
+	events = kshark_hash_id_alloc(KS_FILTER_HASH_NBITS);
+	if (!events)
+		return -ENOMEM;
+
+	for (i = 0; i < n_events; ++i) {
+		if (kshark_hash_id_add(events, event_ids[i]) < 0) {
+			kshark_hash_id_free(events);
+			return -ENOMEM;
+		}
+	}
+
+	stream->load_events = events;
+
+	return 0;
+}
+
+static bool event_name_matches(const char *event, const char *name)
+{
+	size_t len = strlen(name);
+
+	/* Either the full name of the event or the name of its system. */
+	return strncmp(event, name, len) == 0 &&
+	       (event[len] == '\0' || event[len] == '/');
+}
+
+/**
+ * @brief Load only the records of the given events. The events are given
+ *	  by their full names ("system/event") or by the names of their
+ *	  systems ("system").
+ *
+ * @param kshark_ctx: Input location for context pointer.
+ * @param sd: Data stream identifier.
+ * @param names: Array of names.
+ * @param n_names: The size of the array. Use 0 to load all events.
+ *
+ * @returns Zero on success, or a negative error code on failure. -ENOENT if
+ *	    no event matches the names. In this case, the events to be
+ *	    loaded stay unchanged.
+ */
+int kshark_set_load_event_names(struct kshark_context *kshark_ctx, int sd,
+				char **names, int n_names)
+{
+	struct kshark_data_stream *stream =
+		kshark_get_data_stream(kshark_ctx, sd);
+	int *event_ids, *selected, i, j, n_selected = 0, ret;
+	char *event;
+
+	if (!stream)
+		return -EFAULT;
+
+	if (n_names <= 0)
+		return kshark_set_load_events(kshark_ctx, sd, NULL, 0);
+
+	event_ids = kshark_get_all_event_ids(stream);
+	selected = calloc(stream->n_events, sizeof(*selected));
+	if (!event_ids || !selected) {
+		free(event_ids);
+		free(selected);
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < stream->n_events; ++i) {
+		event = kshark_event_from_id(sd, event_ids[i]);
+		if (!event)
+			continue;
+
+		for (j = 0; j < n_names; ++j) {
+			if (event_name_matches(event, names[j])) {
+				selected[n_selected++] = event_ids[i];
+				break;
+			}
+		}
+
+		free(event);
+	}
+
+	ret = n_selected ?
+	      kshark_set_load_events(kshark_ctx, sd, selected, n_selected) :
+	      -ENOENT;
+
+	free(event_ids);
+	free(selected);
+
+	return ret;
+}
+
+/**
+ * @brief Convert a time, given in seconds as a decimal number (e.g.
+ *	  "1234.5678"), into nanoseconds. The conversion is exact to the
+ *	  nanosecond. Further digits are rounded.
+ *
+ * @param str: The time in seconds.
+ * @param ns: Output location for the time in nanoseconds.
+ *
+ * @returns Zero on success, or -EINVAL if the string is not a decimal
+ *	    number or if the time does not fit.
+ */
+int kshark_parse_seconds(const char *str, int64_t *ns)
+{
+	int64_t sec = 0, frac = 0, scale = 1000000000;
+	bool neg = false, digits = false;
+	const char *c = str;
+
+	if (*c == '-' || *c == '+')
+		neg = (*c++ == '-');
+
+	for (; *c >= '0' && *c <= '9'; ++c) {
+		if (__builtin_mul_overflow(sec, 10, &sec) ||
+		    __builtin_add_overflow(sec, *c - '0', &sec))
+			return -EINVAL;
+
+		digits = true;
+	}
+
+	if (*c == '.') {
+		for (++c; *c >= '0' && *c <= '9'; ++c) {
+			if (scale > 1) {
+				scale /= 10;
+				frac += (*c - '0') * scale;
+			} else if (scale == 1) {
+				/* Round at the first digit beyond 1 ns. */
+				frac += (*c >= '5');
+				scale = 0;
+			}
+
+			digits = true;
+		}
+	}
+
+	if (!digits || *c)
+		return -EINVAL;
+
+	if (__builtin_mul_overflow(sec, 1000000000, &sec) ||
+	    __builtin_add_overflow(sec, frac, &sec))
+		return -EINVAL;
+
+	*ns = neg ? -sec : sec;
+
+	return 0;
+}
+// END of change
+
+/**
+ * @brief Free an array of entries, loaded using kshark_load_entries() or
+ *	  kshark_load_all_entries(). Only the entries that are not owned by
+ *	  the memory arena of their Data stream are freed individually.
+ *	  Call this function before closing the Data streams.
+ *
+ * @param kshark_ctx: Input location for context pointer.
+ * @param data_rows: Input location for the array of entries.
+ * @param n_rows: The size of the array.
+ */
+void kshark_free_entries(struct kshark_context *kshark_ctx,
+			 struct kshark_entry **data_rows, ssize_t n_rows)
+{
+	struct kshark_data_stream *stream;
+	bool all_in_arena = true;
+	int *stream_ids, i;
+	ssize_t r;
+
+	if (!data_rows)
+		return;
+
+	stream_ids = kshark_all_streams(kshark_ctx);
+	for (i = 0; i < kshark_ctx->n_streams; ++i) {
+		if (!stream_ids ||
+		    !kshark_ctx->stream[stream_ids[i]]->entry_arena) {
+			all_in_arena = false;
+			break;
+		}
+	}
+
+	free(stream_ids);
+
+	/* Nothing to do for the entries owned by an arena. */
+	if (!all_in_arena) {
+		for (r = 0; r < n_rows; ++r) {
+			stream = kshark_get_data_stream(kshark_ctx,
+							data_rows[r]->stream_id);
+			if (!stream || !stream->entry_arena)
+				free(data_rows[r]);
+		}
+	}
+
+	free(data_rows);
+}
+// END of change
+
+//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+/**
+ * @brief Set a function, used to report the progress of the loading of all
+ *	  Data streams. While the progress is being reported, the streams are
+ *	  loaded in KS_LOAD_PROGRESS_STEPS consecutive time windows.
+ *
+ * @param kshark_ctx: Input location for context pointer.
+ * @param func: Progress function. Use NULL to stop reporting the progress.
+ * @param data: User data passed to the progress function.
+ */
+void kshark_set_load_progress_func(struct kshark_context *kshark_ctx,
+				   kshark_load_progress_func func,
+				   void *data)
+{
+	kshark_ctx->load_progress_func = func;
+	kshark_ctx->load_progress_data = data;
+}
+
+/**
+ * @brief Load the content of the trace data file asociated with a given
+ *	  Data stream into an array of kshark_entries, delivering the entries
+ *	  in batches while the loading goes on. The stream is loaded in
+ *	  KS_LOAD_PROGRESS_STEPS consecutive time windows and each batch holds
+ *	  the entries of one window. Data formats, other than FTRACE, are
+ *	  delivered as a single batch.
+ *
+ * @param kshark_ctx: Input location for context pointer.
+ * @param sd: Data stream identifier.
+ * @param batch_func: Function receiving the batches of entries. Can be NULL.
+ * @param data: User data passed to the batch function.
+ * @param data_rows: Output location for the trace data. The user is
+ *		     responsible for freeing the elements of the outputted
+ *		     array (see kshark_free_entries()). If NULL, the entries
+ *		     of each batch are released as soon as the batch function
+ *		     returns.
+ *
+ * @returns The size of the outputted data (or the total number of delivered
+ *	    entries, if "data_rows" is NULL) in the case of success, or a
+ *	    negative error code on failure.
+ *
+ * @note If couplebreak is enabled for the stream, the CPUs of its entries
+ *	 are corrected once the whole stream is loaded, i.e. after the
+ *	 entries have been delivered. If "data_rows" is NULL, they are not
+ *	 corrected at all.
+ *
+ * @note The load options and the entry cache of the stream apply, as they
+ *	 do for kshark_load_entries(). The entry cache is used only if
+ *	 "data_rows" is set, and the cached entries are delivered as a single
+ *	 batch.
+ */
+ssize_t kshark_load_entries_progressive(struct kshark_context *kshark_ctx,
+					int sd,
+					kshark_load_batch_func batch_func,
+					void *data,
+					struct kshark_entry ***data_rows)
+{
+	struct kshark_data_stream *stream =
+		kshark_get_data_stream(kshark_ctx, sd);
+	struct kshark_load_progress progress = {};
+	ssize_t n_rows;
+	//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+	struct kshark_entry **rows = NULL;
+	// END of change
+
+	if (!stream)
+		return -EFAULT;
+
+	if (kshark_is_tep(stream))
+		return kshark_tep_load_entries_progressive(stream, kshark_ctx,
+							   batch_func, data,
+							   data_rows);
+
+	//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+	n_rows = kshark_load_entries(kshark_ctx, sd, &rows);
+	if (n_rows > 0 && batch_func) {
+		progress.bytes_done = progress.bytes_total = 1;
+		progress.ts_first = rows[0]->ts;
+		progress.ts_loaded = progress.ts_last = rows[n_rows - 1]->ts;
+
+		batch_func(stream, rows, n_rows, &progress, data);
+	}
+
+	if (data_rows)
+		*data_rows = rows;
+	else if (n_rows > 0)
+		kshark_free_entries(kshark_ctx, rows, n_rows);
+	// END of change
+
+	return n_rows;
+}
+// END of change
+
 /**
  * @brief Load the content of the trace data file asociated with a given
  *	  Data stream into a data matrix. The user is responsible
@@ -1220,24 +1736,125 @@ void kshark_filter_clear(struct kshark_context *kshark_ctx, int sd,
 		kshark_hash_id_clear(filter);
 }
 
-/**
- * @brief Check if a given Id filter is set.
- *
- * @param filter: Input location for the Id filster.
- *
- * @returns True if the Id filter is set, otherwise False.
- */
-bool kshark_this_filter_is_set(struct kshark_hash_id *filter)
+//NOTE: Changed here. (ID SETS) (2026-10-17)
+static unsigned int filter_version(struct kshark_data_stream *stream,
+				   int filter_id)
 {
-	return filter && filter->count;
+	struct kshark_hash_id *filter = kshark_get_filter(stream, filter_id);
+
+	return filter ? filter->version : 0;
 }
 
-/**
- * @brief Check if an Id filter is set.
- *
- * @param kshark_ctx: Input location for the session context pointer.
- * @param sd: Data stream identifier.
- *
+static bool filter_sets_are_current(struct kshark_data_stream *stream,
+				    const struct kshark_filter_sets *sets)
+{
+	int i;
+
+	for (i = KS_SHOW_EVENT_FILTER; i < KS_N_ID_FILTERS; ++i)
+		if (sets->versions[i] != filter_version(stream, i))
+			return false;
+
+	return true;
+}
+
+static inline bool sets_show(const struct kshark_filter_sets *sets,
+			     int show_id, int hide_id, int id)
+{
+	const struct kshark_id_set *show = &sets->sets[show_id];
+	const struct kshark_id_set *hide = &sets->sets[hide_id];
+
+	return (!show->count || kshark_id_set_find(show, id)) &&
+	       (!hide->count || !kshark_id_set_find(hide, id));
+}
+
+static int update_filter_sets(struct kshark_data_stream *stream)
+{
+	struct kshark_filter_sets *sets = stream->filter_sets;
+	unsigned int version;
+	int i, ret;
+
+	if (!sets) {
+		sets = stream->filter_sets = calloc(1, sizeof(*sets));
+		if (!sets)
+			return -ENOMEM;
+	}
+
+	for (i = KS_SHOW_EVENT_FILTER; i < KS_N_ID_FILTERS; ++i) {
+		version = filter_version(stream, i);
+		if (sets->versions[i] == version)
+			continue;
+
+		ret = kshark_id_set_build(&sets->sets[i],
+					  kshark_get_filter(stream, i));
+		if (ret < 0) {
+			/* Fall back to the hash tables. */
+			filter_sets_free(stream);
+			return ret;
+		}
+
+		sets->versions[i] = version;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Bring the lookup-optimized copies of the Id filters of a Data stream
+ *	  up to date. kshark_apply_filters() uses the copies only if they are
+ *	  up to date. Call this function before filtering many entries, and
+ *	  never while entries of the stream are being filtered by another
+ *	  thread.
+ *
+ * @param kshark_ctx: Input location for the session context pointer.
+ * @param sd: Data stream identifier. Use a negative value for all streams.
+ *
+ * @returns Zero on success, or a negative error code on failure. The
+ *	    filtering works (more slowly) even if this function fails.
+ */
+int kshark_update_filter_sets(struct kshark_context *kshark_ctx, int sd)
+{
+	struct kshark_data_stream *stream;
+	int *stream_ids, i, ret = 0;
+
+	if (sd >= 0) {
+		stream = kshark_get_data_stream(kshark_ctx, sd);
+		return stream ? update_filter_sets(stream) : -EFAULT;
+	}
+
+	stream_ids = kshark_all_streams(kshark_ctx);
+	if (!stream_ids)
+		return -ENOMEM;
+
+	for (i = 0; i < kshark_ctx->n_streams; ++i) {
+		stream = kshark_get_data_stream(kshark_ctx, stream_ids[i]);
+		if (stream && update_filter_sets(stream) < 0)
+			ret = -ENOMEM;
+	}
+
+	free(stream_ids);
+
+	return ret;
+}
+// END of change
+
+/**
+ * @brief Check if a given Id filter is set.
+ *
+ * @param filter: Input location for the Id filster.
+ *
+ * @returns True if the Id filter is set, otherwise False.
+ */
+bool kshark_this_filter_is_set(struct kshark_hash_id *filter)
+{
+	return filter && filter->count;
+}
+
+/**
+ * @brief Check if an Id filter is set.
+ *
+ * @param kshark_ctx: Input location for the session context pointer.
+ * @param sd: Data stream identifier.
+ *
  * @returns True if at least one Id filter of the stream is set, otherwise
  *	    False.
  */
@@ -1268,6 +1885,24 @@ void kshark_apply_filters(struct kshark_context *kshark_ctx,
 			  struct kshark_data_stream *stream,
 			  struct kshark_entry *entry)
 {
+	//NOTE: Changed here. (ID SETS) (2026-10-17)
+	const struct kshark_filter_sets *sets = stream->filter_sets;
+
+	if (sets && filter_sets_are_current(stream, sets)) {
+		if (!sets_show(sets, KS_SHOW_EVENT_FILTER, KS_HIDE_EVENT_FILTER,
+			       entry->event_id))
+			unset_event_filter_flag(kshark_ctx, entry);
+
+		if (!sets_show(sets, KS_SHOW_CPU_FILTER, KS_HIDE_CPU_FILTER,
+			       entry->cpu) ||
+		    !sets_show(sets, KS_SHOW_TASK_FILTER, KS_HIDE_TASK_FILTER,
+			       entry->pid))
+			entry->visible &= ~kshark_ctx->filter_mask;
+
+		return;
+	}
+	// END of change
+
 	/* Apply event filtering. */
 	if (!kshark_show_event(stream, entry->event_id))
 		unset_event_filter_flag(kshark_ctx, entry);
@@ -1286,45 +1921,56 @@ static void set_all_visible(uint16_t *v) {
 	*v |= 0xFF & ~KS_PLUGIN_UNTOUCHED_MASK;
 }
 
-static void filter_entries(struct kshark_context *kshark_ctx, int sd,
-			   struct kshark_entry **data, size_t n_entries)
-{
-	struct kshark_data_stream *stream = NULL;
-	size_t i;
+//NOTE: Changed here. (PARALLEL FILTER) (2026-10-17)
+/** The number of entries, for which the column path computes masks at once. */
+#define FILTER_BLOCK_SIZE	1024
 
-	/* Sanity checks before starting. */
-	if (sd >= 0) {
-		/* We will filter particular Data stream. */
-		stream = kshark_get_data_stream(kshark_ctx, sd);
-		if (!stream)
-			return;
+/** A range of entries, filtered by one thread. */
+struct filter_job {
+	/** Session context. */
+	struct kshark_context			*kshark_ctx;
 
-		if (kshark_is_tep(stream) &&
-		    kshark_tep_filter_is_set(stream)) {
-			/* The advanced filter is set. */
-			fprintf(stderr,
-				"Failed to filter (sd = %i)!\n", sd);
-			fprintf(stderr,
-				"Reset the Advanced filter or reload the data.\n");
+	/** Data stream identifier. Negative for all streams. */
+	int					sd;
 
-			return;
-		}
+	/** The entries. */
+	struct kshark_entry			**data;
 
-		if (!kshark_filter_is_set(kshark_ctx, sd) &&
-		    !stream->filter_is_applied) {
-			/* Nothing to be done. */
-			return;
-		}
-	}
+	/** Columnar copy of the entries, or NULL. */
+	const struct kshark_entry_columns	*columns;
+
+	/** Index of the first entry of the range. */
+	size_t					first;
+
+	/** Index of the entry after the last one of the range. */
+	size_t					last;
+
+	/** The thread filtering the range. */
+	pthread_t				thread;
+
+	/** True if the range is filtered by a thread of its own. */
+	bool					started;
+};
+
+static void filter_rows(const struct filter_job *job, size_t first,
+			size_t last)
+{
+	struct kshark_context *kshark_ctx = job->kshark_ctx;
+	struct kshark_data_stream *stream = NULL;
+	struct kshark_entry **data = job->data;
+	size_t i;
+
+	if (job->sd >= 0)
+		stream = kshark_ctx->stream[job->sd];
 
 	/* Apply only the Id filters. */
-	for (i = 0; i < n_entries; ++i) {
-		if (sd >= 0) {
+	for (i = first; i < last; ++i) {
+		if (job->sd >= 0) {
 			/*
 			 * We only filter particular stream. Chack is the entry
 			 * belongs to this stream.
 			 */
-			if (data[i]->stream_id != sd)
+			if (data[i]->stream_id != job->sd)
 				continue;
 		} else {
 			/* We filter all streams. */
@@ -1336,12 +1982,274 @@ static void filter_entries(struct kshark_context *kshark_ctx, int sd,
 
 		/* Apply Id filtering. */
 		kshark_apply_filters(kshark_ctx, stream, data[i]);
+	}
+}
+
+/*
+ * Clear the elements of "mask" of the Ids not shown by the set. The set shows
+ * its Ids, or all other Ids if "hide" is true. The bitmap lookups are free of
+ * branches, so that the compiler can vectorize the loop.
+ */
+static void id_set_mask(const struct kshark_id_set *set, bool hide,
+			const int32_t *ids, size_t n, uint8_t *mask)
+{
+	uint32_t bit, in;
+	size_t i;
+
+	if (!set->count)
+		return;
+
+	if (set->bits) {
+		for (i = 0; i < n; ++i) {
+			bit = (uint32_t) ids[i] - (uint32_t) set->min;
+			in = bit < set->n_bits;
+			bit = in ? bit : 0;
+			in &= set->bits[bit / 64] >> (bit % 64);
+			mask[i] &= in ^ hide;
+		}
 
-		stream->filter_is_applied =
-			kshark_filter_is_set(kshark_ctx, sd)? true : false;
+		return;
+	}
+
+	for (i = 0; i < n; ++i)
+		mask[i] &= kshark_id_set_find(set, ids[i]) ^ hide;
+}
+
+static void filter_column_rows(const struct filter_job *job, size_t first,
+			       size_t last)
+{
+	const struct kshark_entry_columns *columns = job->columns;
+	struct kshark_context *kshark_ctx = job->kshark_ctx;
+	uint8_t show_event[FILTER_BLOCK_SIZE];
+	uint8_t show[FILTER_BLOCK_SIZE];
+	int32_t ids[FILTER_BLOCK_SIZE];
+	const struct kshark_filter_sets *sets;
+	struct kshark_data_stream *stream;
+	struct kshark_entry *entry;
+	size_t i, n;
+	int sd;
+
+	for (; first < last; first += n) {
+		/* Take a block of consecutive entries of the same stream. */
+		n = last - first;
+		if (n > FILTER_BLOCK_SIZE)
+			n = FILTER_BLOCK_SIZE;
+
+		sd = columns->stream_id[first];
+		for (i = 1; i < n; ++i)
+			if (columns->stream_id[first + i] != sd)
+				break;
+
+		n = i;
+		if (job->sd >= 0 && sd != job->sd)
+			continue;
+
+		stream = kshark_ctx->stream[sd];
+		sets = stream->filter_sets;
+		if (!sets || !filter_sets_are_current(stream, sets)) {
+			filter_rows(job, first, first + n);
+			continue;
+		}
+
+		/* Compute the visibility of the whole block, column by column. */
+		memset(show_event, 1, n);
+		for (i = 0; i < n; ++i)
+			ids[i] = columns->event_id[first + i];
+
+		id_set_mask(&sets->sets[KS_SHOW_EVENT_FILTER], false,
+			    ids, n, show_event);
+		id_set_mask(&sets->sets[KS_HIDE_EVENT_FILTER], true,
+			    ids, n, show_event);
+
+		memset(show, 1, n);
+		for (i = 0; i < n; ++i)
+			ids[i] = columns->cpu[first + i];
+
+		id_set_mask(&sets->sets[KS_SHOW_CPU_FILTER], false,
+			    ids, n, show);
+		id_set_mask(&sets->sets[KS_HIDE_CPU_FILTER], true,
+			    ids, n, show);
+
+		id_set_mask(&sets->sets[KS_SHOW_TASK_FILTER], false,
+			    columns->pid + first, n, show);
+		id_set_mask(&sets->sets[KS_HIDE_TASK_FILTER], true,
+			    columns->pid + first, n, show);
+
+		for (i = 0; i < n; ++i) {
+			entry = job->data[first + i];
+			set_all_visible(&entry->visible);
+
+			if (!show_event[i])
+				unset_event_filter_flag(kshark_ctx, entry);
+
+			if (!show[i])
+				entry->visible &= ~kshark_ctx->filter_mask;
+		}
 	}
 }
 
+static void *filter_thread(void *arg)
+{
+	struct filter_job *job = arg;
+
+	if (job->columns)
+		filter_column_rows(job, job->first, job->last);
+	else
+		filter_rows(job, job->first, job->last);
+
+	return NULL;
+}
+
+static long filter_n_threads(struct kshark_context *kshark_ctx,
+			     size_t n_entries)
+{
+	long n_threads = kshark_ctx->n_filter_threads;
+	size_t n_chunks = n_entries / KS_FILTER_CHUNK_SIZE;
+
+	if (n_threads == KS_LOAD_THREADS_AUTO)
+		n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if ((size_t) n_threads > n_chunks)
+		n_threads = n_chunks;
+
+	return (n_threads < 1) ? 1 : n_threads;
+}
+
+//NOTE: Changed here. (ADV FILTER REFRESH) (2026-10-17)
+/*
+ * The advanced filter uses the content of the records. Apply it on top of the
+ * Id filters, by reading only the records it needs.
+ */
+static void filter_adv_entries(struct kshark_context *kshark_ctx,
+			       struct kshark_data_stream *stream,
+			       struct kshark_entry **data, size_t n_entries)
+{
+	bool adv_filter_is_set = kshark_is_tep(stream) &&
+				 kshark_tep_filter_is_set(stream);
+
+	if (adv_filter_is_set)
+		kshark_tep_apply_adv_filter(kshark_ctx, stream, data,
+					    n_entries);
+
+	stream->filter_is_applied =
+		kshark_filter_is_set(kshark_ctx, stream->stream_id) ||
+		adv_filter_is_set;
+}
+// END of change
+
+static void filter_entries(struct kshark_context *kshark_ctx, int sd,
+			   struct kshark_entry **data,
+			   const struct kshark_entry_columns *columns,
+			   size_t n_entries)
+{
+	struct kshark_data_stream *stream = NULL;
+	struct filter_job single, *jobs;
+	long i, n_threads;
+	int *stream_ids;
+
+	/* Sanity checks before starting. */
+	if (sd >= 0) {
+		/* We will filter particular Data stream. */
+		stream = kshark_get_data_stream(kshark_ctx, sd);
+		if (!stream)
+			return;
+
+		if (!kshark_filter_is_set(kshark_ctx, sd) &&
+		    !(kshark_is_tep(stream) &&
+		      kshark_tep_filter_is_set(stream)) &&
+		    !stream->filter_is_applied) {
+			/* Nothing to be done. */
+			return;
+		}
+	}
+
+	/*
+	 * From here on, the filters and the sets are only read, so the
+	 * entries can be filtered by many threads at once.
+	 */
+	kshark_update_filter_sets(kshark_ctx, sd);
+
+	if (columns && columns->size != n_entries)
+		columns = NULL;
+
+	n_threads = filter_n_threads(kshark_ctx, n_entries);
+	jobs = (n_threads > 1) ? calloc(n_threads, sizeof(*jobs)) : NULL;
+	if (!jobs) {
+		n_threads = 1;
+		jobs = &single;
+	}
+
+	for (i = 0; i < n_threads; ++i) {
+		jobs[i].kshark_ctx = kshark_ctx;
+		jobs[i].sd = sd;
+		jobs[i].data = data;
+		jobs[i].columns = columns;
+		jobs[i].first = n_entries * i / n_threads;
+		jobs[i].last = n_entries * (i + 1) / n_threads;
+		jobs[i].started = false;
+	}
+
+	/* If a thread fails to start, its range is filtered by this thread. */
+	for (i = 1; i < n_threads; ++i)
+		jobs[i].started = pthread_create(&jobs[i].thread, NULL,
+						 filter_thread, &jobs[i]) == 0;
+
+	for (i = 0; i < n_threads; ++i)
+		if (!jobs[i].started)
+			filter_thread(&jobs[i]);
+
+	for (i = 1; i < n_threads; ++i)
+		if (jobs[i].started)
+			pthread_join(jobs[i].thread, NULL);
+
+	if (jobs != &single)
+		free(jobs);
+
+	if (sd >= 0) {
+		filter_adv_entries(kshark_ctx, stream, data, n_entries);
+		return;
+	}
+
+	stream_ids = kshark_all_streams(kshark_ctx);
+	if (!stream_ids)
+		return;
+
+	for (i = 0; i < kshark_ctx->n_streams; ++i) {
+		stream = kshark_get_data_stream(kshark_ctx, stream_ids[i]);
+		if (stream)
+			filter_adv_entries(kshark_ctx, stream, data, n_entries);
+	}
+
+	free(stream_ids);
+}
+
+/**
+ * @brief Set the number of threads used to filter the entries of the
+ *	  session. Arrays with fewer than KS_FILTER_CHUNK_SIZE entries per
+ *	  thread are filtered by fewer threads.
+ *
+ * @param kshark_ctx: Input location for the session context pointer.
+ * @param n_threads: The number of threads. Use 1 for sequential filtering
+ *		     or KS_LOAD_THREADS_AUTO for one thread per online
+ *		     processor.
+ *
+ * @returns Zero on success, or a negative error code on failure.
+ */
+int kshark_set_filter_threads(struct kshark_context *kshark_ctx,
+			      int n_threads)
+{
+	if (!kshark_ctx)
+		return -EFAULT;
+
+	if (n_threads < 0)
+		return -EINVAL;
+
+	kshark_ctx->n_filter_threads = n_threads;
+
+	return 0;
+}
+// END of change
+
 /**
  * @brief This function loops over the array of entries specified by "data"
  *	  and "n_entries" and sets the "visible" fields of each entry from a
@@ -1349,9 +2257,9 @@ static void filter_entries(struct kshark_context *kshark_ctx, int sd,
  *	  of the session's context. The field "filter_mask" of the session's
  *	  context is used to control the level of visibility/invisibility of
  *	  the entries which are filtered-out.
- *	  WARNING: Do not use this function if the advanced filter is set.
- *	  Applying the advanced filter requires access to prevent_record,
- *	  hence the data has to be reloaded using kshark_load_entries().
+ *	  The advanced filter (if set) is applied as well, by reading the
+ *	  records of the entries it depends on (see
+ *	  kshark_tep_apply_adv_filter()).
  *
  * @param kshark_ctx: Input location for the session context pointer.
  * @param sd: Data stream identifier.
@@ -1364,7 +2272,9 @@ void kshark_filter_stream_entries(struct kshark_context *kshark_ctx,
 				  size_t n_entries)
 {
 	if (sd >= 0)
-		filter_entries(kshark_ctx, sd, data, n_entries);
+		//NOTE: Changed here. (PARALLEL FILTER) (2026-10-17)
+		filter_entries(kshark_ctx, sd, data, NULL, n_entries);
+		// END of change
 }
 
 /**
@@ -1374,9 +2284,9 @@ void kshark_filter_stream_entries(struct kshark_context *kshark_ctx,
  *	  of the session's context. The field "filter_mask" of the session's
  *	  context is used to control the level of visibility/invisibility of
  *	  the entries which are filtered-out.
- *	  WARNING: Do not use this function if the advanced filter is set.
- *	  Applying the advanced filter requires access to prevent_record,
- *	  hence the data has to be reloaded using kshark_load_data_entries().
+ *	  The advanced filter (if set) is applied as well, by reading the
+ *	  records of the entries it depends on (see
+ *	  kshark_tep_apply_adv_filter()).
  *
  * @param kshark_ctx: Input location for the session context pointer.
  * @param data: Input location for the trace data to be filtered.
@@ -1385,7 +2295,9 @@ void kshark_filter_stream_entries(struct kshark_context *kshark_ctx,
 void kshark_filter_all_entries(struct kshark_context *kshark_ctx,
 			       struct kshark_entry **data, size_t n_entries)
 {
-	filter_entries(kshark_ctx, -1, data, n_entries);
+	//NOTE: Changed here. (PARALLEL FILTER) (2026-10-17)
+	filter_entries(kshark_ctx, -1, data, NULL, n_entries);
+	// END of change
 }
 
 /**
@@ -1417,8 +2329,19 @@ void kshark_clear_all_filters(struct kshark_context *kshark_ctx,
 	free(stream_ids);
 }
 
+//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+/*
+ * The plugins are not expected to be thread-safe, and their state may be
+ * shared between Data streams. Hence no two plugin actions run at the same
+ * time, even if several streams (or CPU buffers) are loaded concurrently.
+ */
+static pthread_mutex_t plugin_actions_lock = PTHREAD_MUTEX_INITIALIZER;
+// END of change
+
 /**
- * @brief Process all registered event-specific plugin actions.
+ * @brief Process all registered event-specific plugin actions. The actions
+ *	  of all plugins are serialized, so this function can be called from
+ *	  several threads at the same time.
  *
  * @param stream: Input location for a Trace data stream pointer.
  * @param record: Input location for the trace record.
@@ -1427,16 +2350,50 @@ void kshark_clear_all_filters(struct kshark_context *kshark_ctx,
 void kshark_plugin_actions(struct kshark_data_stream *stream,
 			   void *record, struct kshark_entry *entry)
 {
-	if (stream->event_handlers) {
+	//NOTE: Changed here. (EVENT DISPATCH) (2026-10-17)
+	if (stream->event_dispatch) {
+		struct kshark_event_proc_handler **handlers;
+		int i, n_handlers;
+
+		handlers = kshark_dispatch_event(stream->event_dispatch,
+						 entry->event_id, &n_handlers);
+		//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+		if (!n_handlers)
+			return;
+
+		pthread_mutex_lock(&plugin_actions_lock);
+		// END of change
+
+		for (i = 0; i < n_handlers; ++i) {
+			handlers[i]->event_func(stream, record, entry);
+			entry->visible &= ~KS_PLUGIN_UNTOUCHED_MASK;
+		}
+
+		//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+		pthread_mutex_unlock(&plugin_actions_lock);
+		// END of change
+	} else if (stream->event_handlers) {
+	// END of change
 		/* Execute all plugin-provided actions for this event (if any). */
 		struct kshark_event_proc_handler *evt_handler = stream->event_handlers;
 
+		//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+		if (!kshark_find_event_handler(evt_handler, entry->event_id))
+			return;
+
+		pthread_mutex_lock(&plugin_actions_lock);
+		// END of change
+
 		while ((evt_handler = kshark_find_event_handler(evt_handler,
 								entry->event_id))) {
 			evt_handler->event_func(stream, record, entry);
 			evt_handler = evt_handler->next;
 			entry->visible &= ~KS_PLUGIN_UNTOUCHED_MASK;
 		}
+
+		//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+		pthread_mutex_unlock(&plugin_actions_lock);
+		// END of change
 	}
 }
 
@@ -1521,78 +2478,348 @@ bool kshark_data_matrix_alloc(size_t n_rows, int16_t **event_array,
 			goto free_ts;
 	}
 
-	if (event_array) {
-		*event_array = calloc(n_rows, sizeof(**event_array));
-		if (!*event_array)
-			goto free_pid;
-	}
+	if (event_array) {
+		*event_array = calloc(n_rows, sizeof(**event_array));
+		if (!*event_array)
+			goto free_pid;
+	}
+
+	return true;
+
+ free_pid:
+	free_ptr(pid_array);
+ free_ts:
+	free_ptr(ts_array);
+ free_cpu:
+	free_ptr(cpu_array);
+ free_offset:
+	free_ptr(offset_array);
+
+	fprintf(stderr, "Failed to allocate memory during data loading.\n");
+	return false;
+}
+
+/**
+ * @brief Convert the timestamp of the trace record (nanosecond precision) into
+ *	  seconds and microseconds.
+ *
+ * @param time: Input location for the timestamp.
+ * @param sec: Output location for the value of the seconds.
+ * @param usec: Output location for the value of the microseconds.
+ */
+void kshark_convert_nano(uint64_t time, uint64_t *sec, uint64_t *usec)
+{
+	uint64_t s;
+
+	*sec = s = time / 1000000000ULL;
+	*usec = (time - s * 1000000000ULL) / 1000;
+}
+
+/**
+ * @brief Binary search inside a time-sorted array of kshark_entries.
+ *
+ * @param time: The value of time to search for.
+ * @param data: Input location for the trace data.
+ * @param l: Array index specifying the lower edge of the range to search in.
+ * @param h: Array index specifying the upper edge of the range to search in.
+ *
+ * @returns On success, the first kshark_entry inside the range, having a
+ *	    timestamp equal or bigger than "time".
+ *	    If all entries inside the range have timestamps greater than "time"
+ *	    the function returns BSEARCH_ALL_GREATER (negative value).
+ *	    If all entries inside the range have timestamps smaller than "time"
+ *	    the function returns BSEARCH_ALL_SMALLER (negative value).
+ */
+ssize_t kshark_find_entry_by_time(int64_t time,
+				  struct kshark_entry **data,
+				  size_t l, size_t h)
+{
+	size_t mid;
+
+	if (data[l]->ts > time)
+		return BSEARCH_ALL_GREATER;
+
+	if (data[h]->ts < time)
+		return BSEARCH_ALL_SMALLER;
+
+	/*
+	 * After executing the BSEARCH macro, "l" will be the index of the last
+	 * entry having timestamp < time and "h" will be the index of the first
+	 * entry having timestamp >= time.
+	 */
+	BSEARCH(h, l, data[mid]->ts < time);
+	return h;
+}
+
+//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+/**
+ * @brief Allocate memory for the columns. The memory is reused if the
+ *	  columns already have the requested size. The content of the
+ *	  columns is not initialized.
+ *
+ * @param columns: Input location for the columns. Must be initialized
+ *		   with zeros before the first use.
+ * @param n: The number of rows.
+ *
+ * @returns True on success. Else false, in which case the columns are empty.
+ */
+bool kshark_entry_columns_alloc(struct kshark_entry_columns *columns,
+				size_t n)
+{
+	char *mem;
+
+	if (columns->size == n && columns->ts)
+		return true;
+
+	kshark_entry_columns_free(columns);
+	if (!n)
+		return true;
+
+	/*
+	 * One block of memory holds all columns. The columns are ordered by
+	 * the size of their elements, so that each one of them is naturally
+	 * aligned.
+	 */
+	mem = malloc(n * (sizeof(*columns->ts) +
+			  sizeof(*columns->pid) +
+			  sizeof(*columns->stream_id) +
+			  sizeof(*columns->cpu) +
+			  sizeof(*columns->event_id)));
+	if (!mem) {
+		fprintf(stderr,
+			"Failed to allocate memory for data columns.\n");
+		return false;
+	}
+
+	columns->ts = (int64_t *) mem;
+	columns->pid = (int32_t *) (columns->ts + n);
+	columns->stream_id = (int16_t *) (columns->pid + n);
+	columns->cpu = columns->stream_id + n;
+	columns->event_id = columns->cpu + n;
+	columns->size = n;
+
+	return true;
+}
+
+/**
+ * @brief Fill the columns with the data of an array of trace entries. The
+ *	  memory of the columns is reused if its size matches the size of
+ *	  the data. Else it is reallocated.
+ *
+ * @param columns: Input location for the columns. Must be initialized
+ *		   with zeros before the first use.
+ * @param data_rows: Input location for the trace data.
+ * @param n: The size of the inputted data.
+ *
+ * @returns True on success. Else false, in which case the columns are empty.
+ */
+bool kshark_entry_columns_fill(struct kshark_entry_columns *columns,
+			       struct kshark_entry **data_rows, size_t n)
+{
+	size_t i;
+
+	if (!kshark_entry_columns_alloc(columns, n))
+		return false;
+
+	for (i = 0; i < n; ++i) {
+		columns->ts[i] = data_rows[i]->ts;
+		columns->pid[i] = data_rows[i]->pid;
+		columns->stream_id[i] = data_rows[i]->stream_id;
+		columns->cpu[i] = data_rows[i]->cpu;
+		columns->event_id[i] = data_rows[i]->event_id;
+	}
+
+	//NOTE: Changed here. (TIME GRID) (2026-10-17)
+	kshark_ts_grid_build(&columns->grid, columns->ts, n);
+	// END of change
+
+	return true;
+}
+
+/**
+ * @brief Free the memory used by the columns. The columns are left empty.
+ *
+ * @param columns: Input location for the columns.
+ */
+void kshark_entry_columns_free(struct kshark_entry_columns *columns)
+{
+	//NOTE: Changed here. (TIME GRID) (2026-10-17)
+	kshark_ts_grid_free(&columns->grid);
+	// END of change
+	free(columns->ts);
+	memset(columns, 0, sizeof(*columns));
+}
+
+//NOTE: Changed here. (PARALLEL FILTER) (2026-10-17)
+/**
+ * @brief Same as kshark_filter_stream_entries() (or
+ *	  kshark_filter_all_entries() if "sd" is negative), but the
+ *	  visibility of the entries is computed from the columnar copy of the
+ *	  data, a block of entries at a time. The entries are touched only to
+ *	  set their "visible" fields.
+ *
+ * @param kshark_ctx: Input location for the session context pointer.
+ * @param sd: Data stream identifier. Use a negative value for all streams.
+ * @param data: Input location for the trace data to be filtered.
+ * @param columns: Input location for the columns, filled from "data". If
+ *		   the size of the columns is not "n_entries", the columns
+ *		   are not used.
+ * @param n_entries: The size of the inputted data.
+ */
+void kshark_filter_column_entries(struct kshark_context *kshark_ctx, int sd,
+				  struct kshark_entry **data,
+				  const struct kshark_entry_columns *columns,
+				  size_t n_entries)
+{
+	filter_entries(kshark_ctx, sd < 0 ? -1 : sd, data, columns, n_entries);
+}
+// END of change
+
+/**
+ * @brief Binary search inside a sorted column of timestamps.
+ *
+ * @param time: The value of time to search for.
+ * @param ts: Input location for the timestamp column.
+ * @param l: Array index specifying the lower edge of the range to search in.
+ * @param h: Array index specifying the upper edge of the range to search in.
+ *
+ * @returns On success, the index of the first timestamp inside the range,
+ *	    which is equal or bigger than "time".
+ *	    If all timestamps inside the range are greater than "time" the
+ *	    function returns BSEARCH_ALL_GREATER (negative value).
+ *	    If all timestamps inside the range are smaller than "time" the
+ *	    function returns BSEARCH_ALL_SMALLER (negative value).
+ */
+ssize_t kshark_find_ts_by_time(int64_t time, const int64_t *ts,
+			       size_t l, size_t h)
+{
+	size_t mid;
+
+	if (ts[l] > time)
+		return BSEARCH_ALL_GREATER;
 
-	return true;
+	if (ts[h] < time)
+		return BSEARCH_ALL_SMALLER;
 
- free_pid:
-	free_ptr(pid_array);
- free_ts:
-	free_ptr(ts_array);
- free_cpu:
-	free_ptr(cpu_array);
- free_offset:
-	free_ptr(offset_array);
+	BSEARCH(h, l, ts[mid] < time);
+	return h;
+}
+// END of change
 
-	fprintf(stderr, "Failed to allocate memory during data loading.\n");
-	return false;
+//NOTE: Changed here. (TIME GRID) (2026-10-17)
+/**
+ * @brief Free the memory used by a time grid. The grid is left empty.
+ *
+ * @param grid: Input location for the time grid.
+ */
+void kshark_ts_grid_free(struct kshark_ts_grid *grid)
+{
+	free(grid->rows);
+	memset(grid, 0, sizeof(*grid));
 }
 
 /**
- * @brief Convert the timestamp of the trace record (nanosecond precision) into
- *	  seconds and microseconds.
+ * @brief Build the time grid of a sorted column of timestamps. The time step
+ *	  is chosen such that there are about KS_TS_GRID_DENSITY rows per
+ *	  cell.
  *
- * @param time: Input location for the timestamp.
- * @param sec: Output location for the value of the seconds.
- * @param usec: Output location for the value of the microseconds.
+ * @param grid: Input location for the time grid. Its previous content is
+ *		released. Must be initialized with zeros before the first use.
+ * @param ts: Input location for the column of timestamps.
+ * @param n: The number of rows.
+ *
+ * @returns True on success. Else false, in which case the grid is empty
+ *	    (e.g. the timestamps are not sorted).
  */
-void kshark_convert_nano(uint64_t time, uint64_t *sec, uint64_t *usec)
+bool kshark_ts_grid_build(struct kshark_ts_grid *grid,
+			  const int64_t *ts, size_t n)
 {
-	uint64_t s;
+	uint64_t span, n_target, cell, last = 0;
+	size_t i;
 
-	*sec = s = time / 1000000000ULL;
-	*usec = (time - s * 1000000000ULL) / 1000;
+	kshark_ts_grid_free(grid);
+	if (!n || n >= UINT32_MAX)
+		return false;
+
+	span = (uint64_t) ts[n - 1] - (uint64_t) ts[0];
+	n_target = n / KS_TS_GRID_DENSITY + 1;
+	while ((span >> grid->shift) >= n_target)
+		++grid->shift;
+
+	grid->n_cells = (span >> grid->shift) + 1;
+	grid->rows = malloc((grid->n_cells + 1) * sizeof(*grid->rows));
+	if (!grid->rows) {
+		kshark_ts_grid_free(grid);
+		return false;
+	}
+
+	/* Each cell starts at the first row, falling into this or a later cell. */
+	grid->rows[0] = 0;
+	for (i = 1; i < n; ++i) {
+		if (ts[i] < ts[i - 1]) {
+			kshark_ts_grid_free(grid);
+			return false;
+		}
+
+		cell = ((uint64_t) ts[i] - (uint64_t) ts[0]) >> grid->shift;
+		while (last < cell)
+			grid->rows[++last] = i;
+	}
+
+	while (last < grid->n_cells)
+		grid->rows[++last] = n;
+
+	grid->ts0 = ts[0];
+	grid->size = n;
+
+	return true;
 }
 
 /**
- * @brief Binary search inside a time-sorted array of kshark_entries.
+ * @brief Same as kshark_find_ts_by_time(), but the binary search is done
+ *	  only inside the cell of the time grid, holding the value of time.
  *
  * @param time: The value of time to search for.
- * @param data: Input location for the trace data.
+ * @param ts: Input location for the timestamp column.
+ * @param grid: Input location for the time grid of the timestamp column. If
+ *		the grid is empty or does not match the column, the whole
+ *		range is searched.
  * @param l: Array index specifying the lower edge of the range to search in.
  * @param h: Array index specifying the upper edge of the range to search in.
  *
- * @returns On success, the first kshark_entry inside the range, having a
- *	    timestamp equal or bigger than "time".
- *	    If all entries inside the range have timestamps greater than "time"
- *	    the function returns BSEARCH_ALL_GREATER (negative value).
- *	    If all entries inside the range have timestamps smaller than "time"
- *	    the function returns BSEARCH_ALL_SMALLER (negative value).
+ * @returns The same as kshark_find_ts_by_time().
  */
-ssize_t kshark_find_entry_by_time(int64_t time,
-				  struct kshark_entry **data,
-				  size_t l, size_t h)
+ssize_t kshark_find_ts_by_grid(int64_t time, const int64_t *ts,
+			       const struct kshark_ts_grid *grid,
+			       size_t l, size_t h)
 {
-	size_t mid;
-
-	if (data[l]->ts > time)
-		return BSEARCH_ALL_GREATER;
+	size_t mid, first, last;
+	uint64_t cell;
 
-	if (data[h]->ts < time)
-		return BSEARCH_ALL_SMALLER;
+	if (!grid->rows || h >= grid->size || ts[l] >= time || ts[h] < time)
+		return kshark_find_ts_by_time(time, ts, l, h);
 
 	/*
-	 * After executing the BSEARCH macro, "l" will be the index of the last
-	 * entry having timestamp < time and "h" will be the index of the first
-	 * entry having timestamp >= time.
+	 * The first row with timestamp >= "time" is inside the range and
+	 * inside the cell of "time" (or it is the first row of the next
+	 * cell).
 	 */
-	BSEARCH(h, l, data[mid]->ts < time);
-	return h;
+	cell = ((uint64_t) time - (uint64_t) grid->ts0) >> grid->shift;
+	first = grid->rows[cell];
+	last = grid->rows[cell + 1];
+	if (first < l)
+		first = l;
+
+	if (last > h)
+		last = h;
+
+	if (ts[first] >= time)
+		return first;
+
+	BSEARCH(last, first, ts[mid] < time);
+	return last;
 }
+// END of change
 
 /**
  * @brief Simple Pid matching function to be user for data requests.
@@ -1889,6 +3116,54 @@ static void kshark_data_qsort(struct kshark_entry **entries, size_t size)
 	qsort(entries, size, sizeof(struct kshark_entry *), compare_time);
 }
 
+//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+/*
+ * The entries of each Data stream are sorted in time and shifting all
+ * timestamps of a stream by the same offset keeps them sorted. Merge the
+ * shifted entries back with the entries of the other streams in linear time.
+ * Returns false if the temporary buffer cannot be allocated.
+ */
+static bool merge_shifted_stream(struct kshark_entry **entries, size_t size,
+				 int sd, size_t n_shifted)
+{
+	struct kshark_entry **shifted;
+	size_t i, n_other = 0;
+	ssize_t o, s, out;
+
+	if (!n_shifted || n_shifted == size)
+		return true;
+
+	shifted = malloc(n_shifted * sizeof(*shifted));
+	if (!shifted)
+		return false;
+
+	/* Move the entries of the other streams to the front. */
+	for (i = 0, n_shifted = 0; i < size; ++i) {
+		if (entries[i]->stream_id == sd)
+			shifted[n_shifted++] = entries[i];
+		else
+			entries[n_other++] = entries[i];
+	}
+
+	/*
+	 * Merge from the back, so that no entry of the other streams gets
+	 * overwritten before it is moved.
+	 */
+	o = n_other - 1;
+	s = n_shifted - 1;
+	for (out = size - 1; s >= 0; --out) {
+		if (o >= 0 && entries[o]->ts > shifted[s]->ts)
+			entries[out] = entries[o--];
+		else
+			entries[out] = shifted[s--];
+	}
+
+	free(shifted);
+
+	return true;
+}
+// END of change
+
 /**
  * Add constant offset to the timestamp of the entry. To be used by the sream
  * object as a System clock calibration callback function.
@@ -1928,33 +3203,143 @@ void kshark_set_clock_offset(struct kshark_context *kshark_ctx,
 	correction = offset - stream->calib_array[0];
 	stream->calib_array[0] = offset;
 
-	for (size_t i = 0; i < size; ++i)
-		if (entries[i]->stream_id == sd)
+	//NOTE: Changed here. (CLOCK OFFSET MERGE) (2026-10-17)
+	if (!correction)
+		return;
+
+	size_t n_shifted = 0;
+	for (size_t i = 0; i < size; ++i) {
+		if (entries[i]->stream_id == sd) {
 			entries[i]->ts += correction;
+			++n_shifted;
+		}
+	}
 
-	kshark_data_qsort(entries, size);
+	if (!merge_shifted_stream(entries, size, sd, n_shifted))
+		kshark_data_qsort(entries, size);
+	// END of change
 }
 
-static int first_in_time_entry(struct kshark_entry_data_set *buffer,
-			       size_t n_buffers,
-			       ssize_t *count)
+//NOTE: Changed here. (HEAP MERGE) (2026-10-17)
+static inline bool merge_node_less(const struct kshark_merge_node *a,
+				   const struct kshark_merge_node *b)
 {
-	int64_t t_min = INT64_MAX;
-	int min = -1;
-	size_t i;
+	return a->ts < b->ts || (a->ts == b->ts && a->src < b->src);
+}
 
-	for (i = 0; i < n_buffers; ++i) {
-		if (count[i] == buffer[i].n_rows)
-			continue;
+static void merge_heap_sift_down(struct kshark_merge_heap *heap, int i)
+{
+	struct kshark_merge_node *nodes = heap->nodes;
+	struct kshark_merge_node node = nodes[i];
+	int child;
 
-		if (t_min > buffer[i].data[count[i]]->ts) {
-			t_min = buffer[i].data[count[i]]->ts;
-			min = i;
-		}
+	while ((child = 2 * i + 1) < heap->size) {
+		if (child + 1 < heap->size &&
+		    merge_node_less(&nodes[child + 1], &nodes[child]))
+			++child;
+
+		if (!merge_node_less(&nodes[child], &node))
+			break;
+
+		nodes[i] = nodes[child];
+		i = child;
+	}
+
+	nodes[i] = node;
+}
+
+/**
+ * @brief Initialize a merge heap.
+ *
+ * @param heap: Input location for the merge heap.
+ * @param capacity: The maximum number of sources.
+ *
+ * @returns True on success, or false on memory allocation fail. Use
+ *	    kshark_merge_heap_free() to release the memory of the heap.
+ */
+bool kshark_merge_heap_init(struct kshark_merge_heap *heap, int capacity)
+{
+	heap->size = 0;
+	heap->capacity = capacity;
+	heap->nodes = calloc(capacity > 0 ? capacity : 1,
+			     sizeof(*heap->nodes));
+	if (!heap->nodes) {
+		fprintf(stderr, "Failed to allocate memory for merge heap.\n");
+		heap->capacity = 0;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Add a source to the merge heap.
+ *
+ * @param heap: Input location for the merge heap.
+ * @param src: Source identifier.
+ * @param ts: The timestamp of the head of the source.
+ */
+void kshark_merge_heap_push(struct kshark_merge_heap *heap,
+			    int src, int64_t ts)
+{
+	struct kshark_merge_node *nodes = heap->nodes;
+	struct kshark_merge_node node = {.ts = ts, .src = src};
+	int i, parent;
+
+	assert(heap->size < heap->capacity);
+
+	for (i = heap->size++; i > 0; i = parent) {
+		parent = (i - 1) / 2;
+		if (!merge_node_less(&node, &nodes[parent]))
+			break;
+
+		nodes[i] = nodes[parent];
 	}
 
-	return min;
+	nodes[i] = node;
+}
+
+/**
+ * @brief Update the timestamp of the source at the top of the heap, after
+ *	  its head has been consumed.
+ *
+ * @param heap: Input location for the merge heap.
+ * @param ts: The timestamp of the new head of the source.
+ */
+void kshark_merge_heap_replace_top(struct kshark_merge_heap *heap,
+				   int64_t ts)
+{
+	heap->nodes[0].ts = ts;
+	merge_heap_sift_down(heap, 0);
+}
+
+/**
+ * @brief Remove the source at the top of the heap (the source is empty).
+ *
+ * @param heap: Input location for the merge heap.
+ */
+void kshark_merge_heap_pop(struct kshark_merge_heap *heap)
+{
+	if (!heap->size)
+		return;
+
+	heap->nodes[0] = heap->nodes[--heap->size];
+	if (heap->size)
+		merge_heap_sift_down(heap, 0);
+}
+
+/**
+ * @brief Free the memory used by a merge heap.
+ *
+ * @param heap: Input location for the merge heap.
+ */
+void kshark_merge_heap_free(struct kshark_merge_heap *heap)
+{
+	free(heap->nodes);
+	heap->nodes = NULL;
+	heap->size = heap->capacity = 0;
 }
+// END of change
 
 /**
  * @brief Merge trace data streams.
@@ -1969,6 +3354,9 @@ struct kshark_entry **
 kshark_merge_data_entries(struct kshark_entry_data_set *buffers, size_t n_buffers)
 {
 	struct kshark_entry **merged_data;
+	//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+	struct kshark_merge_heap heap;
+	// END of change
 	ssize_t count[n_buffers];
 	size_t i, tot = 0;
 	int i_first;
@@ -1986,22 +3374,206 @@ kshark_merge_data_entries(struct kshark_entry_data_set *buffers, size_t n_buffer
 	}
 
 	merged_data = calloc(tot, sizeof(*merged_data));
-	if (!merged_data) {
+	//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+	if (!merged_data || !kshark_merge_heap_init(&heap, n_buffers)) {
+		free(merged_data);
 		fputs("Failed to allocate memory for mergeing data entries.\n",
 		      stderr);
 		return NULL;
 	}
 
+	/* Each data set is sorted in time. Merge them via a min-heap. */
+	for (i = 0; i < n_buffers; ++i)
+		if (buffers[i].n_rows > 0)
+			kshark_merge_heap_push(&heap, i, buffers[i].data[0]->ts);
+
 	for (i = 0; i < tot; ++i) {
-		i_first = first_in_time_entry(buffers, n_buffers, count);
+		i_first = kshark_merge_heap_top(&heap);
 		assert(i_first >= 0);
 		merged_data[i] = buffers[i_first].data[count[i_first]];
-		++count[i_first];
+
+		if (++count[i_first] < buffers[i_first].n_rows)
+			kshark_merge_heap_replace_top(&heap,
+				buffers[i_first].data[count[i_first]]->ts);
+		else
+			kshark_merge_heap_pop(&heap);
 	}
 
+	kshark_merge_heap_free(&heap);
+	// END of change
+
 	return merged_data;
 }
 
+//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+/** Shared state of the threads loading several Data streams concurrently. */
+struct streams_loader {
+	/** KernelShark context. */
+	struct kshark_context		*kshark_ctx;
+
+	/** Output location for the data sets, one per Data stream. */
+	struct kshark_entry_data_set	*buffers;
+
+	/** Data stream identifier of the first data set. */
+	int				sd_first;
+
+	/**
+	 * Indexes of the data sets, ordered such that the Data streams of the
+	 * same trace file are adjacent.
+	 */
+	int				*order;
+
+	/**
+	 * Index (in "order") of the first data set of each group of Data
+	 * streams. Contains "n_groups + 1" elements.
+	 */
+	int				*group_start;
+
+	/** The number of groups of Data streams. */
+	int				n_groups;
+
+	/** The group to be loaded next. */
+	int				next_group;
+};
+
+static void load_stream_groups(struct streams_loader *loader)
+{
+	struct kshark_entry_data_set *set;
+	int g, i, b;
+
+	while ((g = __atomic_fetch_add(&loader->next_group, 1,
+				       __ATOMIC_RELAXED)) < loader->n_groups) {
+		for (i = loader->group_start[g];
+		     i < loader->group_start[g + 1]; ++i) {
+			b = loader->order[i];
+			set = &loader->buffers[b];
+			set->data = NULL;
+			set->n_rows = kshark_load_entries(loader->kshark_ctx,
+							  loader->sd_first + b,
+							  &set->data);
+		}
+	}
+}
+
+static void *load_stream_groups_thread(void *data)
+{
+	load_stream_groups(data);
+
+	/* The plugins may have used the trace sequence of this thread. */
+	kshark_tep_release_thread_seq();
+
+	return NULL;
+}
+
+static bool same_stream_file(struct kshark_data_stream *a,
+			     struct kshark_data_stream *b)
+{
+	return a && b && a->file && b->file && strcmp(a->file, b->file) == 0;
+}
+
+/*
+ * Load "n" Data streams, starting from "sd_first", into "buffers". The
+ * Data streams of different trace files are loaded concurrently. The
+ * streams of the same file (the buffers of a multi-buffer file) may share
+ * their event parser, hence they are loaded one after another by the same
+ * thread. The CPU buffers of the streams are decoded in parallel by the
+ * processors, left over by the threads loading the streams (shared budget).
+ * In the case of failure, the "n_rows" field of the corresponding data set
+ * holds a negative error code.
+ */
+static void load_streams_concurrently(struct kshark_context *kshark_ctx,
+				      struct kshark_entry_data_set *buffers,
+				      int sd_first, int n)
+{
+	struct streams_loader loader = {};
+	struct kshark_data_stream *stream;
+	int i, k, g, n_threads, threads_left;
+	pthread_t *threads = NULL;
+	bool *grouped = NULL;
+	long n_cpus;
+
+	loader.kshark_ctx = kshark_ctx;
+	loader.buffers = buffers;
+	loader.sd_first = sd_first;
+
+	loader.order = calloc(n, sizeof(*loader.order));
+	loader.group_start = calloc(n + 1, sizeof(*loader.group_start));
+	grouped = calloc(n, sizeof(*grouped));
+	if (!loader.order || !loader.group_start || !grouped)
+		goto sequential;
+
+	for (i = 0, k = 0; i < n; ++i) {
+		if (grouped[i])
+			continue;
+
+		loader.group_start[loader.n_groups++] = k;
+		loader.order[k++] = i;
+		stream = kshark_get_data_stream(kshark_ctx, sd_first + i);
+		for (g = i + 1; g < n; ++g) {
+			if (!grouped[g] &&
+			    same_stream_file(stream,
+					     kshark_get_data_stream(kshark_ctx,
+								    sd_first + g))) {
+				grouped[g] = true;
+				loader.order[k++] = g;
+			}
+		}
+	}
+
+	loader.group_start[loader.n_groups] = n;
+
+	n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	n_threads = (n_cpus > loader.n_groups) ? loader.n_groups : n_cpus;
+
+	if (n_threads > 1)
+		threads = calloc(n_threads - 1, sizeof(*threads));
+
+	/*
+	 * The processors, not used by the threads loading the streams, are
+	 * shared by all streams to decode their CPU buffers in parallel.
+	 */
+	threads_left = (n_cpus > n_threads) ? n_cpus - n_threads : 0;
+	kshark_ctx->load_threads_left = &threads_left;
+
+	/* The calling thread is also loading. */
+	for (k = 0; threads && k < n_threads - 1; ++k)
+		if (pthread_create(&threads[k], NULL,
+				   load_stream_groups_thread, &loader) != 0)
+			break;
+
+	/* Give the threads, which have not started, to the budget. */
+	if (n_threads > 1)
+		__atomic_add_fetch(&threads_left, n_threads - 1 - k,
+				   __ATOMIC_RELAXED);
+
+	load_stream_groups(&loader);
+
+	for (i = 0; i < k; ++i)
+		pthread_join(threads[i], NULL);
+
+	kshark_ctx->load_threads_left = NULL;
+
+	free(threads);
+	free(grouped);
+	free(loader.order);
+	free(loader.group_start);
+
+	return;
+
+ sequential:
+	free(grouped);
+	free(loader.order);
+	free(loader.group_start);
+
+	for (i = 0; i < n; ++i) {
+		buffers[i].data = NULL;
+		buffers[i].n_rows = kshark_load_entries(kshark_ctx,
+							sd_first + i,
+							&buffers[i].data);
+	}
+}
+// END of change
+
 static ssize_t load_all_entries(struct kshark_context *kshark_ctx,
 				struct kshark_entry **loaded_rows,
 				ssize_t n_loaded,
@@ -2027,12 +3599,12 @@ static ssize_t load_all_entries(struct kshark_context *kshark_ctx,
 		buffers[n_data_sets - 1].data = loaded_rows;
 	}
 
+	//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
 	/* Add the data of the new streams. */
-	for (i = sd_first_new; i < n_streams; ++i) {
-		buffers[j].data = NULL;
-		buffers[j].n_rows = kshark_load_entries(kshark_ctx, i,
-							&buffers[j].data);
+	load_streams_concurrently(kshark_ctx, buffers, sd_first_new,
+				  n_streams - sd_first_new);
 
+	for (i = sd_first_new; i < n_streams; ++i) {
 		if (buffers[j].n_rows < 0) {
 			/* Loading failed. */
 			data_size = buffers[j].n_rows;
@@ -2047,9 +3619,28 @@ static ssize_t load_all_entries(struct kshark_context *kshark_ctx,
 	} else {
 		/* Merge all streams. */
 		*data_rows = kshark_merge_data_entries(buffers, n_data_sets);
+
+		/* The merged array replaces the arrays of all data sets. */
+		free(buffers[0].data);
 	}
 
+	goto end;
+
  error:
+	/*
+	 * The other new streams have been loaded concurrently. Release
+	 * their entries.
+	 */
+	for (j = 0; j < n_streams - sd_first_new; ++j) {
+		if (buffers[j].n_rows > 0)
+			kshark_free_entries(kshark_ctx, buffers[j].data,
+					    buffers[j].n_rows);
+
+		buffers[j].data = NULL;
+	}
+
+ end:
+	// END of change
 	for (i = 1; i < n_data_sets; ++i)
 		free(buffers[i].data);
 
@@ -2115,26 +3706,6 @@ ssize_t kshark_append_all_entries(struct kshark_context *kshark_ctx,
 				merged_data);
 }
 
-static int first_in_time_row(struct kshark_matrix_data_set *buffers,
-			     int n_buffers,
-			     ssize_t *count)
-{
-	int64_t t_min = INT64_MAX;
-	int i, min = -1;
-
-	for (i = 0; i < n_buffers; ++i) {
-		if (count[i] == buffers[i].n_rows)
-			continue;
-
-		if (t_min > buffers[i].ts_array[count[i]]) {
-			t_min = buffers[i].ts_array[count[i]];
-			min = i;
-		}
-	}
-
-	return min;
-}
-
 /**
  * @brief Merge trace data streams.
  *
@@ -2149,6 +3720,9 @@ struct kshark_matrix_data_set
 kshark_merge_data_matrices(struct kshark_matrix_data_set *buffers, size_t n_buffers)
 {
 	struct kshark_matrix_data_set merged_data;
+	//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+	struct kshark_merge_heap heap;
+	// END of change
 	ssize_t count[n_buffers];
 	size_t i, tot = 0;
 	int i_first;
@@ -2167,6 +3741,14 @@ kshark_merge_data_matrices(struct kshark_matrix_data_set *buffers, size_t n_buff
 			tot += buffers[i].n_rows;
 	}
 
+	//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+	if (!kshark_merge_heap_init(&heap, n_buffers)) {
+		fputs("Failed to allocate memory for mergeing data matrices.\n",
+		      stderr);
+		goto end;
+	}
+	// END of change
+
 	status = kshark_data_matrix_alloc(tot, &merged_data.event_array,
 					       &merged_data.cpu_array,
 					       &merged_data.pid_array,
@@ -2175,13 +3757,25 @@ kshark_merge_data_matrices(struct kshark_matrix_data_set *buffers, size_t n_buff
 	if (!status) {
 		fputs("Failed to allocate memory for mergeing data matrices.\n",
 		      stderr);
+		//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+		kshark_merge_heap_free(&heap);
+		// END of change
 		goto end;
 	}
 
 	merged_data.n_rows = tot;
 
+	//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+	/* Each data set is sorted in time. Merge them via a min-heap. */
+	for (i = 0; i < n_buffers; ++i)
+		if (buffers[i].n_rows > 0)
+			kshark_merge_heap_push(&heap, i, buffers[i].ts_array[0]);
+	// END of change
+
 	for (i = 0; i < tot; ++i) {
-		i_first = first_in_time_row(buffers, n_buffers, count);
+		//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+		i_first = kshark_merge_heap_top(&heap);
+		// END of change
 		assert(i_first >= 0);
 
 		merged_data.cpu_array[i] = buffers[i_first].cpu_array[count[i_first]];
@@ -2190,9 +3784,19 @@ kshark_merge_data_matrices(struct kshark_matrix_data_set *buffers, size_t n_buff
 		merged_data.offset_array[i] = buffers[i_first].offset_array[count[i_first]];
 		merged_data.ts_array[i] = buffers[i_first].ts_array[count[i_first]];
 
-		++count[i_first];
+		//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+		if (++count[i_first] < buffers[i_first].n_rows)
+			kshark_merge_heap_replace_top(&heap,
+				buffers[i_first].ts_array[count[i_first]]);
+		else
+			kshark_merge_heap_pop(&heap);
+		// END of change
 	}
 
+	//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+	kshark_merge_heap_free(&heap);
+	// END of change
+
  end:
 	return merged_data;
 }
@@ -102,6 +102,11 @@ struct kshark_hash_id {
 	 * 1 << n_bits.
 	 */
 	size_t	n_bits;
+
+	//NOTE: Changed here. (ID SETS) (2026-10-17)
+	/** Incremented each time the content of the table changes. */
+	unsigned int	version;
+	// END of change
 };
 
 bool kshark_hash_id_find(struct kshark_hash_id *hash, int id);
@@ -116,6 +121,108 @@ void kshark_hash_id_free(struct kshark_hash_id *hash);
 
 int *kshark_hash_ids(struct kshark_hash_id *hash);
 
+//NOTE: Changed here. (ID SETS) (2026-10-17)
+/**
+ * The biggest range of Ids (maximum - minimum + 1), for which a set of Ids
+ * is stored as a bitmap.
+ */
+#define KS_ID_SET_DENSE_MAX	(1 << 16)
+
+/** Marker of an empty slot of a set of Ids (not a valid Id). */
+#define KS_ID_SET_EMPTY		INT32_MIN
+
+/**
+ * Read-only set of integer Id numbers, built from a hash table of Ids. To be
+ * used for fast filtering of trace entries. The set is either a bitmap
+ * (dense Ids) or an open addressing hash table (sparse Ids).
+ */
+struct kshark_id_set {
+	/** Bitmap of the Ids. NULL if the set is not dense. */
+	uint64_t	*bits;
+
+	/** The Id of the first bit of the bitmap. */
+	int		min;
+
+	/** The number of bits of the bitmap. */
+	size_t		n_bits;
+
+	/** Open addressing table of the Ids. NULL if the set is dense. */
+	int		*slots;
+
+	/** The number of slots of the table minus one. */
+	size_t		mask;
+
+	/** The number of Ids in the set. */
+	size_t		count;
+};
+
+static inline size_t kshark_id_set_slot(const struct kshark_id_set *set,
+					int id)
+{
+	return ((uint32_t) id * UINT32_C(2654435761)) & set->mask;
+}
+
+/** Check if an Id with a given value exists in this set. */
+static inline bool kshark_id_set_find(const struct kshark_id_set *set, int id)
+{
+	size_t i, bit;
+
+	if (set->bits) {
+		bit = (size_t) ((int64_t) id - set->min);
+		return bit < set->n_bits &&
+		       (set->bits[bit / 64] >> (bit % 64)) & 1;
+	}
+
+	if (!set->slots)
+		return false;
+
+	for (i = kshark_id_set_slot(set, id);
+	     set->slots[i] != KS_ID_SET_EMPTY;
+	     i = (i + 1) & set->mask)
+		if (set->slots[i] == id)
+			return true;
+
+	return false;
+}
+
+int kshark_id_set_build(struct kshark_id_set *set, struct kshark_hash_id *hash);
+
+void kshark_id_set_free(struct kshark_id_set *set);
+// END of change
+
+//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+/** Default size of the memory chunks of an arena (2 MiB). */
+#define KS_ARENA_CHUNK_SIZE	(1UL << 21)
+
+struct kshark_arena_chunk;
+
+/**
+ * Memory arena used to allocate large numbers of small objects. The objects
+ * cannot be released individually. All memory is released at once.
+ */
+struct kshark_mem_arena {
+	/** List of memory chunks. The first one is used for new allocations. */
+	struct kshark_arena_chunk	*chunks;
+
+	/** The size of the memory chunks in bytes. */
+	size_t				chunk_size;
+
+	/** The total number of bytes owned by the arena. */
+	size_t				n_bytes;
+};
+
+struct kshark_mem_arena *kshark_arena_alloc(size_t chunk_size);
+
+void *kshark_arena_malloc(struct kshark_mem_arena *arena, size_t size);
+
+void kshark_arena_merge(struct kshark_mem_arena *dst,
+			struct kshark_mem_arena *src);
+
+void kshark_arena_clear(struct kshark_mem_arena *arena);
+
+void kshark_arena_free(struct kshark_mem_arena *arena);
+// END of change
+
 /* Quiet warnings over documenting simple structures */
 //! @cond Doxygen_Suppress
 
@@ -291,6 +398,22 @@ struct kshark_generic_stream_interface {
 /** Data format identifier string indicating invalid data. */
 #define KS_INVALID_DATA		"invalid data"
 
+//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+/**
+ * Value of the number of loading threads, meaning one thread per online
+ * processor.
+ */
+#define KS_LOAD_THREADS_AUTO	0
+// END of change
+
+//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+/**
+ * Suffix of the sidecar cache file of the entries of a Data stream, appended
+ * to the name of the trace data file.
+ */
+#define KS_ENTRY_CACHE_SUFFIX	".ksidx"
+// END of change
+
 /** Structure representing a stream of trace data. */
 struct kshark_data_stream {
 	/** Data stream identifier. */
@@ -396,6 +519,71 @@ struct kshark_data_stream {
 	*/
 	int couplebreak_evts_flags;
 	// END of change
+
+	//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+	/**
+	 * @brief The number of threads used to decode the CPU buffers when
+	 * loading entries. The default value is 1 (sequential loading). Use
+	 * KS_LOAD_THREADS_AUTO for one thread per online processor.
+	 */
+	int n_load_threads;
+	// END of change
+
+	//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+	/**
+	 * @brief Memory arena owning the entries of the stream. NULL if every
+	 * entry is allocated individually (default). See
+	 * kshark_set_entry_arena().
+	 */
+	struct kshark_mem_arena *entry_arena;
+	// END of change
+
+	//NOTE: Changed here. (EVENT DISPATCH) (2026-10-17)
+	/**
+	 * @brief Plugin's Event handlers, indexed by Event Id. Rebuilt each
+	 * time an Event handler is registered or unregistered. NULL if there
+	 * are no handlers.
+	 */
+	struct kshark_event_dispatch *event_dispatch;
+	// END of change
+
+	//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+	/**
+	 * @brief If set, the loaded entries are stored in a sidecar cache
+	 * file and restored from it when the stream is loaded again. See
+	 * kshark_set_entry_cache().
+	 */
+	bool entry_cache;
+	// END of change
+
+	//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+	/**
+	 * @brief The records with (calibrated) timestamps before this value
+	 * are not loaded. INT64_MIN by default. See
+	 * kshark_set_load_time_range().
+	 */
+	int64_t load_ts_min;
+
+	/**
+	 * @brief The records with (calibrated) timestamps after this value
+	 * are not loaded. INT64_MAX by default.
+	 */
+	int64_t load_ts_max;
+
+	/**
+	 * @brief Hash of the Ids of the events to be loaded. NULL if all
+	 * events are loaded (default). See kshark_set_load_events().
+	 */
+	struct kshark_hash_id *load_events;
+	// END of change
+
+	//NOTE: Changed here. (ID SETS) (2026-10-17)
+	/**
+	 * @brief Lookup-optimized copies of the Id filters. NULL if not built
+	 * yet. See kshark_update_filter_sets().
+	 */
+	struct kshark_filter_sets *filter_sets;
+	// END of change
 };
 
 static inline char *kshark_set_data_format(char *dest_format,
@@ -422,6 +610,53 @@ struct kshark_stream_array_descriptor {
 	int		array_size;
 };
 
+//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+/** The number of time windows a Data stream is loaded in, when the progress is reported. */
+#define KS_LOAD_PROGRESS_STEPS	100
+
+/** Structure describing the progress of the loading of a Data stream. */
+struct kshark_load_progress {
+	/** The number of bytes of the CPU buffers processed so far. */
+	uint64_t	bytes_done;
+
+	/** The total number of bytes of the CPU buffers. */
+	uint64_t	bytes_total;
+
+	/** The timestamp of the first record of the Data stream. */
+	int64_t		ts_first;
+
+	/**
+	 * All entries having timestamps up to (and including) this value are
+	 * already loaded.
+	 */
+	int64_t		ts_loaded;
+
+	/** The timestamp of the last record of the Data stream. */
+	int64_t		ts_last;
+};
+
+/**
+ * A function type to be used to report the progress of the loading of a
+ * Data stream. When several Data streams are loaded concurrently, the
+ * function may be called from several threads at the same time.
+ */
+typedef void (*kshark_load_progress_func)(struct kshark_data_stream *stream,
+					  const struct kshark_load_progress *progress,
+					  void *data);
+
+/**
+ * A function type to be used to receive the entries of a Data stream in
+ * batches, while the stream is being loaded. The entries of each batch are
+ * sorted in time and are all newer than the entries of the previous batches.
+ * The "batch" array is only valid during the call.
+ */
+typedef void (*kshark_load_batch_func)(struct kshark_data_stream *stream,
+				       struct kshark_entry **batch,
+				       ssize_t n_entries,
+				       const struct kshark_load_progress *progress,
+				       void *data);
+// END of change
+
 /** Structure representing a kshark session. */
 struct kshark_context {
 	/** Array of data stream descriptors. */
@@ -454,6 +689,35 @@ struct kshark_context {
 
 	/** The number of plugins. */
 	int				n_plugins;
+
+	//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+	/**
+	 * Function used to report the progress of data loading. NULL if the
+	 * progress is not reported (default).
+	 */
+	kshark_load_progress_func	load_progress_func;
+
+	/** User data passed to the load progress function. */
+	void				*load_progress_data;
+	// END of change
+
+	//NOTE: Changed here. (PARALLEL FILTER) (2026-10-17)
+	/**
+	 * The number of threads used to filter the entries, or
+	 * KS_LOAD_THREADS_AUTO for one thread per online processor.
+	 */
+	int				n_filter_threads;
+	// END of change
+
+	//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+	/**
+	 * The number of additional threads, which may still be started to
+	 * decode CPU buffers, while several Data streams are being loaded
+	 * concurrently. The streams share this budget. NULL if the streams
+	 * are not loaded concurrently.
+	 */
+	int				*load_threads_left;
+	// END of change
 };
 
 bool kshark_instance(struct kshark_context **kshark_ctx);
@@ -528,6 +792,49 @@ int kshark_read_event_field_int(const struct kshark_entry *entry,
 ssize_t kshark_load_entries(struct kshark_context *kshark_ctx, int sd,
 			    struct kshark_entry ***data_rows);
 
+//NOTE: Changed here. (PARALLEL LOAD) (2026-10-17)
+int kshark_set_load_threads(struct kshark_context *kshark_ctx, int sd,
+			    int n_threads);
+// END of change
+
+//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+int kshark_set_entry_arena(struct kshark_context *kshark_ctx, int sd,
+			   bool on);
+
+void kshark_free_entries(struct kshark_context *kshark_ctx,
+			 struct kshark_entry **data_rows, ssize_t n_rows);
+// END of change
+
+//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+int kshark_set_entry_cache(struct kshark_context *kshark_ctx, int sd,
+			   bool on);
+// END of change
+
+//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+int kshark_set_load_time_range(struct kshark_context *kshark_ctx, int sd,
+			       int64_t min, int64_t max);
+
+int kshark_set_load_events(struct kshark_context *kshark_ctx, int sd,
+			   const int *event_ids, int n_events);
+
+int kshark_set_load_event_names(struct kshark_context *kshark_ctx, int sd,
+				char **names, int n_names);
+
+int kshark_parse_seconds(const char *str, int64_t *ns);
+// END of change
+
+//NOTE: Changed here. (LOAD PROGRESS) (2026-10-17)
+void kshark_set_load_progress_func(struct kshark_context *kshark_ctx,
+				   kshark_load_progress_func func,
+				   void *data);
+
+ssize_t kshark_load_entries_progressive(struct kshark_context *kshark_ctx,
+					int sd,
+					kshark_load_batch_func batch_func,
+					void *data,
+					struct kshark_entry ***data_rows);
+// END of change
+
 ssize_t kshark_load_matrix(struct kshark_context *kshark_ctx, int sd,
 			   int16_t **event_array,
 			   int16_t **cpu_array,
@@ -609,6 +916,25 @@ enum kshark_filter_type {
 	KS_HIDE_CPU_FILTER,
 };
 
+//NOTE: Changed here. (ID SETS) (2026-10-17)
+/** The number of Id filter identifiers (see enum kshark_filter_type). */
+#define KS_N_ID_FILTERS		(KS_HIDE_CPU_FILTER + 1)
+
+/**
+ * Lookup-optimized copies of the Id filters of a Data stream. The copies are
+ * used only if they are up to date with the filters.
+ */
+struct kshark_filter_sets {
+	/** Sets of Ids, indexed by the identifier of the filter. */
+	struct kshark_id_set	sets[KS_N_ID_FILTERS];
+
+	/** The versions of the filters, the sets are built from. */
+	unsigned int		versions[KS_N_ID_FILTERS];
+};
+
+int kshark_update_filter_sets(struct kshark_context *kshark_ctx, int sd);
+// END of change
+
 struct kshark_hash_id *
 kshark_get_filter(struct kshark_data_stream *stream,
 		  enum kshark_filter_type filter_id);
@@ -656,6 +982,17 @@ void kshark_clear_all_filters(struct kshark_context *kshark_ctx,
 			      struct kshark_entry **data,
 			      size_t n_entries);
 
+//NOTE: Changed here. (PARALLEL FILTER) (2026-10-17)
+/**
+ * The smallest number of entries filtered by a thread. Smaller arrays of
+ * entries are filtered by fewer threads.
+ */
+#define KS_FILTER_CHUNK_SIZE	(1 << 16)
+
+int kshark_set_filter_threads(struct kshark_context *kshark_ctx,
+			      int n_threads);
+// END of change
+
 void kshark_plugin_actions(struct kshark_data_stream *stream,
 			   void *record, struct kshark_entry *entry);
 
@@ -690,6 +1027,103 @@ ssize_t kshark_find_entry_by_time(int64_t time,
 				  struct kshark_entry **data_rows,
 				  size_t l, size_t h);
 
+//NOTE: Changed here. (TIME GRID) (2026-10-17)
+/**
+ * Each row of the time grid is searched with a binary search over at most
+ * this many rows on average.
+ */
+#define KS_TS_GRID_DENSITY	16
+
+/**
+ * Uniform grid over the time span of a sorted column of timestamps. The time
+ * step of the grid is a power of two. For each cell of the grid, the grid
+ * holds the first row having timestamp equal or bigger than the start of the
+ * cell, so a search by time only has to look inside a single cell.
+ */
+struct kshark_ts_grid {
+	/** The number of rows of the column of timestamps. */
+	size_t		size;
+
+	/** The start of the first cell (the first timestamp). */
+	int64_t		ts0;
+
+	/** Log2 of the time step of the grid. */
+	int		shift;
+
+	/** The number of cells. */
+	size_t		n_cells;
+
+	/**
+	 * The first row of each cell. There is one extra element, holding the
+	 * number of rows.
+	 */
+	uint32_t	*rows;
+};
+
+bool kshark_ts_grid_build(struct kshark_ts_grid *grid,
+			  const int64_t *ts, size_t n);
+
+void kshark_ts_grid_free(struct kshark_ts_grid *grid);
+// END of change
+
+//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+/**
+ * Columnar (structure of arrays) copy of the most frequently accessed fields
+ * of an array of trace entries. Row "i" of every column describes the "i"-th
+ * entry of the array used to fill the columns. The columns do not own the
+ * entries. They only allow scanning and searching the data without
+ * dereferencing a pointer for each entry.
+ */
+struct kshark_entry_columns {
+	/** The number of rows. */
+	size_t		size;
+
+	/** Timestamp column. All columns share the memory allocated for it. */
+	int64_t		*ts;
+
+	/** PID column. */
+	int32_t		*pid;
+
+	/** Data stream Id column. */
+	int16_t		*stream_id;
+
+	/** CPU Id column. */
+	int16_t		*cpu;
+
+	/** Event Id column. */
+	int16_t		*event_id;
+
+	//NOTE: Changed here. (TIME GRID) (2026-10-17)
+	/** Time grid of the timestamp column. Empty if it failed to build. */
+	struct kshark_ts_grid	grid;
+	// END of change
+};
+
+bool kshark_entry_columns_alloc(struct kshark_entry_columns *columns,
+				size_t n);
+
+bool kshark_entry_columns_fill(struct kshark_entry_columns *columns,
+			       struct kshark_entry **data_rows, size_t n);
+
+void kshark_entry_columns_free(struct kshark_entry_columns *columns);
+
+//NOTE: Changed here. (PARALLEL FILTER) (2026-10-17)
+void kshark_filter_column_entries(struct kshark_context *kshark_ctx, int sd,
+				  struct kshark_entry **data,
+				  const struct kshark_entry_columns *columns,
+				  size_t n_entries);
+// END of change
+
+ssize_t kshark_find_ts_by_time(int64_t time, const int64_t *ts,
+			       size_t l, size_t h);
+
+//NOTE: Changed here. (TIME GRID) (2026-10-17)
+ssize_t kshark_find_ts_by_grid(int64_t time, const int64_t *ts,
+			       const struct kshark_ts_grid *grid,
+			       size_t l, size_t h);
+// END of change
+// END of change
+
 /**
  * @brief Simple Pid matching function to be user for data requests.
  *
@@ -900,6 +1334,38 @@ kshark_register_data_collection(struct kshark_context *kshark_ctx,
 				int sd, int *values, size_t n_val,
 				size_t margin);
 
+//NOTE: Changed here. (CPU COLLECTIONS) (2026-10-17)
+int kshark_add_cpu_collections_to_list(struct kshark_context *kshark_ctx,
+				       struct kshark_entry_collection **col_list,
+				       struct kshark_entry **data,
+				       size_t n_rows,
+				       matching_condition_func cond,
+				       int sd, const int *cpus, size_t n_cpus);
+
+int kshark_register_cpu_collections(struct kshark_context *kshark_ctx,
+				    struct kshark_entry **data, size_t n_rows,
+				    matching_condition_func cond,
+				    int sd, const int *cpus, size_t n_cpus);
+// END of change
+
+//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+struct kshark_entry_collection *
+kshark_add_indexed_collection_to_list(struct kshark_context *kshark_ctx,
+				      struct kshark_entry_collection **col_list,
+				      struct kshark_entry **data,
+				      size_t n_rows,
+				      const uint32_t *rows, size_t n_indexed,
+				      matching_condition_func cond,
+				      int sd, int *values, size_t n_val);
+
+struct kshark_entry_collection *
+kshark_register_indexed_collection(struct kshark_context *kshark_ctx,
+				   struct kshark_entry **data, size_t n_rows,
+				   const uint32_t *rows, size_t n_indexed,
+				   matching_condition_func cond,
+				   int sd, int *values, size_t n_val);
+// END of change
+
 void kshark_unregister_data_collection(struct kshark_entry_collection **col,
 				       matching_condition_func cond,
 				       int sd, int *values, size_t n_val);
@@ -1163,6 +1629,58 @@ void kshark_set_clock_offset(struct kshark_context *kshark_ctx,
 			     struct kshark_entry **entries, size_t size,
 			     int sd, int64_t offset);
 
+//NOTE: Changed here. (HEAP MERGE) (2026-10-17)
+/** An element of the merge heap. */
+struct kshark_merge_node {
+	/** The timestamp of the current head of the source. */
+	int64_t		ts;
+
+	/** Source identifier (e.g. CPU Id or index of a data set). */
+	int		src;
+};
+
+/**
+ * Binary min-heap, used for k-way merging of time-sorted sources (per-CPU
+ * record lists, data sets of different streams, ...). The sources are
+ * ordered by the timestamps of their heads. Sources with equal timestamps
+ * are ordered by their identifiers, so the merge is deterministic.
+ */
+struct kshark_merge_heap {
+	/** Array of heap elements. */
+	struct kshark_merge_node	*nodes;
+
+	/** The number of sources in the heap. */
+	int				size;
+
+	/** The capacity of the heap. */
+	int				capacity;
+};
+
+bool kshark_merge_heap_init(struct kshark_merge_heap *heap, int capacity);
+
+void kshark_merge_heap_push(struct kshark_merge_heap *heap,
+			    int src, int64_t ts);
+
+void kshark_merge_heap_replace_top(struct kshark_merge_heap *heap,
+				   int64_t ts);
+
+void kshark_merge_heap_pop(struct kshark_merge_heap *heap);
+
+void kshark_merge_heap_free(struct kshark_merge_heap *heap);
+
+/**
+ * @brief Get the identifier of the source with the earliest head.
+ *
+ * @param heap: Input location for the merge heap.
+ *
+ * @returns Source identifier, or -1 if the heap is empty.
+ */
+static inline int kshark_merge_heap_top(struct kshark_merge_heap *heap)
+{
+	return heap->size ? heap->nodes[0].src : -1;
+}
+// END of change
+
 /** Structure representing a data set made of KernelShark entries. */
 struct kshark_entry_data_set {
 	/** Array of entries pointers. */
@@ -11,8 +11,20 @@
 // KernelShark
 #include "libkshark.h"
 #include "libkshark-plugin.h"
+//NOTE: Changed here. (ADV FILTER REFRESH) (2026-10-17)
+#include "libkshark-tepdata.h"
+// END of change
 #include "KsUtils.hpp"
 #include "KsModels.hpp"
+//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+#include "KsPlotTools.hpp"
+
+// Qt
+#include <QGuiApplication>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+// END of change
 
 
 using namespace KsUtils;
@@ -314,3 +326,177 @@ BOOST_AUTO_TEST_CASE(KsUtils_parseTasks)
 	kshark_close(kshark_ctx, sd);
 	kshark_free(kshark_ctx);
 }
+
+//NOTE: Changed here. (ADV FILTER REFRESH) (2026-10-17)
+BOOST_AUTO_TEST_CASE(KsUtils_advFilterRefresh)
+{
+	const char *filter = "sched/sched_switch: prev_prio < 120";
+	kshark_context *kshark_ctx{nullptr};
+	kshark_entry **data{nullptr};
+	std::string file(KS_TEST_DIR);
+	std::vector<uint16_t> visible;
+	kshark_data_stream *stream;
+	ssize_t n_rows, r;
+	int sd;
+
+	kshark_instance(&kshark_ctx);
+	kshark_ctx->filter_mask = KS_TEXT_VIEW_FILTER_MASK |
+				  KS_GRAPH_VIEW_FILTER_MASK |
+				  KS_EVENT_VIEW_FILTER_MASK;
+
+	file += "/trace_test1.dat";
+	sd = kshark_open(kshark_ctx, file.c_str());
+	stream = kshark_get_data_stream(kshark_ctx, sd);
+	BOOST_REQUIRE(stream);
+
+	/* The advanced filter is applied while loading. */
+	BOOST_REQUIRE(kshark_tep_add_filter_str(stream, filter) >= 0);
+	n_rows = kshark_load_entries(kshark_ctx, sd, &data);
+	BOOST_REQUIRE(n_rows > 0);
+	for (r = 0; r < n_rows; ++r) {
+		visible.push_back(data[r]->visible);
+		free(data[r]);
+	}
+
+	free(data);
+
+	/* The same filter, applied to loaded entries. */
+	kshark_tep_filter_reset(stream);
+	BOOST_REQUIRE_EQUAL(kshark_load_entries(kshark_ctx, sd, &data), n_rows);
+	BOOST_REQUIRE(kshark_tep_add_filter_str(stream, filter) >= 0);
+	kshark_filter_stream_entries(kshark_ctx, sd, data, n_rows);
+	for (r = 0; r < n_rows; ++r)
+		BOOST_CHECK_EQUAL(data[r]->visible, visible[r]);
+
+	/* Removing the filter makes all entries visible again. */
+	kshark_tep_filter_reset(stream);
+	kshark_filter_stream_entries(kshark_ctx, sd, data, n_rows);
+	for (r = 0; r < n_rows; ++r)
+		BOOST_CHECK(data[r]->visible & KS_EVENT_VIEW_FILTER_MASK);
+
+	for (r = 0; r < n_rows; ++r)
+		free(data[r]);
+	free(data);
+
+	kshark_close(kshark_ctx, sd);
+	kshark_free(kshark_ctx);
+}
+// END of change
+
+//NOTE: Changed here. (PLOT BATCH) (2026-10-17)
+BOOST_AUTO_TEST_CASE(KsPlot_batch)
+{
+	KsPlot::Point a(0, 0), b(10, 0), c(10, 10);
+	KsPlot::Line l1(a, b), l2(b, c);
+	KsPlot::Rectangle rec;
+	ksplot_batch batch;
+
+	rec.setPoint(0, 0, 0);
+	rec.setPoint(1, 10, 0);
+	rec.setPoint(2, 10, 10);
+	rec.setPoint(3, 0, 10);
+	rec._color = KsPlot::Color(1, 2, 3);
+
+	/* Recording needs no OpenGL context. */
+	ksplot_batch_init(&batch);
+	ksplot_batch_begin(&batch);
+	l1.draw();
+	l2.draw();
+	rec.draw();
+	a.draw();
+	l1.draw();
+	BOOST_REQUIRE(ksplot_batch_end());
+
+	/* Consecutive lines of the same width are drawn by a single run. */
+	BOOST_REQUIRE_EQUAL(batch.n_runs, 4);
+	BOOST_CHECK_EQUAL(batch.runs[0].type, KSPLOT_LINES);
+	BOOST_CHECK_EQUAL(batch.runs[0].count, 4);
+	BOOST_CHECK_EQUAL(batch.runs[1].type, KSPLOT_TRIANGLES);
+	BOOST_CHECK_EQUAL(batch.runs[1].first, 4);
+	BOOST_CHECK_EQUAL(batch.runs[1].count, 6);
+	BOOST_CHECK_EQUAL(batch.runs[2].type, KSPLOT_POINTS);
+	BOOST_CHECK_EQUAL(batch.runs[2].count, 1);
+	BOOST_CHECK_EQUAL(batch.runs[3].type, KSPLOT_LINES);
+	BOOST_CHECK_EQUAL(batch.n_vertices, 13);
+
+	BOOST_CHECK_EQUAL(batch.vertices[5].x, 10);
+	BOOST_CHECK_EQUAL(batch.vertices[5].y, 0);
+	BOOST_CHECK_EQUAL(batch.vertices[5].color[2], 3);
+
+	/* Recording again drops the old shapes. */
+	ksplot_batch_begin(&batch);
+	a.draw();
+	BOOST_REQUIRE(ksplot_batch_end());
+	BOOST_CHECK_EQUAL(batch.n_runs, 1);
+	BOOST_CHECK_EQUAL(batch.n_vertices, 1);
+
+	ksplot_batch_free(&batch);
+	BOOST_CHECK_EQUAL(batch.n_vertices, 0);
+}
+
+#define BATCH_IMG_SIZE	64
+
+BOOST_AUTO_TEST_CASE(KsPlot_batch_draw)
+{
+	KsPlot::Point a(40, 10), b(60, 10), p(50, 50);
+	KsPlot::Line line(a, b);
+	KsPlot::Rectangle rec;
+	QOffscreenSurface surface;
+	QOpenGLContext context;
+	ksplot_batch batch;
+	int argc{0};
+	QImage img;
+
+	/* Runs with any OpenGL, e.g. Mesa llvmpipe on the offscreen platform. */
+	QGuiApplication app(argc, nullptr);
+
+	surface.create();
+	if (!context.create() || !context.makeCurrent(&surface)) {
+		BOOST_TEST_MESSAGE("No OpenGL context. Drawing is not tested.");
+		return;
+	}
+
+	rec.setPoint(0, 8, 8);
+	rec.setPoint(1, 24, 8);
+	rec.setPoint(2, 24, 24);
+	rec.setPoint(3, 8, 24);
+	rec._color = KsPlot::Color(255, 0, 0);
+	line._color = KsPlot::Color(0, 255, 0);
+	line._size = 3;
+	p._color = KsPlot::Color(0, 0, 255);
+	p._size = 5;
+
+	ksplot_batch_init(&batch);
+	ksplot_batch_begin(&batch);
+	rec.draw();
+	line.draw();
+	p.draw();
+	BOOST_REQUIRE(ksplot_batch_end());
+
+	{
+		QOpenGLFramebufferObject fbo(BATCH_IMG_SIZE, BATCH_IMG_SIZE);
+
+		BOOST_REQUIRE(fbo.bind());
+		ksplot_init_opengl(1);
+		ksplot_resize_opengl(BATCH_IMG_SIZE, BATCH_IMG_SIZE);
+
+		/* The second frame draws the vertex buffer, uploaded already. */
+		for (int frame = 0; frame < 2; ++frame) {
+			glClear(GL_COLOR_BUFFER_BIT);
+			ksplot_batch_draw(&batch);
+			img = fbo.toImage();
+
+			BOOST_CHECK_EQUAL(img.pixel(20, 12), qRgb(255, 0, 0));
+			BOOST_CHECK_EQUAL(img.pixel(50, 10), qRgb(0, 255, 0));
+			BOOST_CHECK_EQUAL(img.pixel(50, 50), qRgb(0, 0, 255));
+			BOOST_CHECK_EQUAL(img.pixel(2, 60), qRgb(255, 255, 255));
+			BOOST_CHECK(batch.uploaded);
+		}
+
+		BOOST_CHECK(glGetError() == GL_NO_ERROR);
+		ksplot_batch_free(&batch);
+	}
+
+	context.doneCurrent();
+}
+// END of change
@@ -4,13 +4,39 @@
  * Copyright (C) 2020 VMware Inc, Yordan Karadzhov (VMware) <y.karadz@gmail.com>
  */
 
+//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+// C++
+#include <atomic>
+#include <thread>
+// END of change
+//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+#include <unordered_map>
+
+// C
+#include <unistd.h>
+// END of change
+
 // Boost
 #define BOOST_TEST_MODULE KernelSharkTests
 #include <boost/test/unit_test.hpp>
 
+//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+// libtraceevent
+#include <traceevent/event-parse.h>
+// END of change
+
 // KernelShark
 #include "libkshark.h"
 #include "libkshark-plugin.h"
+#include "libkshark-model.h"
+#include "libkshark-compact.h"
+#include "libkshark-couplebreak.h"
+//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+#include "libkshark-postings.h"
+// END of change
+//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+#include "libkshark-tepdata.h"
+// END of change
 #include "KsCmakeDef.hpp"
 
 #define N_TEST_STREAMS	1000
@@ -143,6 +169,1164 @@ BOOST_AUTO_TEST_CASE(fill_data_container)
 	kshark_free_data_container(data);
 }
 
+//NOTE: Changed here. (ENTRY ARENA) (2026-10-17)
+#define N_ARENA_ENTRIES	100000
+BOOST_AUTO_TEST_CASE(mem_arena)
+{
+	struct kshark_mem_arena *arena = kshark_arena_alloc(4096);
+	struct kshark_mem_arena *other = kshark_arena_alloc(0);
+	struct kshark_entry *entries[N_ARENA_ENTRIES];
+	size_t n_bytes;
+	int i;
+
+	BOOST_REQUIRE(arena && other);
+	BOOST_CHECK_EQUAL(other->chunk_size, KS_ARENA_CHUNK_SIZE);
+
+	for (i = 0; i < N_ARENA_ENTRIES; ++i) {
+		struct kshark_mem_arena *a = (i % 2) ? arena : other;
+
+		entries[i] = (struct kshark_entry *)
+			kshark_arena_malloc(a, sizeof(*entries[i]));
+		BOOST_REQUIRE(entries[i]);
+		BOOST_CHECK_EQUAL((uintptr_t) entries[i] % alignof(max_align_t), 0);
+		BOOST_CHECK_EQUAL(entries[i]->ts, 0);
+		entries[i]->ts = i;
+	}
+
+	/* Objects bigger than a chunk get a chunk of their own. */
+	BOOST_CHECK(kshark_arena_malloc(arena, 3 * arena->chunk_size));
+
+	n_bytes = arena->n_bytes + other->n_bytes;
+	kshark_arena_merge(arena, other);
+	BOOST_CHECK_EQUAL(arena->n_bytes, n_bytes);
+	BOOST_CHECK_EQUAL(other->n_bytes, 0);
+	BOOST_CHECK(!other->chunks);
+
+	for (i = 0; i < N_ARENA_ENTRIES; ++i)
+		BOOST_CHECK_EQUAL(entries[i]->ts, i);
+
+	kshark_arena_clear(arena);
+	BOOST_CHECK_EQUAL(arena->n_bytes, 0);
+	BOOST_CHECK(kshark_arena_malloc(arena, 1));
+
+	kshark_arena_free(other);
+	kshark_arena_free(arena);
+}
+// END of change
+
+//NOTE: Changed here. (EVENT DISPATCH) (2026-10-17)
+static void dispatch_func_a(kshark_data_stream *, void *, kshark_entry *) {}
+static void dispatch_func_b(kshark_data_stream *, void *, kshark_entry *) {}
+
+BOOST_AUTO_TEST_CASE(event_dispatch)
+{
+	kshark_context *kshark_ctx(nullptr);
+	kshark_event_proc_handler **handlers;
+	kshark_data_stream *stream;
+	int sd, n;
+
+	BOOST_REQUIRE(kshark_instance(&kshark_ctx));
+	sd = kshark_add_stream(kshark_ctx);
+	stream = kshark_ctx->stream[sd];
+	BOOST_CHECK(!stream->event_dispatch);
+
+	kshark_register_event_handler(stream, 7, dispatch_func_a);
+	kshark_register_event_handler(stream, -10000, dispatch_func_a);
+	kshark_register_event_handler(stream, 7, dispatch_func_b);
+	BOOST_REQUIRE(stream->event_dispatch);
+
+	/* Handlers of the same event keep the order of the list. */
+	handlers = kshark_dispatch_event(stream->event_dispatch, 7, &n);
+	BOOST_REQUIRE_EQUAL(n, 2);
+	BOOST_CHECK(handlers[0]->event_func == dispatch_func_b);
+	BOOST_CHECK(handlers[1]->event_func == dispatch_func_a);
+
+	kshark_dispatch_event(stream->event_dispatch, -10000, &n);
+	BOOST_CHECK_EQUAL(n, 1);
+
+	kshark_dispatch_event(stream->event_dispatch, 0, &n);
+	BOOST_CHECK_EQUAL(n, 0);
+
+	kshark_dispatch_event(stream->event_dispatch, 8, &n);
+	BOOST_CHECK_EQUAL(n, 0);
+
+	kshark_unregister_event_handler(stream, 7, dispatch_func_b);
+	handlers = kshark_dispatch_event(stream->event_dispatch, 7, &n);
+	BOOST_REQUIRE_EQUAL(n, 1);
+	BOOST_CHECK(handlers[0]->event_func == dispatch_func_a);
+
+	kshark_unregister_event_handler(stream, 7, dispatch_func_a);
+	kshark_unregister_event_handler(stream, -10000, dispatch_func_a);
+	BOOST_CHECK(!stream->event_dispatch);
+
+	/* Handlers, left registered, are freed together with the stream. */
+	kshark_register_event_handler(stream, 7, dispatch_func_a);
+	BOOST_CHECK(stream->event_dispatch);
+
+	kshark_free(kshark_ctx);
+}
+// END of change
+
+//NOTE: Changed here. (CONCURRENT STREAMS) (2026-10-17)
+static std::atomic<int> n_running_actions;
+static std::atomic<bool> actions_overlap;
+
+static void counting_action(kshark_data_stream *, void *, kshark_entry *entry)
+{
+	if (n_running_actions.fetch_add(1) != 0)
+		actions_overlap = true;
+
+	/* Give the other threads a chance to run an action meanwhile. */
+	for (volatile int i = 0; i < 100; ++i);
+
+	++entry->pid;
+	n_running_actions.fetch_sub(1);
+}
+
+#define N_ACTION_THREADS	4
+#define N_ACTIONS		10000
+
+BOOST_AUTO_TEST_CASE(serial_plugin_actions)
+{
+	kshark_context *kshark_ctx(nullptr);
+	std::vector<std::thread> threads;
+	kshark_entry entry = {};
+	int sd[2], i;
+
+	BOOST_REQUIRE(kshark_instance(&kshark_ctx));
+	for (i = 0; i < 2; ++i) {
+		sd[i] = kshark_add_stream(kshark_ctx);
+		kshark_register_event_handler(kshark_ctx->stream[sd[i]], 7,
+					      counting_action);
+	}
+
+	/* The actions of different streams never run at the same time. */
+	entry.event_id = 7;
+	for (i = 0; i < N_ACTION_THREADS; ++i)
+		threads.emplace_back([&, i] () {
+			kshark_data_stream *stream =
+				kshark_ctx->stream[sd[i % 2]];
+
+			for (int j = 0; j < N_ACTIONS; ++j)
+				kshark_plugin_actions(stream, nullptr, &entry);
+		});
+
+	for (auto &t: threads)
+		t.join();
+
+	BOOST_CHECK(!actions_overlap);
+	BOOST_CHECK_EQUAL(entry.pid, N_ACTION_THREADS * N_ACTIONS);
+
+	kshark_free(kshark_ctx);
+}
+// END of change
+
+//NOTE: Changed here. (ENTRY COLUMNS) (2026-10-17)
+#define N_COLUMN_ENTRIES	1000
+BOOST_AUTO_TEST_CASE(entry_columns)
+{
+	struct kshark_entry entries[N_COLUMN_ENTRIES] = {};
+	struct kshark_entry *rows[N_COLUMN_ENTRIES];
+	struct kshark_trace_histo histo, histo_col;
+	struct kshark_entry_columns columns = {};
+	int i;
+
+	for (i = 0; i < N_COLUMN_ENTRIES; ++i) {
+		entries[i].ts = 10 * (i / 3);
+		entries[i].pid = i % 7;
+		entries[i].cpu = i % 4;
+		entries[i].visible = 0xFF;
+		rows[i] = &entries[i];
+	}
+
+	BOOST_REQUIRE(kshark_entry_columns_fill(&columns, rows,
+						N_COLUMN_ENTRIES));
+	BOOST_CHECK_EQUAL(columns.size, N_COLUMN_ENTRIES);
+	for (i = 0; i < N_COLUMN_ENTRIES; ++i) {
+		BOOST_CHECK_EQUAL(columns.ts[i], entries[i].ts);
+		BOOST_CHECK_EQUAL(columns.pid[i], entries[i].pid);
+		BOOST_CHECK_EQUAL(columns.cpu[i], entries[i].cpu);
+	}
+
+	for (i = -5; i < 10 * N_COLUMN_ENTRIES / 3 + 5; ++i)
+		BOOST_CHECK_EQUAL(kshark_find_ts_by_time(i, columns.ts, 0,
+							 N_COLUMN_ENTRIES - 1),
+				  kshark_find_entry_by_time(i, rows, 0,
+							    N_COLUMN_ENTRIES - 1));
+
+	ksmodel_init(&histo);
+	ksmodel_init(&histo_col);
+	ksmodel_set_bining(&histo, 100, 500, 2000);
+	ksmodel_set_bining(&histo_col, 100, 500, 2000);
+	ksmodel_fill(&histo, rows, N_COLUMN_ENTRIES);
+	ksmodel_fill_columns(&histo_col, rows, &columns);
+	BOOST_CHECK(histo_col.columns == &columns);
+
+	ksmodel_zoom_in(&histo, .5, 30);
+	ksmodel_zoom_in(&histo_col, .5, 30);
+	BOOST_CHECK(histo_col.columns == &columns);
+	BOOST_CHECK_EQUAL(histo.tot_count, histo_col.tot_count);
+	for (i = 0; i < histo.n_bins + 2; ++i) {
+		BOOST_CHECK_EQUAL(histo.map[i], histo_col.map[i]);
+		BOOST_CHECK_EQUAL(histo.bin_count[i], histo_col.bin_count[i]);
+	}
+
+	for (i = 0; i < histo.n_bins; ++i) {
+		BOOST_CHECK_EQUAL(ksmodel_first_index_at_cpu(&histo, i, 0, 3),
+				  ksmodel_first_index_at_cpu(&histo_col, i, 0, 3));
+		BOOST_CHECK_EQUAL(ksmodel_first_index_at_pid(&histo, i, 0, 5),
+				  ksmodel_first_index_at_pid(&histo_col, i, 0, 5));
+	}
+
+	ksmodel_clear(&histo);
+	ksmodel_clear(&histo_col);
+	kshark_entry_columns_free(&columns);
+	BOOST_CHECK(!columns.ts && !columns.size);
+}
+// END of change
+
+//NOTE: Changed here. (COMPACT ENTRY) (2026-10-17)
+#define N_COMPACT_ENTRIES	10000
+BOOST_AUTO_TEST_CASE(compact_entries)
+{
+	static struct kshark_entry entries[N_COMPACT_ENTRIES];
+	struct kshark_entry *rows[N_COMPACT_ENTRIES], **view;
+	struct kshark_compact_data data;
+	int64_t ts = 1000;
+	ssize_t next;
+	int i;
+
+	for (i = 0; i < N_COMPACT_ENTRIES; ++i) {
+		/* One gap, too long to fit into a timestamp delta. */
+		ts += (i == N_COMPACT_ENTRIES / 2) ? 10000000000LL : 7;
+		entries[i].ts = ts;
+		entries[i].cpu = i % 3;
+		entries[i].pid = i;
+		entries[i].visible = 0xFF;
+		entries[i].offset = (i == 77) ? (1LL << 36) : i * 100;
+		rows[i] = &entries[i];
+	}
+
+	entries[11].event_id = COUPLEBREAK_SST_ID;
+	entries[11].ts = entries[10].ts;
+	entries[11].offset = (int64_t) &entries[10];
+
+	kshark_compact_init(&data);
+	BOOST_REQUIRE_EQUAL(kshark_compact_append(&data, rows, 6000), 0);
+	BOOST_REQUIRE_EQUAL(kshark_compact_append(&data, rows + 6000,
+						  N_COMPACT_ENTRIES - 6000), 0);
+	BOOST_CHECK_EQUAL(data.size, N_COMPACT_ENTRIES);
+	BOOST_CHECK(data.n_ts_overflow > 0);
+
+	for (i = 0; i < N_COMPACT_ENTRIES; ++i) {
+		BOOST_CHECK_EQUAL(kshark_compact_ts(&data, i), entries[i].ts);
+
+		next = (i + 3 < N_COMPACT_ENTRIES) ? i + 3 : -1;
+		BOOST_CHECK_EQUAL(kshark_compact_next(&data, i), next);
+
+		if (i != 11)
+			BOOST_CHECK_EQUAL(kshark_compact_offset(&data, i),
+					  entries[i].offset);
+	}
+
+	BOOST_CHECK_EQUAL(kshark_compact_origin(&data, 11), 10);
+	BOOST_CHECK_EQUAL(kshark_compact_offset(&data, 11), entries[10].offset);
+
+	/* The origin of the first entry is outside of the range. */
+	BOOST_REQUIRE_EQUAL(kshark_compact_materialize(&data, 11, 5, &view), 5);
+	BOOST_CHECK_EQUAL(((kshark_entry *) view[0]->offset)->pid, 10);
+	BOOST_CHECK(view[0]->next == view[3]);
+	BOOST_CHECK(!view[4]->next);
+	kshark_compact_free_rows(view);
+
+	/* Offsets bigger than 40 bits are not supported. */
+	entries[5].offset = 1LL << 41;
+	BOOST_CHECK_EQUAL(kshark_compact_append(&data, rows, 10), -EOVERFLOW);
+	BOOST_CHECK_EQUAL(data.size, N_COMPACT_ENTRIES);
+
+	kshark_compact_free(&data);
+}
+
+#define N_COMPACT_LIST_ENTRIES	4000
+#define N_COMPACT_LIST_CPUS	4
+BOOST_AUTO_TEST_CASE(compact_entry_lists)
+{
+	static struct kshark_entry entries[N_COMPACT_LIST_ENTRIES];
+	struct kshark_entry *rows[N_COMPACT_LIST_ENTRIES], **view;
+	struct kshark_entry *tails[N_COMPACT_LIST_CPUS] = {};
+	struct kshark_compact_data data;
+	ssize_t next;
+	int i, cpu;
+
+	/*
+	 * Every tenth entry is a couplebreak wakeup. Its CPU is the CPU of
+	 * the wakee, but it stays in the list of the waker CPU, right after
+	 * its origin.
+	 */
+	for (i = 0; i < N_COMPACT_LIST_ENTRIES; ++i) {
+		if (i % 10 == 1) {
+			cpu = entries[i - 1].cpu;
+			entries[i].event_id = COUPLEBREAK_SWT_ID;
+			entries[i].ts = entries[i - 1].ts;
+			entries[i].cpu = (cpu + 1) % N_COMPACT_LIST_CPUS;
+			entries[i].offset = (int64_t) &entries[i - 1];
+		} else {
+			cpu = i % N_COMPACT_LIST_CPUS;
+			entries[i].ts = 1000 + 5 * i;
+			entries[i].cpu = cpu;
+			entries[i].offset = i * 100;
+		}
+
+		entries[i].pid = i;
+		entries[i].visible = 0xFF;
+		if (tails[cpu])
+			tails[cpu]->next = &entries[i];
+
+		tails[cpu] = &entries[i];
+		rows[i] = &entries[i];
+	}
+
+	/* The first batch has links to the entries of the second one. */
+	kshark_compact_init(&data);
+	BOOST_REQUIRE_EQUAL(kshark_compact_append(&data, rows, 1234), 0);
+	BOOST_REQUIRE_EQUAL(kshark_compact_append(&data, rows + 1234,
+						  N_COMPACT_LIST_ENTRIES - 1234),
+			    0);
+
+	for (i = 0; i < N_COMPACT_LIST_ENTRIES; ++i) {
+		next = entries[i].next ? entries[i].next - entries : -1;
+		BOOST_CHECK_EQUAL(kshark_compact_next(&data, i), next);
+
+		if (i % 10 == 1)
+			BOOST_CHECK_EQUAL(kshark_compact_origin(&data, i),
+					  i - 1);
+	}
+
+	BOOST_REQUIRE_EQUAL(kshark_compact_materialize(&data, 1200, 100,
+						       &view), 100);
+	for (i = 0; i < 100; ++i) {
+		next = entries[1200 + i].next ?
+		       entries[1200 + i].next - entries - 1200 : -1;
+		if (next >= 100)
+			next = -1;
+
+		BOOST_CHECK(view[i]->next == ((next < 0) ? nullptr : view[next]));
+		BOOST_CHECK_EQUAL(view[i]->cpu, entries[1200 + i].cpu);
+	}
+
+	kshark_compact_free_rows(view);
+	kshark_compact_free(&data);
+}
+// END of change
+
+//NOTE: Changed here. (LOAD OPTIONS) (2026-10-17)
+BOOST_AUTO_TEST_CASE(parse_seconds)
+{
+	int64_t ns = 0;
+
+	BOOST_CHECK_EQUAL(kshark_parse_seconds("12", &ns), 0);
+	BOOST_CHECK_EQUAL(ns, 12000000000LL);
+
+	/* Exact to the nanosecond. */
+	BOOST_CHECK_EQUAL(kshark_parse_seconds("4503599.627370497", &ns), 0);
+	BOOST_CHECK_EQUAL(ns, 4503599627370497LL);
+
+	BOOST_CHECK_EQUAL(kshark_parse_seconds(".5", &ns), 0);
+	BOOST_CHECK_EQUAL(ns, 500000000LL);
+
+	/* Further digits are rounded. */
+	BOOST_CHECK_EQUAL(kshark_parse_seconds("0.0000000015", &ns), 0);
+	BOOST_CHECK_EQUAL(ns, 2);
+	BOOST_CHECK_EQUAL(kshark_parse_seconds("-1.0000000014", &ns), 0);
+	BOOST_CHECK_EQUAL(ns, -1000000001LL);
+
+	BOOST_CHECK_EQUAL(kshark_parse_seconds("", &ns), -EINVAL);
+	BOOST_CHECK_EQUAL(kshark_parse_seconds(".", &ns), -EINVAL);
+	BOOST_CHECK_EQUAL(kshark_parse_seconds("1.5s", &ns), -EINVAL);
+	BOOST_CHECK_EQUAL(kshark_parse_seconds("1e9", &ns), -EINVAL);
+	BOOST_CHECK_EQUAL(kshark_parse_seconds("10000000000", &ns), -EINVAL);
+}
+// END of change
+
+//NOTE: Changed here. (ID SETS) (2026-10-17)
+BOOST_AUTO_TEST_CASE(id_sets)
+{
+	struct kshark_hash_id *hash = kshark_hash_id_alloc(KS_FILTER_HASH_NBITS);
+	struct kshark_id_set set = {};
+	unsigned int version;
+	int id;
+
+	/* Dense Ids, including negative ones, make a bitmap. */
+	for (id = -5; id < 300; id += 3)
+		kshark_hash_id_add(hash, id);
+
+	BOOST_REQUIRE_EQUAL(kshark_id_set_build(&set, hash), 0);
+	BOOST_CHECK(set.bits);
+	BOOST_CHECK_EQUAL(set.count, hash->count);
+	for (id = -100; id < 400; ++id)
+		BOOST_CHECK_EQUAL(kshark_id_set_find(&set, id),
+				  kshark_hash_id_find(hash, id));
+
+	/* Sparse Ids make an open addressing table. */
+	version = hash->version;
+	kshark_hash_id_add(hash, 4000000);
+	kshark_hash_id_add(hash, INT32_MAX);
+	BOOST_CHECK(hash->version != version);
+
+	BOOST_REQUIRE_EQUAL(kshark_id_set_build(&set, hash), 0);
+	BOOST_CHECK(!set.bits && set.slots);
+	for (id = -100; id < 400; ++id)
+		BOOST_CHECK_EQUAL(kshark_id_set_find(&set, id),
+				  kshark_hash_id_find(hash, id));
+
+	BOOST_CHECK(kshark_id_set_find(&set, 4000000));
+	BOOST_CHECK(kshark_id_set_find(&set, INT32_MAX));
+	BOOST_CHECK(!kshark_id_set_find(&set, INT32_MIN));
+
+	/* An empty hash makes an empty set. */
+	kshark_hash_id_clear(hash);
+	BOOST_REQUIRE_EQUAL(kshark_id_set_build(&set, hash), 0);
+	BOOST_CHECK(!set.count && !kshark_id_set_find(&set, 1));
+
+	kshark_id_set_free(&set);
+	kshark_hash_id_free(hash);
+}
+// END of change
+
+//NOTE: Changed here. (PARALLEL FILTER) (2026-10-17)
+#define N_FILTER_ENTRIES	(4 * KS_FILTER_CHUNK_SIZE + 123)
+BOOST_AUTO_TEST_CASE(filter_threads)
+{
+	std::vector<kshark_entry> entries(N_FILTER_ENTRIES);
+	std::vector<kshark_entry *> rows(N_FILTER_ENTRIES);
+	std::vector<uint16_t> visible(N_FILTER_ENTRIES);
+	struct kshark_entry_columns columns = {};
+	kshark_context *kshark_ctx(nullptr);
+	int i, sd;
+
+	BOOST_REQUIRE(kshark_instance(&kshark_ctx));
+	sd = kshark_add_stream(kshark_ctx);
+	kshark_ctx->stream[sd]->interface = malloc(1);
+	kshark_ctx->filter_mask = KS_TEXT_VIEW_FILTER_MASK |
+				  KS_GRAPH_VIEW_FILTER_MASK |
+				  KS_EVENT_VIEW_FILTER_MASK;
+
+	for (i = 0; i < N_FILTER_ENTRIES; ++i) {
+		entries[i].stream_id = sd;
+		entries[i].cpu = i % 8;
+		entries[i].pid = (i % 3) ? i % 1000 : i;
+		entries[i].event_id = i % 50;
+		entries[i].visible = 0xFF;
+		rows[i] = &entries[i];
+	}
+
+	for (i = 0; i < 50; i += 3)
+		kshark_filter_add_id(kshark_ctx, sd, KS_SHOW_EVENT_FILTER, i);
+
+	kshark_filter_add_id(kshark_ctx, sd, KS_HIDE_CPU_FILTER, 5);
+	kshark_filter_add_id(kshark_ctx, sd, KS_HIDE_TASK_FILTER, 7);
+	kshark_filter_add_id(kshark_ctx, sd, KS_HIDE_TASK_FILTER, 300000);
+
+	/* Sequential filtering gives the reference result. */
+	kshark_set_filter_threads(kshark_ctx, 1);
+	kshark_filter_stream_entries(kshark_ctx, sd, rows.data(),
+				     N_FILTER_ENTRIES);
+	for (i = 0; i < N_FILTER_ENTRIES; ++i)
+		visible[i] = entries[i].visible;
+
+	BOOST_CHECK(!(visible[5] & KS_GRAPH_VIEW_FILTER_MASK));
+	BOOST_CHECK(!(visible[300000] & KS_TEXT_VIEW_FILTER_MASK));
+	BOOST_CHECK(visible[0] == 0xFF);
+
+	BOOST_REQUIRE(kshark_entry_columns_fill(&columns, rows.data(),
+						N_FILTER_ENTRIES));
+
+	kshark_set_filter_threads(kshark_ctx, 4);
+	for (auto columns_ptr: {(kshark_entry_columns *) nullptr, &columns}) {
+		for (i = 0; i < N_FILTER_ENTRIES; ++i)
+			entries[i].visible = 0xFF;
+
+		kshark_filter_column_entries(kshark_ctx, sd, rows.data(),
+					     columns_ptr, N_FILTER_ENTRIES);
+		for (i = 0; i < N_FILTER_ENTRIES; ++i)
+			BOOST_REQUIRE_EQUAL(entries[i].visible, visible[i]);
+	}
+
+	kshark_entry_columns_free(&columns);
+	kshark_free(kshark_ctx);
+}
+// END of change
+
+//NOTE: Changed here. (POSTING LISTS) (2026-10-17)
+#define N_POSTING_ENTRIES	100000
+BOOST_AUTO_TEST_CASE(posting_lists)
+{
+	std::vector<kshark_entry> entries(N_POSTING_ENTRIES);
+	std::vector<kshark_entry *> rows(N_POSTING_ENTRIES);
+	std::vector<uint16_t> visible(N_POSTING_ENTRIES);
+	struct kshark_entry_postings postings;
+	kshark_context *kshark_ctx(nullptr);
+	struct kshark_hash_id *cpus;
+	const uint32_t *list;
+	size_t n, count;
+	int i, sd;
+
+	BOOST_REQUIRE(kshark_instance(&kshark_ctx));
+	sd = kshark_add_stream(kshark_ctx);
+	kshark_ctx->stream[sd]->interface = malloc(1);
+	kshark_ctx->filter_mask = KS_TEXT_VIEW_FILTER_MASK |
+				  KS_GRAPH_VIEW_FILTER_MASK |
+				  KS_EVENT_VIEW_FILTER_MASK;
+
+	for (i = 0; i < N_POSTING_ENTRIES; ++i) {
+		entries[i].stream_id = sd;
+		entries[i].cpu = (i * 7) % 16;
+		entries[i].pid = (i * 13) % 2000;
+		entries[i].event_id = i % 40;
+		entries[i].visible = 0xFF;
+		rows[i] = &entries[i];
+	}
+
+	kshark_postings_init(&postings);
+	BOOST_REQUIRE_EQUAL(kshark_postings_build(kshark_ctx, &postings,
+						  rows.data(),
+						  N_POSTING_ENTRIES), 0);
+
+	list = kshark_posting_list(&postings, KS_POSTING_CPU, sd, 5, &n);
+	for (count = 0, i = 0; i < N_POSTING_ENTRIES; ++i)
+		count += (entries[i].cpu == 5);
+
+	BOOST_REQUIRE_EQUAL(n, count);
+	for (size_t j = 1; j < n; ++j)
+		BOOST_CHECK(list[j] > list[j - 1]);
+
+	BOOST_CHECK(!kshark_posting_list(&postings, KS_POSTING_TASK,
+					 sd, 5000, &n));
+
+	/* The incremental refilter must match a full pass. */
+	auto check = [&] (int expected) {
+		int ret;
+
+		cpus = kshark_hash_id_alloc(KS_FILTER_HASH_NBITS);
+		for (i = 0; i < N_POSTING_ENTRIES; ++i)
+			visible[i] = entries[i].visible;
+
+		ret = kshark_postings_filter(kshark_ctx, sd, &postings, cpus);
+		BOOST_CHECK_EQUAL(ret, expected);
+		if (ret == -EAGAIN) {
+			kshark_filter_stream_entries(kshark_ctx, sd,
+						     rows.data(),
+						     N_POSTING_ENTRIES);
+			kshark_postings_sync(kshark_ctx, sd, &postings);
+		}
+
+		for (i = 0; i < N_POSTING_ENTRIES; ++i) {
+			uint16_t incremental = entries[i].visible;
+
+			if (ret == 0 &&
+			    ((incremental ^ visible[i]) &
+			     KS_GRAPH_VIEW_FILTER_MASK))
+				BOOST_CHECK(kshark_hash_id_find(cpus,
+								entries[i].cpu));
+
+			visible[i] = incremental;
+		}
+
+		kshark_filter_stream_entries(kshark_ctx, sd, rows.data(),
+					     N_POSTING_ENTRIES);
+		for (i = 0; i < N_POSTING_ENTRIES; ++i)
+			BOOST_REQUIRE_EQUAL(entries[i].visible, visible[i]);
+
+		kshark_hash_id_free(cpus);
+	};
+
+	kshark_filter_add_id(kshark_ctx, sd, KS_HIDE_TASK_FILTER, 7);
+	check(0);
+
+	kshark_filter_add_id(kshark_ctx, sd, KS_HIDE_TASK_FILTER, 8);
+	kshark_filter_add_id(kshark_ctx, sd, KS_HIDE_EVENT_FILTER, 3);
+	check(0);
+
+	kshark_filter_clear(kshark_ctx, sd, KS_HIDE_TASK_FILTER);
+	kshark_filter_add_id(kshark_ctx, sd, KS_HIDE_TASK_FILTER, 8);
+	check(0);
+
+	/* Setting a show filter requires a full pass. */
+	kshark_filter_add_id(kshark_ctx, sd, KS_SHOW_CPU_FILTER, 3);
+	check(-EAGAIN);
+
+	kshark_filter_add_id(kshark_ctx, sd, KS_SHOW_CPU_FILTER, 4);
+	check(0);
+
+	/* Freed posting lists always require a full pass. */
+	kshark_postings_free(&postings);
+	kshark_postings_sync(kshark_ctx, sd, &postings);
+	kshark_filter_add_id(kshark_ctx, sd, KS_SHOW_CPU_FILTER, 5);
+	check(-EAGAIN);
+
+	kshark_postings_free(&postings);
+	kshark_free(kshark_ctx);
+}
+// END of change
+
+//NOTE: Changed here. (CPU COLLECTIONS) (2026-10-17)
+#define N_COLLECTION_ENTRIES	(2 * KS_FILTER_CHUNK_SIZE + 17)
+#define N_COLLECTION_CPUS	8
+
+static bool
+match_cpu_visible([[maybe_unused]] struct kshark_context *kshark_ctx,
+		  struct kshark_entry *e, int sd, int *cpu)
+{
+	return e->cpu == *cpu && e->stream_id == sd &&
+	       (e->visible & KS_GRAPH_VIEW_FILTER_MASK);
+}
+
+/*
+ * Check that a single sweep, and a pass over the rows of each CPU, define the
+ * same intervals as the per-CPU code.
+ */
+static void check_cpu_collections(kshark_context *kshark_ctx,
+				  std::vector<kshark_entry *> &rows,
+				  int n_cpus)
+{
+	struct kshark_entry_collection *single = nullptr, *sweep = nullptr;
+	struct kshark_entry_collection *indexed = nullptr;
+	struct kshark_entry_collection *a, *b, *c;
+	std::vector<int> cpus(n_cpus);
+	int cpu;
+
+	for (cpu = 0; cpu < n_cpus; ++cpu) {
+		std::vector<uint32_t> cpuRows;
+
+		for (size_t i = 0; i < rows.size(); ++i)
+			if (rows[i]->cpu == cpu)
+				cpuRows.push_back(i);
+
+		cpus[cpu] = cpu;
+		kshark_add_collection_to_list(kshark_ctx, &single,
+					      rows.data(), rows.size(),
+					      match_cpu_visible, 0, &cpu, 1, 0);
+
+		BOOST_REQUIRE(kshark_add_indexed_collection_to_list(kshark_ctx,
+								    &indexed,
+								    rows.data(),
+								    rows.size(),
+								    cpuRows.data(),
+								    cpuRows.size(),
+								    match_cpu_visible,
+								    0, &cpu, 1));
+	}
+
+	BOOST_REQUIRE_EQUAL(kshark_add_cpu_collections_to_list(kshark_ctx,
+							       &sweep,
+							       rows.data(),
+							       rows.size(),
+							       match_cpu_visible,
+							       0, cpus.data(),
+							       n_cpus), 0);
+
+	for (cpu = 0; cpu < n_cpus; ++cpu) {
+		a = kshark_find_data_collection(single, match_cpu_visible,
+						0, &cpu, 1);
+		b = kshark_find_data_collection(sweep, match_cpu_visible,
+						0, &cpu, 1);
+		c = kshark_find_data_collection(indexed, match_cpu_visible,
+						0, &cpu, 1);
+		BOOST_REQUIRE(a && b && c);
+		BOOST_REQUIRE_EQUAL(a->size, b->size);
+		BOOST_REQUIRE_EQUAL(a->size, c->size);
+		BOOST_CHECK(b->size > 0);
+		for (size_t j = 0; j < a->size; ++j) {
+			BOOST_CHECK_EQUAL(a->resume_points[j],
+					  b->resume_points[j]);
+			BOOST_CHECK_EQUAL(a->break_points[j],
+					  b->break_points[j]);
+			BOOST_CHECK_EQUAL(a->resume_points[j],
+					  c->resume_points[j]);
+			BOOST_CHECK_EQUAL(a->break_points[j],
+					  c->break_points[j]);
+		}
+	}
+
+	kshark_free_collection_list(single);
+	kshark_free_collection_list(sweep);
+	kshark_free_collection_list(indexed);
+}
+
+BOOST_AUTO_TEST_CASE(cpu_collections)
+{
+	std::vector<kshark_entry> entries(N_COLLECTION_ENTRIES);
+	std::vector<kshark_entry *> rows(N_COLLECTION_ENTRIES);
+	struct kshark_entry *last[N_COLLECTION_CPUS] = {};
+	kshark_context *kshark_ctx(nullptr);
+	int i;
+
+	BOOST_REQUIRE(kshark_instance(&kshark_ctx));
+
+	for (i = 0; i < N_COLLECTION_ENTRIES; ++i) {
+		entries[i].stream_id = 0;
+		entries[i].ts = i / 3;
+		entries[i].cpu = (i * 7 + i / 5) % N_COLLECTION_CPUS;
+		entries[i].visible = (i % 13 < 4 || i % 101 == 0) ? 0 : 0xFF;
+		rows[i] = &entries[i];
+
+		if (last[entries[i].cpu])
+			last[entries[i].cpu]->next = &entries[i];
+
+		last[entries[i].cpu] = &entries[i];
+	}
+
+	kshark_set_filter_threads(kshark_ctx, 4);
+	check_cpu_collections(kshark_ctx, rows, N_COLLECTION_CPUS);
+
+	kshark_free(kshark_ctx);
+}
+
+BOOST_AUTO_TEST_CASE(cpu_collections_cross_cpu)
+{
+	std::vector<kshark_entry> entries(N_COLLECTION_ENTRIES);
+	std::vector<kshark_entry *> rows(N_COLLECTION_ENTRIES);
+	struct kshark_entry *last[N_COLLECTION_CPUS] = {};
+	kshark_context *kshark_ctx(nullptr);
+	int i, cpu;
+
+	BOOST_REQUIRE(kshark_instance(&kshark_ctx));
+
+	/*
+	 * Like the entries added by Couplebreak, every 9th entry has the CPU
+	 * of another task, but it is linked in the chain of "next" entries of
+	 * the CPU of the previous entry. Hence the "next" entry of some
+	 * collections is on another CPU, possibly one with no collection.
+	 */
+	for (i = 0; i < N_COLLECTION_ENTRIES; ++i) {
+		cpu = (i * 7 + i / 5) % N_COLLECTION_CPUS;
+		entries[i].stream_id = 0;
+		entries[i].ts = i / 3;
+		entries[i].cpu = (i % 9 == 8) ? (cpu + 3) % N_COLLECTION_CPUS :
+						cpu;
+		entries[i].visible = (i % 13 < 4 || i % 101 == 0) ? 0 : 0xFF;
+		rows[i] = &entries[i];
+
+		if (last[cpu])
+			last[cpu]->next = &entries[i];
+
+		last[cpu] = &entries[i];
+	}
+
+	kshark_set_filter_threads(kshark_ctx, 4);
+	check_cpu_collections(kshark_ctx, rows, N_COLLECTION_CPUS);
+	check_cpu_collections(kshark_ctx, rows, N_COLLECTION_CPUS - 2);
+
+	kshark_free(kshark_ctx);
+}
+// END of change
+
+//NOTE: Changed here. (TIME GRID) (2026-10-17)
+#define N_GRID_ENTRIES	50000
+BOOST_AUTO_TEST_CASE(ts_grid)
+{
+	std::vector<kshark_entry> entries(N_GRID_ENTRIES);
+	std::vector<kshark_entry *> rows(N_GRID_ENTRIES);
+	struct kshark_trace_histo histo, histo_col;
+	struct kshark_entry_columns columns = {};
+	int64_t ts = 1000, last;
+	int i, j;
+
+	/* Bursts of entries with equal timestamps, separated by long gaps. */
+	for (i = 0; i < N_GRID_ENTRIES; ++i) {
+		if (i % 5 == 0)
+			ts += (i % 1000 == 0) ? 1000000 : 37;
+
+		entries[i].ts = ts;
+		entries[i].visible = 0xFF;
+		rows[i] = &entries[i];
+	}
+
+	BOOST_REQUIRE(kshark_entry_columns_fill(&columns, rows.data(),
+						N_GRID_ENTRIES));
+	BOOST_REQUIRE(columns.grid.rows);
+	BOOST_CHECK(columns.grid.n_cells * KS_TS_GRID_DENSITY / 2 <=
+		    N_GRID_ENTRIES);
+
+	last = entries[N_GRID_ENTRIES - 1].ts;
+	for (i = 0; i < 20000; ++i) {
+		ts = 990 + (last - 980) * i / 20000 + i % 40;
+		j = (i * 7919) % N_GRID_ENTRIES;
+		BOOST_CHECK_EQUAL(kshark_find_ts_by_grid(ts, columns.ts,
+							 &columns.grid, j,
+							 N_GRID_ENTRIES - 1),
+				  kshark_find_ts_by_time(ts, columns.ts, j,
+							 N_GRID_ENTRIES - 1));
+	}
+
+	ksmodel_init(&histo);
+	ksmodel_init(&histo_col);
+	ksmodel_set_bining(&histo, 2000, 1000, last);
+	ksmodel_set_bining(&histo_col, 2000, 1000, last);
+	ksmodel_fill(&histo, rows.data(), N_GRID_ENTRIES);
+	ksmodel_fill_columns(&histo_col, rows.data(), &columns);
+
+	for (j = 0; j < 6; ++j) {
+		ksmodel_zoom_in(&histo, .6, 700);
+		ksmodel_zoom_in(&histo_col, .6, 700);
+		ksmodel_shift_forward(&histo, 300);
+		ksmodel_shift_forward(&histo_col, 300);
+
+		BOOST_CHECK_EQUAL(histo.tot_count, histo_col.tot_count);
+		for (i = 0; i < histo.n_bins + 2; ++i) {
+			BOOST_CHECK_EQUAL(histo.map[i], histo_col.map[i]);
+			BOOST_CHECK_EQUAL(histo.bin_count[i],
+					  histo_col.bin_count[i]);
+		}
+	}
+
+	ksmodel_clear(&histo);
+	ksmodel_clear(&histo_col);
+	kshark_entry_columns_free(&columns);
+	BOOST_CHECK(!columns.grid.rows);
+}
+
+#define N_BIN_ENTRIES	5000
+
+static void check_graph_bins(struct kshark_trace_histo *histo,
+			     struct kshark_entry_collection *col)
+{
+	std::vector<ksmodel_graph_bin> bins(histo->n_bins);
+	int bin, id, cpu, pid;
+	ssize_t index;
+	uint8_t mask;
+
+	for (id = 0; id < 4; ++id) {
+		ksmodel_fill_cpu_graph_bins(histo, 0, id, col, bins.data());
+		for (bin = 0; bin < histo->n_bins; ++bin) {
+			pid = ksmodel_get_pid_front(histo, bin, 0, id, true,
+						    col, nullptr);
+			BOOST_CHECK_EQUAL(bins[bin].id_front, pid);
+
+			pid = ksmodel_get_pid_back(histo, bin, 0, id, true,
+						   col, nullptr);
+			if (pid != ksmodel_get_pid_back(histo, bin, 0, id,
+							false, col, nullptr))
+				pid = KS_FILTERED_BIN;
+
+			BOOST_CHECK_EQUAL(bins[bin].id_back, pid);
+		}
+
+		ksmodel_fill_task_graph_bins(histo, 0, id, col, bins.data());
+		for (bin = 0; bin < histo->n_bins; ++bin) {
+			cpu = ksmodel_get_cpu_front(histo, bin, 0, id, false,
+						    col, &index);
+			BOOST_CHECK_EQUAL(bins[bin].id_front, cpu);
+			if (cpu < 0)
+				continue;
+
+			BOOST_CHECK_EQUAL(bins[bin].pid_front,
+					  ksmodel_get_pid_front(histo, bin, 0,
+								cpu, false,
+								col, nullptr));
+
+			mask = histo->data[index]->visible;
+			if (!(mask & KS_EVENT_VIEW_FILTER_MASK) &&
+			    ksmodel_task_visible_event_exist(histo, bin, 0, id,
+							     col, &index))
+				mask = histo->data[index]->visible;
+
+			BOOST_CHECK_EQUAL(bins[bin].vis_mask, mask);
+
+			cpu = ksmodel_get_cpu_back(histo, bin, 0, id, false,
+						   col, nullptr);
+			BOOST_CHECK_EQUAL(bins[bin].id_back, cpu);
+			BOOST_CHECK_EQUAL(bins[bin].pid_back,
+					  ksmodel_get_pid_back(histo, bin, 0,
+							       cpu, false,
+							       col, nullptr));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(graph_bins)
+{
+	std::vector<kshark_entry> entries(N_BIN_ENTRIES);
+	std::vector<kshark_entry *> rows(N_BIN_ENTRIES);
+	struct kshark_entry_collection *col = nullptr;
+	kshark_context *kshark_ctx(nullptr);
+	struct kshark_trace_histo histo;
+	int i, cpu = 2;
+
+	BOOST_REQUIRE(kshark_instance(&kshark_ctx));
+	for (i = 0; i < N_BIN_ENTRIES; ++i) {
+		entries[i].ts = 100 * i;
+		/* CPU 2 is used only in every other block of entries. */
+		entries[i].cpu = ((i / 500) % 2) ? (i * 7) % 4 : i % 2;
+		entries[i].pid = (i / 3) % 5;
+		entries[i].visible = (i % 11 < 3) ? 0 : 0xFF;
+		if (i % 13 == 0)
+			entries[i].visible &= ~KS_EVENT_VIEW_FILTER_MASK;
+
+		rows[i] = &entries[i];
+	}
+
+	ksmodel_init(&histo);
+	ksmodel_set_bining(&histo, 300, 10000, 100 * N_BIN_ENTRIES - 10000);
+	ksmodel_fill(&histo, rows.data(), N_BIN_ENTRIES);
+	check_graph_bins(&histo, nullptr);
+
+	kshark_add_collection_to_list(kshark_ctx, &col, rows.data(),
+				      N_BIN_ENTRIES, kshark_match_cpu, 0,
+				      &cpu, 1, 25);
+	BOOST_REQUIRE(col);
+	check_graph_bins(&histo, col);
+
+	kshark_free_collection_list(col);
+	ksmodel_clear(&histo);
+	kshark_free(kshark_ctx);
+}
+// END of change
+
+//NOTE: Changed here. (GRAPH TABLE) (2026-10-17)
+BOOST_AUTO_TEST_CASE(graph_table)
+{
+	std::vector<kshark_entry> entries(N_BIN_ENTRIES);
+	std::vector<kshark_entry *> rows(N_BIN_ENTRIES);
+	struct kshark_entry_collection *col = nullptr;
+	std::vector<ksmodel_graph_desc> graphs;
+	std::vector<ksmodel_graph_bin> table, bins;
+	kshark_context *kshark_ctx(nullptr);
+	struct kshark_trace_histo histo;
+	int i, id, pid = 4;
+	size_t g, bin;
+
+	BOOST_REQUIRE(kshark_instance(&kshark_ctx));
+	for (i = 0; i < N_BIN_ENTRIES; ++i) {
+		entries[i].ts = 100 * i;
+		entries[i].stream_id = i % 3 ? 0 : 1;
+		entries[i].cpu = (i * 7) % 4;
+		/* Task 4 runs only in every other block of entries. */
+		entries[i].pid = ((i / 500) % 2) ? (i / 3) % 5 : (i / 3) % 4;
+		entries[i].visible = (i % 11 < 3) ? 0 : 0xFF;
+		rows[i] = &entries[i];
+	}
+
+	kshark_add_collection_to_list(kshark_ctx, &col, rows.data(),
+				      N_BIN_ENTRIES, kshark_match_pid, 0,
+				      &pid, 1, 25);
+	BOOST_REQUIRE(col);
+
+	/* Graphs of all CPUs, a repeated CPU and all tasks. */
+	for (id = 0; id < 5; ++id)
+		graphs.push_back({id, false, nullptr});
+
+	graphs.push_back({2, false, nullptr});
+	for (id = 0; id < 5; ++id)
+		graphs.push_back({id, true, (id == pid) ? col : nullptr});
+
+	ksmodel_init(&histo);
+	ksmodel_set_bining(&histo, 300, 10000, 100 * N_BIN_ENTRIES - 10000);
+	ksmodel_fill(&histo, rows.data(), N_BIN_ENTRIES);
+
+	table.resize(graphs.size() * histo.n_bins);
+	bins.resize(histo.n_bins);
+	BOOST_REQUIRE(ksmodel_fill_graph_table(&histo, 0, graphs.data(),
+					       graphs.size(), table.data()));
+
+	for (g = 0; g < graphs.size(); ++g) {
+		if (graphs[g].task)
+			ksmodel_fill_task_graph_bins(&histo, 0, graphs[g].id,
+						     graphs[g].col,
+						     bins.data());
+		else
+			ksmodel_fill_cpu_graph_bins(&histo, 0, graphs[g].id,
+						    graphs[g].col,
+						    bins.data());
+
+		for (bin = 0; bin < bins.size(); ++bin) {
+			const ksmodel_graph_bin &b = table[g * histo.n_bins + bin];
+
+			BOOST_CHECK_EQUAL(b.id_front, bins[bin].id_front);
+			BOOST_CHECK_EQUAL(b.id_back, bins[bin].id_back);
+			BOOST_CHECK_EQUAL(b.pid_front, bins[bin].pid_front);
+			BOOST_CHECK_EQUAL(b.pid_back, bins[bin].pid_back);
+			BOOST_CHECK_EQUAL(b.vis_mask, bins[bin].vis_mask);
+		}
+	}
+
+	kshark_free_collection_list(col);
+	ksmodel_clear(&histo);
+	kshark_free(kshark_ctx);
+}
+// END of change
+
+//NOTE: Changed here. (RECORD CACHE) (2026-10-17)
+#define N_CACHE_RECORDS	4
+
+static tep_record *add_cached_record(kshark_record_cache *cache,
+				     uint64_t offset, int *data)
+{
+	tep_record rec = {};
+
+	rec.offset = offset;
+	rec.data = data;
+	rec.size = sizeof(*data);
+
+	return kshark_record_cache_add(cache, &rec);
+}
+
+BOOST_AUTO_TEST_CASE(record_cache)
+{
+	kshark_record_cache *cache = kshark_record_cache_alloc(N_CACHE_RECORDS);
+	kshark_tep_record_cache_stats stats;
+	int data[2 * N_CACHE_RECORDS];
+	tep_record *held, *rec;
+	int i;
+
+	BOOST_REQUIRE(cache);
+	BOOST_CHECK(!kshark_record_cache_get(cache, 8));
+
+	for (i = 0; i < 2 * N_CACHE_RECORDS; ++i)
+		data[i] = i;
+
+	/* The cache keeps copies of the records. */
+	for (i = 0; i < N_CACHE_RECORDS; ++i) {
+		rec = add_cached_record(cache, 8 * (i + 1), &data[i]);
+		BOOST_REQUIRE(rec);
+		BOOST_CHECK(rec->data != &data[i]);
+		kshark_record_cache_put(cache, rec);
+	}
+
+	/* A hit makes the record the most recently used one. */
+	held = kshark_record_cache_get(cache, 8);
+	BOOST_REQUIRE(held);
+	BOOST_CHECK_EQUAL(held->offset, 8);
+	BOOST_CHECK_EQUAL(*(int *) held->data, 0);
+
+	/* Adding a record to a full cache evicts the least recently used. */
+	rec = add_cached_record(cache, 8 * (N_CACHE_RECORDS + 1),
+				&data[N_CACHE_RECORDS]);
+	kshark_record_cache_put(cache, rec);
+	BOOST_CHECK(!kshark_record_cache_get(cache, 16));
+
+	/*
+	 * Evict the held record too. It stays valid until released and gets
+	 * freed then.
+	 */
+	for (i = N_CACHE_RECORDS + 1; i < 2 * N_CACHE_RECORDS; ++i) {
+		rec = add_cached_record(cache, 8 * (i + 1), &data[i]);
+		kshark_record_cache_put(cache, rec);
+	}
+
+	BOOST_CHECK(!kshark_record_cache_get(cache, 8));
+	BOOST_CHECK_EQUAL(held->offset, 8);
+	BOOST_CHECK_EQUAL(*(int *) held->data, 0);
+	kshark_record_cache_put(cache, held);
+
+	/* Adding a cached record again returns the cached copy. */
+	held = kshark_record_cache_get(cache, 8 * 2 * N_CACHE_RECORDS);
+	rec = add_cached_record(cache, 8 * 2 * N_CACHE_RECORDS, &data[0]);
+	BOOST_REQUIRE(held);
+	BOOST_CHECK(rec == held);
+	BOOST_CHECK_EQUAL(*(int *) rec->data, 2 * N_CACHE_RECORDS - 1);
+	kshark_record_cache_put(cache, rec);
+	kshark_record_cache_put(cache, held);
+
+	kshark_record_cache_get_stats(cache, &stats);
+	BOOST_CHECK_EQUAL(stats.n_hits, 2);
+	BOOST_CHECK_EQUAL(stats.n_misses, 3);
+	BOOST_CHECK_EQUAL(stats.n_records, N_CACHE_RECORDS);
+
+	kshark_record_cache_free(cache);
+}
+// END of change
+
+//NOTE: Changed here. (ENTRY CACHE) (2026-10-17)
+/** The values of an entry, with "next" given as a row index. */
+struct cached_entry_values {
+	int64_t	ts;
+	int64_t	offset;
+	ssize_t	next;
+	int32_t	pid;
+	int16_t	event_id;
+	int16_t	cpu;
+	uint8_t	visible;
+};
+
+static ssize_t load_cached_entry_values(const std::string &file,
+					std::vector<cached_entry_values> &values)
+{
+	std::unordered_map<const kshark_entry *, ssize_t> row_of;
+	kshark_context *kshark_ctx(nullptr);
+	kshark_data_stream *stream;
+	kshark_entry **rows;
+	ssize_t n_rows, i;
+	int sd;
+
+	BOOST_REQUIRE(kshark_instance(&kshark_ctx));
+	sd = kshark_open(kshark_ctx, file.c_str());
+	BOOST_REQUIRE(sd >= 0);
+
+	/* Couplebreak wakeup entries stay in the list of the waker CPU. */
+	stream = kshark_get_data_stream(kshark_ctx, sd);
+	stream->couplebreak_on = true;
+	BOOST_REQUIRE_EQUAL(kshark_set_entry_cache(kshark_ctx, sd, true), 0);
+
+	n_rows = kshark_load_entries(kshark_ctx, sd, &rows);
+	BOOST_REQUIRE(n_rows > 0);
+
+	for (i = 0; i < n_rows; ++i)
+		row_of[rows[i]] = i;
+
+	values.resize(n_rows);
+	for (i = 0; i < n_rows; ++i) {
+		values[i].ts = rows[i]->ts;
+		values[i].offset = is_couplebreak_event(rows[i]->event_id) ?
+				   row_of[couplebreak_get_origin(rows[i])] :
+				   rows[i]->offset;
+		values[i].next = rows[i]->next ? row_of[rows[i]->next] : -1;
+		values[i].pid = rows[i]->pid;
+		values[i].event_id = rows[i]->event_id;
+		values[i].cpu = rows[i]->cpu;
+		values[i].visible = rows[i]->visible;
+	}
+
+	kshark_free_entries(kshark_ctx, rows, n_rows);
+	kshark_close(kshark_ctx, sd);
+	kshark_free(kshark_ctx);
+
+	return n_rows;
+}
+
+BOOST_AUTO_TEST_CASE(entry_cache)
+{
+	std::vector<cached_entry_values> fresh, cached;
+	std::string file(KS_TEST_DIR);
+	std::string cache_file;
+	size_t i;
+
+	file += "/trace_test1.dat";
+	cache_file = file + KS_ENTRY_CACHE_SUFFIX;
+	unlink(cache_file.c_str());
+
+	/* Decode the records and save the entries into the cache file. */
+	load_cached_entry_values(file, fresh);
+	BOOST_REQUIRE_EQUAL(access(cache_file.c_str(), R_OK), 0);
+
+	/* Restore the entries from the cache file. */
+	load_cached_entry_values(file, cached);
+	BOOST_REQUIRE_EQUAL(cached.size(), fresh.size());
+
+	for (i = 0; i < fresh.size(); ++i) {
+		BOOST_CHECK_EQUAL(cached[i].ts, fresh[i].ts);
+		BOOST_CHECK_EQUAL(cached[i].offset, fresh[i].offset);
+		BOOST_CHECK_EQUAL(cached[i].next, fresh[i].next);
+		BOOST_CHECK_EQUAL(cached[i].pid, fresh[i].pid);
+		BOOST_CHECK_EQUAL(cached[i].event_id, fresh[i].event_id);
+		BOOST_CHECK_EQUAL(cached[i].cpu, fresh[i].cpu);
+		BOOST_CHECK_EQUAL(cached[i].visible, fresh[i].visible);
+	}
+
+	unlink(cache_file.c_str());
+}
+// END of change
+
 struct test_context {
 	int a;
 	char b;
@@ -128,6 +128,13 @@ void NapConfigWindow::update_cfg() {
     cfg._use_task_coloring = _task_col_btn.isChecked();
 #endif
 
+#ifndef _UNMODIFIED_KSHARK // Render cache
+    // The graph only redraws cached shapes, have them made again
+    if (NapConfig::main_w_ptr != nullptr) {
+        NapConfig::main_w_ptr->graphPtr()->glPtr()->invalidateRender();
+    }
+#endif
+
     // Display a successful change dialog
     // We'll see if unique ptr is of any use here
     auto succ_dialog = new QMessageBox{QMessageBox::Information,
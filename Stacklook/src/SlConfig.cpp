@@ -314,6 +314,13 @@ void SlConfigWindow::update_cfg() {
         }
     }
 
+#ifndef _UNMODIFIED_KSHARK // Render cache
+    // The graph only redraws cached shapes, have them made again
+    if (SlConfig::main_w_ptr != nullptr) {
+        SlConfig::main_w_ptr->graphPtr()->glPtr()->invalidateRender();
+    }
+#endif
+
     // Display a dialog based on the success of the update process
     const char* change_status = events_meta_change ?
         "Configuration change success" :